@@ -10836,13 +10836,17 @@ namespace crow
 
                 if (!res.completed_)
                 {
+                    // Async handlers may call res.end() from another thread;
+                    // the write has to happen on this connection's io thread
                     res.complete_request_handler_ = [self] {
-                        self->complete_request();
+                        asio::dispatch(self->adaptor_.get_io_context(), [self] {
+                            self->complete_request();
+                        });
                     };
                     need_to_call_after_handlers_ = true;
+                    // No header writes after handle(): an async handler may
+                    // already be completing res on another thread
                     handler_->handle(req_, res, routing_handle_result_);
-                    if (add_keep_alive_)
-                        res.set_header("connection", "Keep-Alive");
                 }
                 else
                 {
@@ -12240,7 +12244,8 @@ namespace crow // NOTE: Already documented in "crow/app.h"
             /// Also destroys the object if the Close flag is set.
             void do_write()
             {
-                if (write_buffers_.empty()) return;
+                // A write is still in flight - its completion handler picks up write_buffers_
+                if (!sending_buffers_.empty() || write_buffers_.empty()) return;
 
                 sending_buffers_.swap(write_buffers_);
                 std::vector<asio::const_buffer> buffers;
@@ -0,0 +1,109 @@
+#ifndef COORDINATE_PREFILTER_HPP
+#define COORDINATE_PREFILTER_HPP
+
+#include "CustomVector.hpp"
+#include "CustomPriorityQueue.hpp"
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// ==================== COORDINATE PREFILTER BASICS ====================
+// Har donor ke liye graph distance (Dijkstra) mehenga hai. Lekin seedhi
+// (x,y) doori muft hai, aur scale * seedhi doori <= road doori
+// (CustomGraph::lowerBoundScale). To:
+//
+// 1. Candidates ke x aur y alag arrays mein (columnar) - Struct of arrays
+// 2. Ek loop mein sab ki lower bound - AVX2 ho to 4 doubles per instruction,
+//    warna simple loop (compiler khud vectorize kar sakta hai)
+// 3. Chhoti bound wala pehle - Graph distance sirf tab tak poocho jab tak
+//    agle candidate ki bound current best se chhoti hai. Uske baad sab
+//    pakka bure hain - Unki graph query kabhi nahi chalti
+//
+// Usage: add() sab candidates, computeBounds(), phir next() loop mein
+// ======================================================================
+
+class CoordinatePrefilter {
+private:
+    typedef std::pair<double, size_t> Entry; // (lower bound, candidate index)
+
+    struct SmallestBoundFirst {
+        bool operator()(const Entry& a, const Entry& b) const {
+            return a.first < b.first;
+        }
+    };
+
+    CustomVector<double> xs;       // Columnar - Sab x ek saath
+    CustomVector<double> ys;
+    CustomVector<double> bounds;   // computeBounds ke baad
+    CustomPriorityQueue<Entry, SmallestBoundFirst> order;
+
+    // KERNEL: bounds[i] = scale * sqrt((x-qx)^2 + (y-qy)^2)
+    static void boundsKernel(const double* x, const double* y, double* out, size_t n,
+                             double qx, double qy, double scale) {
+        size_t i = 0;
+#if defined(__AVX2__)
+        const __m256d vqx = _mm256_set1_pd(qx);
+        const __m256d vqy = _mm256_set1_pd(qy);
+        const __m256d vscale = _mm256_set1_pd(scale);
+        for (; i + 4 <= n; i += 4) {
+            __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), vqx);
+            __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), vqy);
+            __m256d sq = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+            _mm256_storeu_pd(out + i, _mm256_mul_pd(vscale, _mm256_sqrt_pd(sq)));
+        }
+#endif
+        for (; i < n; ++i) {
+            double dx = x[i] - qx;
+            double dy = y[i] - qy;
+            out[i] = scale * std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+public:
+    // Candidate add karo - Index = add ka order (0, 1, 2...)
+    void add(int x, int y) {
+        xs.push_back(x);
+        ys.push_back(y);
+    }
+
+    size_t size() const {
+        return xs.getSize();
+    }
+
+    // Query point (hospital) se sab candidates ki lower bound, phir
+    // chhoti bound pehle wali order - Heap lazy hai, sirf jitne next()
+    // hote hain utne pop (prune hone wale kabhi sort nahi hote)
+    void computeBounds(int qx, int qy, double scale) {
+        bounds.clear();
+        order.clear();
+        size_t n = xs.getSize();
+        for (size_t i = 0; i < n; ++i) bounds.push_back(0);
+        if (n == 0) return;
+        boundsKernel(xs.begin(), ys.begin(), bounds.begin(), n, qx, qy, scale);
+        for (size_t i = 0; i < n; ++i) order.push(Entry(bounds[i], i));
+    }
+
+    // Agla candidate (sabse chhoti bound) - False agar agle ki bound bhi
+    // >= cutoff (ya khatam). Cutoff = ab tak ki best asal doori
+    bool next(double cutoff, size_t& index) {
+        if (order.empty() || order.top().first >= cutoff) return false;
+        index = order.top().second;
+        order.pop();
+        return true;
+    }
+
+    // Kitne candidates abhi tak nahi dekhe (prune hue agar loop ruk gaya)
+    size_t remaining() const {
+        return order.size();
+    }
+
+    double boundOf(size_t index) const {
+        return bounds[index];
+    }
+};
+
+#endif // COORDINATE_PREFILTER_HPP
@@ -7,6 +7,9 @@
 #include <string>
 #include <limits>           //or infinity values in shortest path algorithm
 #include <utility>          //for pair data structure in priority queue//
+#include <atomic>           //graph epoch counter (cache invalidation)
+#include <cmath>            //sqrt for coordinate lower bounds
+#include <mutex>            //lower-bound scale cache
 
 // ==================== GRAPH BASICS ====================
 // Graph jaise map hota hai - Cities aur roads
@@ -36,11 +39,17 @@ private:
     // Weighted edge - Distance ya cost assign karte hain
     struct Edge {           //nested structs
         int to;           // Target node ka index
-        double weight;    // Distance/cost - "5 km door hai" type
+        unsigned short profile; // Travel-time profile id (0 = flat) - padding mein fit, size same
+        // Distance/cost - "5 km door hai" type. Atomic: road update chalti
+        // searches ke saath likhta hai (lock-free readers) - Relaxed kaafi
+        // hai, har reader ko ya purana ya naya poora weight milta hai
+        std::atomic<double> weight;
         Edge* next;       // Next edge (adjacency list)
         
         // Constructor
-        Edge(int t, double w) : to(t), weight(w), next(nullptr) {}
+        Edge(int t, double w) : to(t), profile(0), weight(w), next(nullptr) {}
+        
+        double cost() const { return weight.load(std::memory_order_relaxed); }
     };
     
     // NODE STRUCTURE: Ek location/center ko represent karte hain
@@ -61,16 +70,234 @@ private:
     
     CustomVector<Node*> nodes;                      // Sab nodes ka vector
     CustomHashMap<std::string, int> nodeIndex;     // "H1" -> index lookup
+    // TRAVEL-TIME PROFILES: Din bhar ki speed (minutes per km) - Shared pool
+    // Edge sirf 2-byte id rakhti hai, profile khud ek hi dafa store hota hai
+    // (rush-hour arterial, residential, etc.) - Bade graph par bhi memory kam
+    CustomVector<CustomVector<std::pair<int, double>>> profiles; // (minuteOfDay, minutesPerKm)
+    
+    // GRAPH EPOCH: Har structural change (addNode/addEdge) par badhta hai
+    // Cached distances apna epoch rakhte hain - Mismatch = stale
+    std::atomic<unsigned long> epoch{0};
+    
+    // LOWER-BOUND SCALE: min(edge weight / straight-line length) - Epoch ke
+    // saath cache, road badle to dobara nikalta hai
+    mutable std::mutex scaleLock;
+    mutable unsigned long scaleEpoch = static_cast<unsigned long>(-1);
+    mutable double scale = 0.0;
+    
+    // HEAP ENTRY: (distance, node_index) - Priority queue mein yehi jata hai
+    typedef std::pair<double, int> HeapEntry;
+    
+    // MIN-HEAP COMPARATOR: Sabse chhota distance pehle
+    // CustomPriorityQueue mein comp(a, b) == true ka matlab "a pehle nikle"
+    // (std::less = min-heap), is liye yahan less than
+    struct MinDistCompare {
+        bool operator()(const HeapEntry& a, const HeapEntry& b) const {
+            return a.first < b.first;
+        }
+    };
     
 public:
+    // SEARCH WORKSPACE: Dijkstra ke arrays (dist, parent, settled, heap)
+    // har query par dobara allocate nahi karte - Ek baar bana kar reuse.
+    // Generation stamp se reset O(1) hai: jis node ka stamp purana hai
+    // wo is search mein "untouched" hai, uska dist infinity samjho.
+    struct SearchWorkspace {
+        CustomVector<double> dist;       // Start se distance
+        CustomVector<int> parent;        // Path reconstruction
+        CustomVector<bool> settled;      // Final distance mil chuka
+        CustomVector<unsigned> stamp;    // Kis generation mein touch hua
+        CustomPriorityQueue<HeapEntry, MinDistCompare> heap;
+        unsigned generation;
+        size_t settledCount;             // Is search mein kitne nodes settle hue
+        
+        SearchWorkspace() : generation(0), settledCount(0) {}
+        
+        // PREPARE: Naye search ke liye ready - Sirf generation badhao
+        void prepare(size_t n) {
+            while (stamp.getSize() < n) {
+                dist.push_back(std::numeric_limits<double>::infinity());
+                parent.push_back(-1);
+                settled.push_back(false);
+                stamp.push_back(0);
+            }
+            ++generation;
+            if (generation == 0) {
+                // Counter wrap ho gaya - Ek dafa sab stamps saaf
+                for (size_t i = 0; i < stamp.getSize(); ++i) stamp[i] = 0;
+                generation = 1;
+            }
+            heap.clear();
+            settledCount = 0;
+        }
+        
+        // TOUCH: Pehli dafa node dekha to uski values reset karo
+        void touch(int u) {
+            if (stamp[u] != generation) {
+                stamp[u] = generation;
+                dist[u] = std::numeric_limits<double>::infinity();
+                parent[u] = -1;
+                settled[u] = false;
+            }
+        }
+        
+        double distanceOf(int u) const {
+            return stamp[u] == generation ? dist[u] : std::numeric_limits<double>::infinity();
+        }
+    };
+    
+    // Profile na ho to flat speed - Purana "3 min per km" estimate
+    static constexpr double DEFAULT_MINUTES_PER_KM = 3.0;
+    static constexpr double MINUTES_PER_DAY = 1440.0;
+    
+    // TIME-DEPENDENT RESULT: Kab nikle, kab pahunche, kaunsa raasta
+    struct TimedRouteResult {
+        double departureMinute;         // Nikalne ka waqt (minute of day)
+        double arrivalMinute;           // Pahunchne ka waqt (din cross kar sakta hai)
+        CustomVector<std::string> path;
+        
+        TimedRouteResult() : departureMinute(0), arrivalMinute(std::numeric_limits<double>::infinity()) {}
+        double travelMinutes() const { return arrivalMinute - departureMinute; }
+    };
+    
     // SHORTEST PATH RESULT STRUCTURE
     struct ShortestPathResult {
         double distance;                // Total distance ya cost
         CustomVector<std::string> path; // Path jo follow karna hai
+        size_t settledNodes;            // Search ne kitne nodes settle kiye
         
-        ShortestPathResult() : distance(std::numeric_limits<double>::infinity()) {}
+        ShortestPathResult() : distance(std::numeric_limits<double>::infinity()), settledNodes(0) {}
     };
     
+private:
+    // THREAD-LOCAL WORKSPACE: Crow multithreaded hai, har thread ka apna
+    // workspace - Koi lock nahi chahiye. Visitor ke andar dobara search
+    // mat chalana, warna same workspace overwrite ho jayega.
+    // Slot 0 = forward search, Slot 1 = backward search (bidirectional)
+    static SearchWorkspace& localWorkspace(int slot = 0) {
+        thread_local SearchWorkspace ws[2];
+        return ws[slot];
+    }
+    
+    // SCAN ONE STEP: Ek side ka agla node settle karo aur relax karo
+    // Jo node dono sides ne dekh liya us par meeting candidate check -
+    // mu = ab tak ka best (dist_forward + dist_backward)
+    void scanBidirectionalStep(SearchWorkspace& self, const SearchWorkspace& other,
+                               double& mu, int& meet) const {
+        HeapEntry top = self.heap.top();
+        self.heap.pop();
+        int u = top.second;
+        if (self.settled[u]) return;
+        self.settled[u] = true;
+        ++self.settledCount;
+        
+        Edge* edge = nodes[u]->edges;
+        while (edge != nullptr) {
+            int v = edge->to;
+            self.touch(v);
+            if (!self.settled[v] && self.dist[u] + edge->cost() < self.dist[v]) {
+                self.dist[v] = self.dist[u] + edge->cost();
+                self.parent[v] = u;
+                self.heap.push({self.dist[v], v});
+                
+                // Doosri side pehle yahan pahunch chuki hai? - Meeting point
+                double through = self.dist[v] + other.distanceOf(v);
+                if (through < mu) {
+                    mu = through;
+                    meet = v;
+                }
+            }
+            edge = edge->next;
+        }
+    }
+    
+    // SET WEIGHT: u -> v ki sab (parallel) edges ka weight set karo
+    bool setWeight(int u, int v, double weight) {
+        bool found = false;
+        Edge* edge = nodes[u]->edges;
+        while (edge != nullptr) {
+            if (edge->to == v) {
+                edge->weight.store(weight, std::memory_order_relaxed);
+                found = true;
+            }
+            edge = edge->next;
+        }
+        return found;
+    }
+    
+    // PROFILE FACTOR: Profile ka minutes-per-km kisi waqt par
+    // Breakpoints ke beech linear interpolation, din ke end par wrap
+    double minutesPerKm(unsigned short profileId, double minuteOfDay) const {
+        if (profileId == 0 || profileId > profiles.getSize()) {
+            return DEFAULT_MINUTES_PER_KM;
+        }
+        const CustomVector<std::pair<int, double>>& points = profiles[profileId - 1];
+        size_t count = points.getSize();
+        double t = minuteOfDay - MINUTES_PER_DAY * static_cast<long>(minuteOfDay / MINUTES_PER_DAY);
+        if (count == 1) return points[0].second;
+        
+        // Binary search - Aakhri breakpoint jo t se pehle ya barabar ho
+        size_t lo = 0, hi = count;
+        while (hi - lo > 1) {
+            size_t mid = (lo + hi) / 2;
+            if (points[mid].first <= t) lo = mid; else hi = mid;
+        }
+        double t0 = points[lo].first, f0 = points[lo].second;
+        double t1, f1;
+        if (t < t0) {
+            // t pehle breakpoint se pehle - Pichle din ke aakhri point se
+            t0 = points[count - 1].first - MINUTES_PER_DAY;
+            f0 = points[count - 1].second;
+            t1 = points[0].first;
+            f1 = points[0].second;
+        } else if (lo + 1 < count) {
+            t1 = points[lo + 1].first;
+            f1 = points[lo + 1].second;
+        } else {
+            t1 = points[0].first + MINUTES_PER_DAY; // Agle din ka pehla point
+            f1 = points[0].second;
+        }
+        return f0 + (f1 - f0) * (t - t0) / (t1 - t0);
+    }
+    
+    // EDGE TRAVEL TIME: Is waqt nikle to edge par kitne minute lagenge
+    double travelMinutes(const Edge* edge, double departMinute) const {
+        return edge->cost() * minutesPerKm(edge->profile, departMinute);
+    }
+    
+    // RELAX NEIGHBORS (TIME): dist = arrival minute, cost waqt par depend karta hai
+    void relaxNeighborsTimed(SearchWorkspace& ws, int u) const {
+        Edge* edge = nodes[u]->edges;
+        while (edge != nullptr) {
+            int v = edge->to;
+            ws.touch(v);
+            double arrival = ws.dist[u] + travelMinutes(edge, ws.dist[u]);
+            if (!ws.settled[v] && arrival < ws.dist[v]) {
+                ws.dist[v] = arrival;
+                ws.parent[v] = u;
+                ws.heap.push({arrival, v});
+            }
+            edge = edge->next;
+        }
+    }
+    
+    // RELAX NEIGHBORS: u settle ho gaya, ab uske neighbors update karo
+    void relaxNeighbors(SearchWorkspace& ws, int u) const {
+        Edge* edge = nodes[u]->edges;
+        while (edge != nullptr) {
+            int v = edge->to;
+            ws.touch(v);
+            // Relaxation: Shorter path mil gya to update
+            if (!ws.settled[v] && ws.dist[u] + edge->cost() < ws.dist[v]) {
+                ws.dist[v] = ws.dist[u] + edge->cost(); // Distance update
+                ws.parent[v] = u;                        // Parent track karo
+                ws.heap.push({ws.dist[v], v});           // Priority queue mein add
+            }
+            edge = edge->next;
+        }
+    }
+    
+public:
     // CONSTRUCTOR
     CustomGraph() {}
     
@@ -100,6 +327,7 @@ public:
         Node* new_node = new Node(id, name, type, x, y);
         nodeIndex.insert(id, nodes.getSize()); // HashMap mein index store
         nodes.push_back(new_node);
+        ++epoch; // Graph badal gaya - Cached distances purane
     }
     
     // ADD EDGE: Dono locations ke beech connection banate hain
@@ -121,6 +349,194 @@ public:
         Edge* reverse_edge = new Edge(from_idx, weight);
         reverse_edge->next = nodes[to_idx]->edges;
         nodes[to_idx]->edges = reverse_edge;
+        
+        ++epoch; // Naya road - Shortest paths badal sakte hain
+    }
+    
+    // UPDATE EDGE WEIGHT: Road ka distance/cost badlo (congestion, detour)
+    // Dono directions update hoti hain. Band road (removeEdge) ko naya
+    // weight do to wo phir khul jata hai.
+    // oldWeight mein purana weight milta hai - Cache repair ke liye
+    // Return false agar ye road exist nahi karti
+    // Epoch weight likhne ke BAAD badhta hai - Jo search beech mein chali
+    // (mila jula purana/naya weight) uska result purane epoch par cache
+    // hota hai, jo ab stale hai
+    // Writers (update/remove) ek hi waqt mein ek - Caller serialize kare
+    bool updateEdgeWeight(const std::string& from, const std::string& to, double weight, double* oldWeight = nullptr) {
+        int from_idx, to_idx;
+        if (!nodeIndex.get(from, from_idx) || !nodeIndex.get(to, to_idx)) {
+            return false;
+        }
+        
+        double previous = edgeWeight(from_idx, to_idx);
+        bool found = setWeight(from_idx, to_idx, weight);
+        setWeight(to_idx, from_idx, weight); // Undirected - Wapsi wali edge bhi
+        if (!found) {
+            return false;
+        }
+        
+        if (oldWeight) *oldWeight = previous;
+        ++epoch;
+        return true;
+    }
+    
+    // REMOVE EDGE: Road band (closure) - Weight infinity kar dete hain
+    // Edge memory free nahi karte: doosre threads ki chalti searches isi
+    // linked list par ho sakti hain. Infinity weight wali edge kabhi relax
+    // nahi hoti, is liye search ke liye ye road exist hi nahi karti.
+    bool removeEdge(const std::string& from, const std::string& to, double* oldWeight = nullptr) {
+        return updateEdgeWeight(from, to, std::numeric_limits<double>::infinity(), oldWeight);
+    }
+    
+    // EDGE WEIGHT: u -> v ka sabse chhota weight (parallel roads ho sakti hain)
+    // Road nahi hai ya band hai to infinity
+    double edgeWeight(int u, int v) const {
+        double best = std::numeric_limits<double>::infinity();
+        Edge* edge = nodes[u]->edges;
+        while (edge != nullptr) {
+            if (edge->to == v && edge->cost() < best) {
+                best = edge->cost();
+            }
+            edge = edge->next;
+        }
+        return best;
+    }
+    
+    // SHORTEST PATH TREE: Start se full SSSP - dist aur parent dono
+    // Ye tree baad mein repairAfterEdgeChange se incrementally update hota hai
+    void shortestPathTree(const std::string& start, CustomVector<double>& dist, CustomVector<int>& parent) const {
+        dist = CustomVector<double>(nodes.getSize());
+        parent = CustomVector<int>(nodes.getSize());
+        bool reached = expandFrom(start, [](const std::string&, double) { return true; }) > 0;
+        const SearchWorkspace& ws = localWorkspace();
+        for (size_t i = 0; i < nodes.getSize(); ++i) {
+            int u = static_cast<int>(i);
+            dist.push_back(reached ? ws.distanceOf(u) : std::numeric_limits<double>::infinity());
+            parent.push_back(reached && ws.stamp[u] == ws.generation ? ws.parent[u] : -1);
+        }
+    }
+    
+    // REPAIR AFTER EDGE CHANGE: Ek edge (from, to) ka weight badal chuka hai
+    // (graph already updated). Purane shortest path tree (dist, parent) ko
+    // poora dobara compute karne ke bajaye sirf affected hissa theek karte hain.
+    //
+    // Weight kam hua (ya nayi road): Agar edge se kisi end ka distance
+    //   chhota hota hai to wahan se Dijkstra-style propagation - Sirf jin
+    //   nodes ka distance sach mein kam hota hai wahi touch hote hain.
+    // Weight badha (ya road band): Agar ye tree edge nahi thi to kuch nahi
+    //   badla. Tree edge thi to sirf child ka subtree affected hai:
+    //   subtree ke distances reset, bahar ke neighbors se seed, phir
+    //   subtree ke andar Dijkstra.
+    //
+    // Return: Kitne distance labels dobara likhe gaye (repair ka kaam)
+    size_t repairAfterEdgeChange(const std::string& from, const std::string& to,
+                                 double oldWeight, double newWeight,
+                                 CustomVector<double>& dist, CustomVector<int>& parent) const {
+        int u, v;
+        if (!nodeIndex.get(from, u) || !nodeIndex.get(to, v)) {
+            return 0;
+        }
+        if (static_cast<size_t>(u) >= dist.getSize() || static_cast<size_t>(v) >= dist.getSize()) {
+            return 0; // Tree is node se purana hai
+        }
+        
+        CustomPriorityQueue<HeapEntry, MinDistCompare> heap;
+        size_t touched = 0;
+        
+        if (newWeight < oldWeight) {
+            // DECREASE: Dono directions check (undirected)
+            double w = edgeWeight(u, v);
+            touched = 1;
+            if (dist[u] + w < dist[v]) {
+                dist[v] = dist[u] + w;
+                parent[v] = u;
+                heap.push({dist[v], v});
+            } else if (dist[v] + w < dist[u]) {
+                dist[u] = dist[v] + w;
+                parent[u] = v;
+                heap.push({dist[u], u});
+            } else {
+                return 0; // Chhota weight bhi kisi path ko behtar nahi karta
+            }
+        } else if (newWeight > oldWeight) {
+            // INCREASE: Tree edge thi? Child kaun hai?
+            int child = -1;
+            if (parent[v] == u) child = v;
+            else if (parent[u] == v) child = u;
+            if (child == -1) {
+                return 0; // Tree ka hissa nahi - Koi shortest path nahi badla
+            }
+            
+            // Subtree collect karo - Workspace ka settled flag = "subtree mein hai"
+            SearchWorkspace& ws = localWorkspace();
+            ws.prepare(nodes.getSize());
+            CustomVector<int> subtree;
+            subtree.push_back(child);
+            ws.touch(child);
+            ws.settled[child] = true;
+            for (size_t front = 0; front < subtree.getSize(); ++front) {
+                int x = subtree[front];
+                Edge* edge = nodes[x]->edges;
+                while (edge != nullptr) {
+                    int y = edge->to;
+                    if (parent[y] == x) {
+                        ws.touch(y);
+                        if (!ws.settled[y]) {
+                            ws.settled[y] = true;
+                            subtree.push_back(y);
+                        }
+                    }
+                    edge = edge->next;
+                }
+            }
+            
+            // Subtree reset, phir bahar wale neighbors se best seed
+            for (size_t i = 0; i < subtree.getSize(); ++i) {
+                dist[subtree[i]] = std::numeric_limits<double>::infinity();
+                parent[subtree[i]] = -1;
+            }
+            for (size_t i = 0; i < subtree.getSize(); ++i) {
+                int x = subtree[i];
+                Edge* edge = nodes[x]->edges;
+                while (edge != nullptr) {
+                    int y = edge->to;
+                    ws.touch(y);
+                    if (!ws.settled[y] && dist[y] + edge->cost() < dist[x]) {
+                        dist[x] = dist[y] + edge->cost();
+                        parent[x] = y;
+                    }
+                    edge = edge->next;
+                }
+                if (dist[x] != std::numeric_limits<double>::infinity()) {
+                    heap.push({dist[x], x});
+                }
+            }
+            touched = subtree.getSize();
+        } else {
+            return 0; // Weight same - Kuch nahi badla
+        }
+        
+        // PROPAGATION: Lazy-deletion Dijkstra sirf improve hone wale nodes par
+        while (!heap.empty()) {
+            HeapEntry top = heap.top();
+            heap.pop();
+            int x = top.second;
+            if (top.first > dist[x]) continue; // Purani entry
+            
+            Edge* edge = nodes[x]->edges;
+            while (edge != nullptr) {
+                int y = edge->to;
+                if (dist[x] + edge->cost() < dist[y]) {
+                    ++touched;
+                    dist[y] = dist[x] + edge->cost();
+                    parent[y] = x;
+                    heap.push({dist[y], y});
+                }
+                edge = edge->next;
+            }
+        }
+        
+        return touched;
     }
     
     // DIJKSTRA'S ALGORITHM: Sabse chotta path find karte hain
@@ -136,7 +552,7 @@ public:
     //
     // Time Complexity: O((V+E) log V)
     // V = vertices (hospitals), E = edges (roads)
-    ShortestPathResult dijkstra(const std::string& start, const std::string& end) {
+    ShortestPathResult dijkstra(const std::string& start, const std::string& end) const {
         ShortestPathResult result;
         
         int start_idx, end_idx;
@@ -144,64 +560,40 @@ public:
             return result; // Invalid nodes
         }
         
-        size_t n = nodes.getSize();
-        CustomVector<double> dist;           // Start se har node ka distance
-        CustomVector<int> parent;            // Path reconstruction - Parent track
-        CustomVector<bool> visited;          // Processed nodes - Processed kar chuke
-        
-        // Initialization
-        for (size_t i = 0; i < n; ++i) {
-            dist.push_back(std::numeric_limits<double>::infinity());
-            parent.push_back(-1);
-            visited.push_back(false);
-        }
-        
-        dist[start_idx] = 0; // Start point se apna distance 0
-        
-        // Min-heap: (distance, node_index) - Sabse chhota distance pehle
-        auto comp = [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
-            return a.first > b.first; // Min-heap ke liye greater than
-        };
-        CustomPriorityQueue<std::pair<double, int>, decltype(comp)> pq(comp);
-        pq.push({0, start_idx}); // Start mein start node add
+        // Initialization - Workspace reuse, O(1) reset
+        SearchWorkspace& ws = localWorkspace();
+        ws.prepare(nodes.getSize());
+        ws.touch(start_idx);
+        ws.dist[start_idx] = 0; // Start point se apna distance 0
+        ws.heap.push({0, start_idx}); // Start mein start node add
         
         // Main loop - Jab tak priority queue empty nahi
-        while (!pq.empty()) {
-            auto [d, u] = pq.top(); // Sabse chhote distance wala node nikalo
-            pq.pop();
+        while (!ws.heap.empty()) {
+            HeapEntry top = ws.heap.top(); // Sabse chhote distance wala node nikalo
+            ws.heap.pop();
+            int u = top.second;
             
-            if (visited[u]) continue; // Already processed - Skip
-            visited[u] = true;        // Mark as visited
+            if (ws.settled[u]) continue; // Already processed - Skip
+            ws.settled[u] = true;        // Mark as visited
+            ++ws.settledCount;
             
             if (u == end_idx) break;  // Destination mil gya - Stop
             
-            // Sab neighbors check karte hain
-            Edge* edge = nodes[u]->edges;
-            while (edge != nullptr) {
-                int v = edge->to;
-                double weight = edge->weight;
-                
-                // Relaxation: Shorter path mil gya to update
-                if (!visited[v] && dist[u] + weight < dist[v]) {
-                    dist[v] = dist[u] + weight; // Distance update
-                    parent[v] = u;              // Parent track karo
-                    pq.push({dist[v], v});     // Priority queue mein add
-                }
-                
-                edge = edge->next;
-            }
+            relaxNeighbors(ws, u); // Sab neighbors check karte hain
         }
         
+        result.settledNodes = ws.settledCount;
+        
         // PATH RECONSTRUCTION: Start se end tak path build karte hain
-        if (dist[end_idx] != std::numeric_limits<double>::infinity()) {
-            result.distance = dist[end_idx]; // Total distance
+        if (ws.distanceOf(end_idx) != std::numeric_limits<double>::infinity()) {
+            result.distance = ws.dist[end_idx]; // Total distance
             
             // Backward path - End se start tak parent follow
             CustomVector<int> path_indices;
             int current = end_idx;
             while (current != -1) {
                 path_indices.push_back(current);
-                current = parent[current];
+                current = ws.parent[current];
             }
             
             // Reverse - Start se end tak path order karte hain
@@ -213,6 +605,262 @@ public:
         return result;
     }
     
+    // BIDIRECTIONAL DIJKSTRA: Dono taraf se search - Start se aage aur
+    // End se peeche. Unidirectional search start ke gird poora disk settle
+    // karti hai; do chhote disk (radius aadha) us se kaafi kam nodes hain.
+    //
+    // Algorithm:
+    // 1. Forward workspace (slot 0) start se, backward (slot 1) end se
+    // 2. Har step mein jis side ka heap top chhota ho wo aage badhe
+    // 3. mu = sab meeting nodes par min(dist_f + dist_b)
+    // 4. Stop jab top_f + top_b >= mu - Is se chhota path ab mumkin nahi
+    // 5. Path = start -> meet (forward parents) + meet -> end (backward parents)
+    //
+    // Graph undirected hai, is liye backward search same edges use karti hai.
+    // Result dijkstra() jaisa hi hai (distance + path).
+    ShortestPathResult bidirectionalDijkstra(const std::string& start, const std::string& end) const {
+        ShortestPathResult result;
+        
+        int start_idx, end_idx;
+        if (!nodeIndex.get(start, start_idx) || !nodeIndex.get(end, end_idx)) {
+            return result; // Invalid nodes
+        }
+        
+        SearchWorkspace& fwd = localWorkspace(0);
+        SearchWorkspace& bwd = localWorkspace(1);
+        fwd.prepare(nodes.getSize());
+        bwd.prepare(nodes.getSize());
+        
+        fwd.touch(start_idx);
+        fwd.dist[start_idx] = 0;
+        fwd.heap.push({0, start_idx});
+        bwd.touch(end_idx);
+        bwd.dist[end_idx] = 0;
+        bwd.heap.push({0, end_idx});
+        
+        double mu = (start_idx == end_idx) ? 0 : std::numeric_limits<double>::infinity();
+        int meet = (start_idx == end_idx) ? start_idx : -1;
+        
+        while (!fwd.heap.empty() && !bwd.heap.empty()) {
+            // Stopping criterion - Dono frontiers ka sum mu se kam nahi
+            if (fwd.heap.top().first + bwd.heap.top().first >= mu) break;
+            
+            // Chhota frontier pehle - Dono disk barabar badhte hain
+            if (fwd.heap.top().first <= bwd.heap.top().first) {
+                scanBidirectionalStep(fwd, bwd, mu, meet);
+            } else {
+                scanBidirectionalStep(bwd, fwd, mu, meet);
+            }
+        }
+        
+        result.settledNodes = fwd.settledCount + bwd.settledCount;
+        if (meet == -1) {
+            return result; // Dono sides kabhi nahi mile - Path nahi hai
+        }
+        result.distance = mu;
+        
+        // Forward half: meet se start tak parents, phir reverse
+        CustomVector<int> path_indices;
+        int current = meet;
+        while (current != -1) {
+            path_indices.push_back(current);
+            current = fwd.parent[current];
+        }
+        for (int i = path_indices.getSize() - 1; i >= 0; --i) {
+            result.path.push_back(nodes[path_indices[i]]->id);
+        }
+        
+        // Backward half: meet ke baad end tak (backward parents end ki taraf jate hain)
+        current = bwd.parent[meet];
+        while (current != -1) {
+            result.path.push_back(nodes[current]->id);
+            current = bwd.parent[current];
+        }
+        
+        return result;
+    }
+    
+    // ADD TRAVEL PROFILE: Din bhar ka piecewise-linear minutes-per-km
+    // points = (minuteOfDay 0..1439, minutesPerKm), minute ke hisaab se sorted
+    // Return: profile id (edges ko setEdgeProfile se assign), 0 agar invalid
+    // Startup par hi profiles add karo - Searches ke saath concurrent nahi
+    // FIFO chahiye: weight * slope >= -1 (baad mein nikle to pehle na pahunche)
+    unsigned short addTravelProfile(const CustomVector<std::pair<int, double>>& points) {
+        if (points.empty() || profiles.getSize() >= 65535) {
+            return 0;
+        }
+        for (size_t i = 0; i < points.getSize(); ++i) {
+            if (points[i].first < 0 || points[i].first >= MINUTES_PER_DAY || points[i].second <= 0) return 0;
+            if (i > 0 && points[i].first <= points[i - 1].first) return 0; // Sorted, unique
+        }
+        profiles.push_back(points);
+        return static_cast<unsigned short>(profiles.getSize());
+    }
+    
+    // SET EDGE PROFILE: Road ko traffic profile do (dono directions)
+    bool setEdgeProfile(const std::string& from, const std::string& to, unsigned short profileId) {
+        int from_idx, to_idx;
+        if (!nodeIndex.get(from, from_idx) || !nodeIndex.get(to, to_idx) || profileId > profiles.getSize()) {
+            return false;
+        }
+        bool found = false;
+        for (int side = 0; side < 2; ++side) {
+            int a = side == 0 ? from_idx : to_idx;
+            int b = side == 0 ? to_idx : from_idx;
+            Edge* edge = nodes[a]->edges;
+            while (edge != nullptr) {
+                if (edge->to == b) {
+                    edge->profile = profileId;
+                    found = true;
+                }
+                edge = edge->next;
+            }
+        }
+        return found;
+    }
+    
+    // TIME-DEPENDENT DIJKSTRA: departureMinute par start se nikle to end par
+    // sabse jaldi kab pahunchenge. Label = arrival time, edge cost us waqt
+    // ke traffic profile se. FIFO profiles par ye exact hai (normal Dijkstra
+    // jaisa hi greedy argument). Same thread-local workspace reuse hota hai.
+    TimedRouteResult timeDependentRoute(const std::string& start, const std::string& end, double departureMinute) const {
+        TimedRouteResult result;
+        result.departureMinute = departureMinute;
+        
+        int start_idx, end_idx;
+        if (!nodeIndex.get(start, start_idx) || !nodeIndex.get(end, end_idx)) {
+            return result;
+        }
+        
+        SearchWorkspace& ws = localWorkspace();
+        ws.prepare(nodes.getSize());
+        ws.touch(start_idx);
+        ws.dist[start_idx] = departureMinute;
+        ws.heap.push({departureMinute, start_idx});
+        
+        while (!ws.heap.empty()) {
+            HeapEntry top = ws.heap.top();
+            ws.heap.pop();
+            int u = top.second;
+            if (ws.settled[u]) continue;
+            ws.settled[u] = true;
+            ++ws.settledCount;
+            if (u == end_idx) break;
+            relaxNeighborsTimed(ws, u);
+        }
+        
+        if (ws.distanceOf(end_idx) == std::numeric_limits<double>::infinity()) {
+            return result;
+        }
+        result.arrivalMinute = ws.dist[end_idx];
+        CustomVector<int> path_indices;
+        for (int current = end_idx; current != -1; current = ws.parent[current]) {
+            path_indices.push_back(current);
+        }
+        for (int i = path_indices.getSize() - 1; i >= 0; --i) {
+            result.path.push_back(nodes[path_indices[i]]->id);
+        }
+        return result;
+    }
+    
+    // TIME-DEPENDENT EXPAND: expandFrom jaisa, par visitor ko arrival minute
+    // milta hai (departureMinute par start se nikle to). Candidates ko
+    // waqt ke hisaab se paas-door order mein dekhne ke liye.
+    template<typename Visitor>
+    size_t timeDependentExpandFrom(const std::string& start, double departureMinute, Visitor visit) const {
+        int start_idx;
+        if (!nodeIndex.get(start, start_idx)) {
+            return 0;
+        }
+        
+        SearchWorkspace& ws = localWorkspace();
+        ws.prepare(nodes.getSize());
+        ws.touch(start_idx);
+        ws.dist[start_idx] = departureMinute;
+        ws.heap.push({departureMinute, start_idx});
+        
+        while (!ws.heap.empty()) {
+            HeapEntry top = ws.heap.top();
+            ws.heap.pop();
+            int u = top.second;
+            if (ws.settled[u]) continue;
+            ws.settled[u] = true;
+            ++ws.settledCount;
+            if (!visit(nodes[u]->id, top.first)) break;
+            relaxNeighborsTimed(ws, u);
+        }
+        return ws.settledCount;
+    }
+    
+    // EXPAND FROM: Dijkstra frontier ko start se bahar ki taraf badhate hain
+    // Har node settle hote hi visitor(nodeId, distance) call hota hai -
+    // Distance non-decreasing order mein aate hain (paas wale pehle).
+    // Visitor false return kare to search wahi ruk jati hai.
+    // Kaam sirf utna jitna visitor ko chahiye - Poora graph scan nahi.
+    // Return: kitne nodes settle hue
+    template<typename Visitor>
+    size_t expandFrom(const std::string& start, Visitor visit) const {
+        int start_idx;
+        if (!nodeIndex.get(start, start_idx)) {
+            return 0;
+        }
+        
+        SearchWorkspace& ws = localWorkspace();
+        ws.prepare(nodes.getSize());
+        ws.touch(start_idx);
+        ws.dist[start_idx] = 0;
+        ws.heap.push({0, start_idx});
+        
+        while (!ws.heap.empty()) {
+            HeapEntry top = ws.heap.top();
+            ws.heap.pop();
+            int u = top.second;
+            
+            if (ws.settled[u]) continue;
+            ws.settled[u] = true;
+            ++ws.settledCount;
+            
+            if (!visit(nodes[u]->id, top.first)) break; // Visitor ko kaafi mil gaya
+            
+            relaxNeighbors(ws, u);
+        }
+        return ws.settledCount;
+    }
+    
+    // NODES WITHIN: Start se budget (km) ke andar sab nodes + unka distance
+    // Frontier budget cross karte hi ruk jati hai - Kaam covered area jitna,
+    // poore graph jitna nahi. Distance order mein (paas wale pehle)
+    CustomVector<std::pair<std::string, double>> nodesWithin(const std::string& start, double budget) const {
+        CustomVector<std::pair<std::string, double>> result;
+        expandFrom(start, [&](const std::string& nodeId, double distance) {
+            if (distance > budget) return false; // Budget khatam - Aage sab door hain
+            result.push_back({nodeId, distance});
+            return true;
+        });
+        return result;
+    }
+    
+    // NODES WITHIN TIME: Isochrone - departureMinute par nikle to
+    // minutesBudget ke andar kin nodes tak pahunch sakte hain (traffic ke saath)
+    // Pair ka second = travel minutes
+    CustomVector<std::pair<std::string, double>> nodesWithinTime(const std::string& start, double departureMinute,
+                                                                 double minutesBudget) const {
+        CustomVector<std::pair<std::string, double>> result;
+        timeDependentExpandFrom(start, departureMinute, [&](const std::string& nodeId, double arrival) {
+            double minutes = arrival - departureMinute;
+            if (minutes > minutesBudget) return false;
+            result.push_back({nodeId, minutes});
+            return true;
+        });
+        return result;
+    }
+    
+    // LAST SETTLED COUNT: Is thread ki pichli search ne kitne nodes settle kiye
+    // Search ka kaam measure karne ke liye (benchmark/stats)
+    size_t lastSettledCount() const {
+        return localWorkspace().settledCount;
+    }
+    
     // BFS TRAVERSAL: Breadth-First Search
     // Level by level sab nodes visit karte hain
     // Dekhna: "H1 se H5 tak kaun kaun se centers pass karte hain"
@@ -246,7 +894,7 @@ public:
             Edge* edge = nodes[u]->edges;
             while (edge != nullptr) {
                 int v = edge->to;
-                if (!visited[v]) {
+                if (!visited[v] && edge->cost() != std::numeric_limits<double>::infinity()) {
                     visited[v] = true; // Mark visited
                     queue.push_back(v); // Queue mein add
                 }
@@ -257,6 +905,118 @@ public:
         return result;
     }
     
+    // DISTANCES FROM: Start se har node tak shortest distance (full SSSP)
+    // Index = node index (getNodeIndex), unreachable = infinity
+    // Hot hospitals ke liye poora vector cache karne ke kaam aata hai
+    CustomVector<double> distancesFrom(const std::string& start) const {
+        CustomVector<double> result(nodes.getSize());
+        expandFrom(start, [](const std::string&, double) { return true; }); // Poora graph
+        const SearchWorkspace& ws = localWorkspace();
+        bool reached = nodeIndex.contains(start);
+        for (size_t i = 0; i < nodes.getSize(); ++i) {
+            result.push_back(reached ? ws.distanceOf(static_cast<int>(i))
+                                     : std::numeric_limits<double>::infinity());
+        }
+        return result;
+    }
+    
+    // EXPORT CSR: Flat (Compressed Sparse Row) copy - Linked lists ke bajaye
+    // teen contiguous arrays. Node u ki edges = targets/weights[offsets[u] .. offsets[u+1])
+    // Parallel algorithms (delta-stepping) ke liye - Pointer chasing nahi,
+    // threads bina lock ke padh sakte hain. Band roads (infinity) skip.
+    void exportCSR(CustomVector<int>& offsets, CustomVector<int>& targets, CustomVector<double>& weights) const {
+        offsets = CustomVector<int>(nodes.getSize() + 1);
+        targets = CustomVector<int>();
+        weights = CustomVector<double>();
+        offsets.push_back(0);
+        for (size_t i = 0; i < nodes.getSize(); ++i) {
+            Edge* edge = nodes[i]->edges;
+            while (edge != nullptr) {
+                if (edge->cost() != std::numeric_limits<double>::infinity()) {
+                    targets.push_back(edge->to);
+                    weights.push_back(edge->cost());
+                }
+                edge = edge->next;
+            }
+            offsets.push_back(static_cast<int>(targets.getSize()));
+        }
+    }
+    
+    // GET EPOCH: Graph ka current version - Cache validation ke liye
+    unsigned long getEpoch() const {
+        return epoch.load();
+    }
+    
+    // GET NODE INDEX: ID se internal index, -1 agar node nahi
+    int getNodeIndex(const std::string& id) const {
+        int idx;
+        return nodeIndex.get(id, idx) ? idx : -1;
+    }
+    
+    // GET COORDINATES: Node ki map position - False agar node nahi
+    bool getCoordinates(const std::string& id, int& x, int& y) const {
+        int idx;
+        if (!nodeIndex.get(id, idx)) {
+            return false;
+        }
+        x = nodes[idx]->x;
+        y = nodes[idx]->y;
+        return true;
+    }
+    
+    // LOWER BOUND SCALE: Aisa factor s ke har road ka weight >= s * uski
+    // (x,y) seedhi lambai. Triangle inequality se har path bhi:
+    //   shortestDistance(a, b) >= s * euclidean(a, b)
+    // Yani s * seedhi doori graph search ke bagair ek pakki lower bound hai.
+    // Koi road coordinates se chhoti (zero weight) ho to s = 0 (bound bekaar)
+    // O(E) - Sirf graph badalne ke baad pehli call par
+    double lowerBoundScale() const {
+        std::lock_guard<std::mutex> guard(scaleLock);
+        unsigned long current = epoch.load();
+        if (scaleEpoch == current) {
+            return scale;
+        }
+        double best = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < nodes.getSize(); ++i) {
+            Edge* edge = nodes[i]->edges;
+            while (edge != nullptr) {
+                double dx = static_cast<double>(nodes[i]->x) - nodes[edge->to]->x;
+                double dy = static_cast<double>(nodes[i]->y) - nodes[edge->to]->y;
+                double length = std::sqrt(dx * dx + dy * dy);
+                if (length > 0 && edge->cost() / length < best) {
+                    best = edge->cost() / length; // Band road (infinity) kabhi min nahi
+                }
+                edge = edge->next;
+            }
+        }
+        // Rounding se bound kabhi asal doori se upar na jaye
+        scale = best == std::numeric_limits<double>::infinity() ? 0.0 : best * (1.0 - 1e-9);
+        scaleEpoch = current;
+        return scale;
+    }
+    
+    // FASTEST PACE: Sab profiles (aur flat default) mein sabse kam minutes
+    // per km. Profile piecewise-linear hai, to minimum kisi breakpoint par -
+    // lowerBoundScale ke saath travel minutes ki pakki lower bound
+    double fastestMinutesPerKm() const {
+        double best = DEFAULT_MINUTES_PER_KM;
+        for (size_t p = 0; p < profiles.getSize(); ++p) {
+            for (size_t i = 0; i < profiles[p].getSize(); ++i) {
+                if (profiles[p][i].second < best) best = profiles[p][i].second;
+            }
+        }
+        return best;
+    }
+    
+    // GET NODE IDS: Sab node IDs, index order mein
+    CustomVector<std::string> getNodeIds() const {
+        CustomVector<std::string> ids(nodes.getSize());
+        for (size_t i = 0; i < nodes.getSize(); ++i) {
+            ids.push_back(nodes[i]->id);
+        }
+        return ids;
+    }
+    
     // GET NODE COUNT: Kitne centers/hospitals hain
     size_t getNodeCount() const {
         return nodes.getSize();
@@ -287,9 +1047,18 @@ public:
 //    - Level by level nodes visit
 //    - O(V+E) time complexity
 //    - Queue use karte hain (FIFO)
-// 6. Node Structure: ID, Name, Type, Coordinates
-// 7. Edge Structure: Target node, Weight (distance)
-// 8. Applications:
+// 6. Search Workspace: Thread-local reusable arrays, O(1) reset
+//    - expandFrom: Frontier visitor, jaldi ruk sakti hai (k-nearest)
+//    - bidirectionalDijkstra: Dono sides se search, kam nodes settle
+//    - repairAfterEdgeChange: Weight update ke baad sirf affected subtree
+//    - nodesWithin / nodesWithinTime: Radius / isochrone, budget par ruk jati
+// 7. Time-Dependent Routing: Edges par optional traffic profile
+//    - Shared piecewise-linear minutes-per-km, edge mein sirf 2-byte id
+//    - timeDependentRoute: Label = arrival time (departure par depend)
+// 8. Node Structure: ID, Name, Type, Coordinates
+//    - lowerBoundScale: Coordinates se graph distance ki pakki lower bound
+// 9. Edge Structure: Target node, Weight (distance), Profile id
+// 10. Applications:
 //    - Navigation/Maps (find shortest route)
 //    - Social networks (friend suggestions)
 //    - Flight routes (best path with stops)
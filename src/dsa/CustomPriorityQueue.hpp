@@ -153,6 +153,12 @@ public:
     size_t size() const {
         return heap.getSize();
     }
+    
+    // CLEAR: Sab elements hata do - Capacity wahi rehti hai
+    // Reusable queue ke liye (har search par naya heap allocate nahi)
+    void clear() {
+        heap.clear();
+    }
 };
 
 // ===========================================================
@@ -36,7 +36,7 @@ public:
     
     // Copy constructor
     CustomVector(const CustomVector& other) : capacity(other.capacity), size(other.size) {
-        data = new T[capacity];
+        data = capacity ? new T[capacity] : nullptr; // Khaali vector - Allocation nahi
         for (size_t i = 0; i < size; ++i) {
             data[i] = other.data[i];
         }
@@ -48,7 +48,7 @@ public:
             delete[] data;
             capacity = other.capacity;
             size = other.size;
-            data = new T[capacity];
+            data = capacity ? new T[capacity] : nullptr;
             for (size_t i = 0; i < size; ++i) {
                 data[i] = other.data[i];
             }
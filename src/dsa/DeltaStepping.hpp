@@ -0,0 +1,295 @@
+#ifndef DELTA_STEPPING_HPP
+#define DELTA_STEPPING_HPP
+
+#include "CustomVector.hpp"
+#include "CustomGraph.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// ==================== DELTA-STEPPING BASICS ====================
+// Dijkstra ek waqt mein ek hi node settle karta hai - Strictly sequential.
+// Delta-stepping nodes ko distance ke "buckets" mein daalta hai:
+// bucket i = [i*delta, (i+1)*delta). Ek bucket ke sab nodes ek saath
+// (parallel) relax ho sakte hain.
+//
+// Har bucket mein:
+// 1. Light edges (weight <= delta) baar baar relax - Naye nodes isi bucket
+//    mein aa sakte hain, jab tak bucket khali na ho
+// 2. Phir bucket ke sab settled nodes ki heavy edges (weight > delta) ek dafa
+//
+// delta chhota = Dijkstra jaisa (kam kaam, kam parallelism)
+// delta bada   = Bellman-Ford jaisa (zyada parallelism, zyada re-relaxation)
+//
+// Graph ka flat CSR snapshot use hota hai - Threads bina lock ke padhte
+// hain, distances atomic CAS-min se update hote hain.
+// Result dijkstra() ke distances se bilkul same hai.
+// ================================================================
+
+class DeltaStepping {
+public:
+    struct Stats {
+        size_t buckets;       // Kitne non-empty buckets process hue
+        size_t phases;        // Kitne parallel phases (light + heavy)
+        size_t relaxations;   // Kitni edges relax ki
+        double delta;         // Asal mein use hui bucket width (clamp ke baad)
+        Stats() : buckets(0), phases(0), relaxations(0), delta(0) {}
+    };
+
+private:
+    const CustomGraph& graph;
+    CustomVector<int> offsets;
+    CustomVector<int> targets;
+    CustomVector<double> weights;
+    size_t n;
+    unsigned long snapshotEpoch;
+    Stats lastStats;
+
+    // CAS-min: dist[v] = min(dist[v], candidate) - True agar kam hua
+    static bool relaxAtomic(std::atomic<double>& slot, double candidate) {
+        double current = slot.load(std::memory_order_relaxed);
+        while (candidate < current) {
+            if (slot.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // WORKER POOL: Threads ek baar bante hain, har phase par sirf jagte hain
+    // Phase = items ki list, har thread chunks utha kar relax karta hai
+    class PhaseRunner {
+    private:
+        unsigned threadCount;
+        CustomVector<std::thread*> workers;
+        std::mutex lock;
+        std::condition_variable startSignal;
+        std::condition_variable doneSignal;
+        unsigned long generation;
+        unsigned pending;
+        bool stopping;
+        std::function<void(unsigned)> job;
+
+        void workerLoop(unsigned tid) {
+            unsigned long seen = 0;
+            while (true) {
+                std::function<void(unsigned)> current;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    startSignal.wait(guard, [&] { return stopping || generation != seen; });
+                    if (stopping) return;
+                    seen = generation;
+                    current = job;
+                }
+                current(tid);
+                std::lock_guard<std::mutex> guard(lock);
+                if (--pending == 0) doneSignal.notify_one();
+            }
+        }
+
+    public:
+        explicit PhaseRunner(unsigned threads)
+            : threadCount(threads), generation(0), pending(0), stopping(false) {
+            for (unsigned t = 1; t < threadCount; ++t) {
+                workers.push_back(new std::thread(&PhaseRunner::workerLoop, this, t));
+            }
+        }
+
+        ~PhaseRunner() {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                stopping = true;
+            }
+            startSignal.notify_all();
+            for (size_t i = 0; i < workers.getSize(); ++i) {
+                workers[i]->join();
+                delete workers[i];
+            }
+        }
+
+        unsigned size() const { return threadCount; }
+
+        // RUN: Sab threads par work(tid) chalao, caller thread 0 hai
+        void run(const std::function<void(unsigned)>& work) {
+            if (threadCount == 1) {
+                work(0);
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                job = work;
+                pending = threadCount - 1;
+                ++generation;
+            }
+            startSignal.notify_all();
+            work(0);
+            std::unique_lock<std::mutex> guard(lock);
+            doneSignal.wait(guard, [&] { return pending == 0; });
+        }
+    };
+
+    // Thread team - Calls ke beech zinda rehti hai, thread count badle to nayi
+    std::unique_ptr<PhaseRunner> runner;
+
+public:
+    // Bucket width ki nichli had = suggestDelta() ka ye hissa. Buckets ~
+    // maxDist / delta - Bahut chhota delta (e.g. 1e-9) sirf khaali buckets
+    // ki memory badhata hai, parallelism nahi
+    static constexpr double MIN_DELTA_FRACTION = 1.0 / 16;
+
+    // Graph ka CSR snapshot leta hai - Graph badle to refresh() karo
+    // Ek instance ek waqt mein ek hi distancesFrom (team aur stats shared)
+    explicit DeltaStepping(const CustomGraph& g) : graph(g), n(0), snapshotEpoch(0) {
+        refresh();
+    }
+
+    // REFRESH: Graph ka naya flat snapshot (sirf agar epoch badla)
+    void refresh() {
+        if (n != 0 && snapshotEpoch == graph.getEpoch()) {
+            return;
+        }
+        snapshotEpoch = graph.getEpoch();
+        graph.exportCSR(offsets, targets, weights);
+        n = graph.getNodeCount();
+    }
+
+    // SUGGEST DELTA: Average edge weight - Aam taur par achha starting point
+    double suggestDelta() const {
+        if (weights.empty()) return 1.0;
+        double total = 0;
+        for (size_t i = 0; i < weights.getSize(); ++i) total += weights[i];
+        return total / weights.getSize();
+    }
+
+    // CLAMP DELTA: [suggestDelta() * MIN_DELTA_FRACTION, inf) - NaN bhi yahin pakda jata hai
+    double clampDelta(double delta) const {
+        double floor = suggestDelta() * MIN_DELTA_FRACTION;
+        return delta >= floor ? delta : floor;
+    }
+
+    // DISTANCES FROM: Start se har node tak distance, index = node index
+    // delta = bucket width (clampDelta se), threads = kitne threads (1 = sequential)
+    // Unreachable = infinity. Same output as CustomGraph::distancesFrom
+    CustomVector<double> distancesFrom(const std::string& start, double delta, unsigned threads) {
+        lastStats = Stats();
+        CustomVector<double> result(n);
+        delta = clampDelta(delta);
+        lastStats.delta = delta;
+        int source = graph.getNodeIndex(start);
+        if (source < 0 || static_cast<size_t>(source) >= n) {
+            for (size_t i = 0; i < n; ++i) result.push_back(std::numeric_limits<double>::infinity());
+            return result;
+        }
+        if (threads == 0) threads = 1;
+        if (!runner || runner->size() != threads) runner.reset(new PhaseRunner(threads));
+
+        std::unique_ptr<std::atomic<double>[]> dist(new std::atomic<double>[n]);
+        for (size_t i = 0; i < n; ++i) dist[i].store(std::numeric_limits<double>::infinity());
+        dist[source].store(0.0);
+
+        // Bucket ka number kisi distance ke liye
+        auto bucketOf = [delta](double d) { return static_cast<size_t>(d / delta); };
+
+        // Coordinator-owned state - Sirf phases ke beech badalti hai
+        CustomVector<CustomVector<int>> buckets;
+        CustomVector<size_t> frontierStamp;  // Node is round ke frontier mein hai?
+        CustomVector<size_t> settledStamp;   // Node is bucket ke settled set mein hai?
+        for (size_t i = 0; i < n; ++i) {
+            frontierStamp.push_back(0);
+            settledStamp.push_back(0);
+        }
+        buckets.push_back(CustomVector<int>());
+        buckets[0].push_back(source);
+
+        CustomVector<CustomVector<int>> improved;   // Per-thread improved nodes
+        for (unsigned t = 0; t < threads; ++t) improved.push_back(CustomVector<int>());
+        std::atomic<size_t> relaxCount{0};
+
+        // Ek phase: items ki edges (light ya heavy) parallel relax
+        auto relaxPhase = [&](const CustomVector<int>& items, bool light) {
+            std::atomic<size_t> cursor{0};
+            const size_t chunk = 64;
+            runner->run([&](unsigned tid) {
+                CustomVector<int>& out = improved[tid];
+                size_t local = 0;
+                while (true) {
+                    size_t begin = cursor.fetch_add(chunk);
+                    if (begin >= items.getSize()) break;
+                    size_t end = begin + chunk < items.getSize() ? begin + chunk : items.getSize();
+                    for (size_t k = begin; k < end; ++k) {
+                        int u = items[k];
+                        double du = dist[u].load(std::memory_order_relaxed);
+                        for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+                            double w = weights[e];
+                            if ((w <= delta) != light) continue;
+                            ++local;
+                            if (relaxAtomic(dist[targets[e]], du + w)) {
+                                out.push_back(targets[e]);
+                            }
+                        }
+                    }
+                }
+                relaxCount += local;
+            });
+            ++lastStats.phases;
+
+            // Improved nodes ko unke naye bucket mein daalo
+            for (unsigned t = 0; t < threads; ++t) {
+                for (size_t k = 0; k < improved[t].getSize(); ++k) {
+                    int v = improved[t][k];
+                    size_t b = bucketOf(dist[v].load(std::memory_order_relaxed));
+                    while (buckets.getSize() <= b) buckets.push_back(CustomVector<int>());
+                    buckets[b].push_back(v);
+                }
+                improved[t].clear();
+            }
+        };
+
+        size_t round = 0;
+        for (size_t i = 0; i < buckets.getSize(); ++i) {
+            if (buckets[i].empty()) continue;
+            ++lastStats.buckets;
+            CustomVector<int> settled;
+
+            // LIGHT PHASES: Bucket khali hone tak
+            while (!buckets[i].empty()) {
+                CustomVector<int> pending = buckets[i];
+                buckets[i] = CustomVector<int>();
+                ++round;
+                CustomVector<int> frontier;
+                for (size_t k = 0; k < pending.getSize(); ++k) {
+                    int v = pending[k];
+                    // Stale entry (node aage/peeche bucket mein ja chuka) ya duplicate - Skip
+                    if (bucketOf(dist[v].load(std::memory_order_relaxed)) != i) continue;
+                    if (frontierStamp[v] == round) continue;
+                    frontierStamp[v] = round;
+                    frontier.push_back(v);
+                    if (settledStamp[v] != i + 1) {
+                        settledStamp[v] = i + 1;
+                        settled.push_back(v);
+                    }
+                }
+                if (!frontier.empty()) relaxPhase(frontier, true);
+            }
+
+            // HEAVY PHASE: Settled nodes ki heavy edges ek dafa
+            relaxPhase(settled, false);
+            buckets[i] = CustomVector<int>(); // Memory free
+        }
+
+        lastStats.relaxations = relaxCount.load();
+        for (size_t i = 0; i < n; ++i) result.push_back(dist[i].load());
+        return result;
+    }
+
+    Stats getLastStats() const {
+        return lastStats;
+    }
+};
+
+#endif // DELTA_STEPPING_HPP
@@ -0,0 +1,209 @@
+#ifndef MIN_COST_ASSIGNMENT_HPP
+#define MIN_COST_ASSIGNMENT_HPP
+
+#include "CustomVector.hpp"
+#include "CustomPriorityQueue.hpp"
+#include <limits>
+#include <utility>
+
+// ==================== MIN-COST ASSIGNMENT BASICS ====================
+// Rows (recipients) ko columns (donors) assign karna hai - Har column
+// zyada se zyada ek row ko, aur total cost minimum. Greedy (pehle aao
+// pehle pao) yahan fail hota hai: pehla recipient woh donor le leta hai
+// jo doosre ka akela option tha.
+//
+// Sparse version: Har row ki sirf chand candidate edges (e.g. k nearest
+// donors) - Poori R x C matrix nahi banti.
+// Har row ka ek "unassigned" option bhi hai (private dummy column,
+// cost = unassignedCost) - Is liye har row ka jawab hamesha milta hai.
+//
+// Algorithm: Successive shortest augmenting paths (Hungarian ka sparse
+// roop). Har free row se Dijkstra alternating paths par:
+//   row -> candidate column -> us column ka current owner row -> ...
+// jab tak koi free column na mile. Column potentials v[] reduced costs ko
+// non-negative rakhte hain, is liye Dijkstra chal sakta hai.
+// Free column milte hi search ruk jata hai - Aam taur par path chhota.
+//
+// Time: Worst O(R * E log E), practice mein bahut kam (early stop)
+// ====================================================================
+
+class MinCostAssignment {
+public:
+    struct Stats {
+        size_t augmentations;    // Kitne augmenting paths (= rows)
+        size_t scannedColumns;   // Sab Dijkstras mein kitne columns settle hue
+        size_t reassignments;    // Path par kitni rows ne column badla
+        Stats() : augmentations(0), scannedColumns(0), reassignments(0) {}
+    };
+
+private:
+    typedef std::pair<double, int> HeapEntry; // (reduced distance, column)
+
+    struct MinDistCompare {
+        bool operator()(const HeapEntry& a, const HeapEntry& b) const {
+            return a.first < b.first;
+        }
+    };
+
+    size_t rows;
+    size_t cols;                                          // Real columns - Dummies alag
+    CustomVector<CustomVector<std::pair<int, double>>> edges; // row -> (column, cost)
+    CustomVector<int> rowToCol;                           // -1 = abhi free
+    CustomVector<int> colToRow;                           // -1 = free (dummies bhi shamil)
+    CustomVector<double> rowCost;                         // Row ke current column ki cost
+    Stats lastStats;
+
+    int dummyOf(size_t row) const {
+        return static_cast<int>(cols + row);
+    }
+
+public:
+    // rows = recipients, cols = donors
+    // Har row ka unassigned cost default infinity (setUnassignedCost se badlo)
+    MinCostAssignment(size_t rowCount, size_t colCount) : rows(rowCount), cols(colCount) {
+        for (size_t r = 0; r < rows; ++r) {
+            CustomVector<std::pair<int, double>> list;
+            list.push_back({dummyOf(r), std::numeric_limits<double>::infinity()});
+            edges.push_back(list);
+            rowToCol.push_back(-1);
+            rowCost.push_back(0);
+        }
+        for (size_t c = 0; c < cols + rows; ++c) colToRow.push_back(-1);
+    }
+
+    // Candidate edge - Cost non-negative honi chahiye
+    void addCandidate(size_t row, size_t col, double cost) {
+        if (row >= rows || col >= cols || cost < 0) return;
+        edges[row].push_back({static_cast<int>(col), cost});
+    }
+
+    // Row ko khali chhodne ki qeemat - Jitni zyada, utna zaroori match
+    void setUnassignedCost(size_t row, double cost) {
+        if (row >= rows) return;
+        edges[row][0].second = cost; // Index 0 = dummy column
+    }
+
+    // SOLVE: Minimum total cost assignment
+    // Return = total cost (unassigned rows ki cost bhi shamil)
+    double solve() {
+        lastStats = Stats();
+        size_t totalCols = cols + rows;
+        const double INF = std::numeric_limits<double>::infinity();
+
+        CustomVector<double> v;           // Column potentials
+        CustomVector<double> dist;        // Is search mein reduced distance
+        CustomVector<int> pred;           // Column kis row se pahuncha
+        CustomVector<double> predCost;    // Us row -> column edge ki cost
+        CustomVector<size_t> stamp;       // dist valid hai? (generation)
+        CustomVector<bool> done;          // Column settle ho gaya?
+        for (size_t c = 0; c < totalCols; ++c) {
+            v.push_back(0);
+            dist.push_back(INF);
+            pred.push_back(-1);
+            predCost.push_back(0);
+            stamp.push_back(0);
+            done.push_back(false);
+        }
+        CustomVector<int> settled;
+        CustomPriorityQueue<HeapEntry, MinDistCompare> heap;
+
+        for (size_t r = 0; r < rows; ++r) {
+            if (rowToCol[r] != -1) continue;
+            size_t generation = r + 1;
+            settled.clear();
+            heap.clear();
+
+            // Row r ki edges se shuru
+            const CustomVector<std::pair<int, double>>& start = edges[r];
+            for (size_t i = 0; i < start.getSize(); ++i) {
+                int c = start[i].first;
+                double d = start[i].second - v[c];
+                if (stamp[c] != generation || d < dist[c]) {
+                    stamp[c] = generation;
+                    done[c] = false;
+                    dist[c] = d;
+                    pred[c] = static_cast<int>(r);
+                    predCost[c] = start[i].second;
+                    heap.push({d, c});
+                }
+            }
+
+            // Dijkstra - Pehla free column = sink
+            int sink = -1;
+            while (!heap.empty()) {
+                HeapEntry top = heap.top();
+                heap.pop();
+                int c = top.second;
+                if (done[c] || top.first > dist[c]) continue; // Purani entry
+                if (top.first == INF) break;                  // Baaki sab unreachable
+                done[c] = true;
+                if (colToRow[c] == -1) {
+                    sink = c;
+                    break;
+                }
+                settled.push_back(c);
+                ++lastStats.scannedColumns;
+
+                // Column ka owner row - Woh doosra column le to?
+                int owner = colToRow[c];
+                double base = dist[c] - (rowCost[owner] - v[c]);
+                const CustomVector<std::pair<int, double>>& list = edges[owner];
+                for (size_t i = 0; i < list.getSize(); ++i) {
+                    int k = list[i].first;
+                    if (k == c) continue;
+                    double d = base + list[i].second - v[k];
+                    if (stamp[k] != generation) {
+                        stamp[k] = generation;
+                        done[k] = false;
+                        dist[k] = INF;
+                    }
+                    if (!done[k] && d < dist[k]) {
+                        dist[k] = d;
+                        pred[k] = owner;
+                        predCost[k] = list[i].second;
+                        heap.push({d, k});
+                    }
+                }
+            }
+            if (sink == -1) continue; // Unassigned cost bhi infinity - Row free rehti hai
+
+            // Potentials update - Reduced costs non-negative rehte hain
+            double reach = dist[sink];
+            for (size_t i = 0; i < settled.getSize(); ++i) {
+                v[settled[i]] += dist[settled[i]] - reach;
+            }
+
+            // Path ulta chal kar augment
+            int c = sink;
+            while (true) {
+                int row = pred[c];
+                int previous = rowToCol[row];
+                rowToCol[row] = c;
+                rowCost[row] = predCost[c];
+                colToRow[c] = row;
+                if (row == static_cast<int>(r)) break;
+                ++lastStats.reassignments;
+                c = previous;
+            }
+            ++lastStats.augmentations;
+        }
+
+        double total = 0;
+        for (size_t r = 0; r < rows; ++r) {
+            if (rowToCol[r] != -1) total += rowCost[r];
+        }
+        return total;
+    }
+
+    // Row ka column - -1 agar unassigned (dummy) ya koi option nahi
+    int assignedColumn(size_t row) const {
+        int c = rowToCol[row];
+        return (c >= 0 && static_cast<size_t>(c) < cols) ? c : -1;
+    }
+
+    Stats getLastStats() const {
+        return lastStats;
+    }
+};
+
+#endif // MIN_COST_ASSIGNMENT_HPP
@@ -0,0 +1,347 @@
+#ifndef PERSISTENT_HASHMAP_HPP
+#define PERSISTENT_HASHMAP_HPP
+
+#include "CustomVector.hpp"
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+// ==================== PERSISTENT HASH MAP (HAMT) BASICS ====================
+// CustomHashMap ka "photo" lena ho (saare donors export karne hain aur
+// registrations chal rahi hain) to poora map copy karna padta hai - O(n).
+// Ye map kabhi apne nodes nahi badalta:
+//
+//   HASH ARRAY MAPPED TRIE - Key ke hash ke 5-5 bits se 32-way tree
+//     level 0: bits 0-4  -> 32 mein se ek slot
+//     level 1: bits 5-9  -> ...
+//   Har node mein sirf bhare hue slots (32-bit bitmap + chhota array),
+//   slot ka index = bitmap mein us se pehle kitne bits on hain (popcount)
+//
+//   PATH COPYING - insert/remove sirf root se leaf tak ke ~log32(n) nodes
+//   ki nayi copies banata hai, baaki sab purane version ke saath share.
+//   Is liye map ki copy = root pointer ki copy - O(1), chahe 10 ya 10 lakh
+//   entries. Purana version tab tak zinda jab tak koi copy use pakde hai
+//   (shared_ptr), phir khud free
+//
+// Interface CustomHashMap jaisa (insert, get, contains, remove, getKeys)
+// Ek object ko do threads ek saath na badlein - Lekin copies alag alag
+// threads par bina lock ke padhi ja sakti hain (nodes immutable)
+// ===========================================================================
+
+template<typename K, typename V>
+class PersistentHashMap {
+private:
+    static const unsigned BITS = 5;
+    static const unsigned WIDTH = 1u << BITS;   // 32 slots
+    static const unsigned MAX_SHIFT = 64;
+
+    // Poora 64-bit hash takraye (bahut kam) to baaki entries yahan
+    struct Bucket {
+        CustomVector<K> keys;
+        CustomVector<V> values;
+    };
+
+    struct Node;
+    // SLOT: Ya aage ka node (child), ya entry khud - Key/value slot ke andar
+    // hi, taake lookup mein har level par ek kam pointer chase ho
+    struct Slot {
+        std::shared_ptr<const Node> child;
+        uint64_t hash;
+        K key;
+        V value;
+        std::shared_ptr<const Bucket> more;     // Same hash wali aur entries
+        Slot() : hash(0), key(), value() {}
+    };
+
+    struct Node {
+        uint32_t bitmap;
+        CustomVector<Slot> slots;   // Sirf bhare slots, bitmap ke order mein
+        Node() : bitmap(0) {}
+    };
+
+    std::shared_ptr<const Node> root;
+    size_t size;
+
+    // CustomHashMap wala FNV-1a (64-bit, strings), baaki types std::hash
+    static uint64_t hashOf(const K& key) {
+        if constexpr (std::is_same<K, std::string>::value) {
+            uint64_t hash = 14695981039346656037ull;
+            for (char c : key) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        } else {
+            return static_cast<uint64_t>(std::hash<K>{}(key));
+        }
+    }
+
+    static unsigned indexAt(uint64_t hash, unsigned shift) {
+        return static_cast<unsigned>((hash >> shift) & (WIDTH - 1));
+    }
+
+    // Bitmap mein bit se pehle kitne slots bhare - Array mein position
+    static unsigned positionOf(uint32_t bitmap, uint32_t bit) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_popcount(bitmap & (bit - 1)));
+#else
+        return static_cast<unsigned>(std::bitset<32>(bitmap & (bit - 1)).count());
+#endif
+    }
+
+    static Slot makeLeaf(uint64_t hash, const K& key, const V& value) {
+        Slot slot;
+        slot.hash = hash;
+        slot.key = key;
+        slot.value = value;
+        return slot;
+    }
+
+    // Do alag hash wali entries - Jis level par unke bits alag hon wahan tak node chain
+    static std::shared_ptr<const Node> mergeLeaves(const Slot& a, const Slot& b, unsigned shift) {
+        std::shared_ptr<Node> node = std::make_shared<Node>();
+        unsigned ia = indexAt(a.hash, shift);
+        unsigned ib = indexAt(b.hash, shift);
+        if (ia == ib) {
+            Slot slot;
+            slot.child = mergeLeaves(a, b, shift + BITS);
+            node->bitmap = 1u << ia;
+            node->slots.push_back(slot);
+            return node;
+        }
+        node->bitmap = (1u << ia) | (1u << ib);
+        node->slots.push_back(ia < ib ? a : b);
+        node->slots.push_back(ia < ib ? b : a);
+        return node;
+    }
+
+    // Node ki copy jis mein position par slot badla / joda / hataya
+    static std::shared_ptr<Node> withSlot(const Node& node, unsigned pos, const Slot* slot, bool insertNew) {
+        std::shared_ptr<Node> copy = std::make_shared<Node>();
+        copy->bitmap = node.bitmap;
+        copy->slots = CustomVector<Slot>(node.slots.getSize() + 1);
+        for (size_t i = 0; i < node.slots.getSize(); ++i) {
+            if (i == pos) {
+                if (insertNew) {
+                    copy->slots.push_back(*slot);
+                    copy->slots.push_back(node.slots[i]);
+                } else if (slot) {
+                    copy->slots.push_back(*slot);
+                }
+                continue;
+            }
+            copy->slots.push_back(node.slots[i]);
+        }
+        if (insertNew && pos == node.slots.getSize()) copy->slots.push_back(*slot);
+        return copy;
+    }
+
+    static std::shared_ptr<const Node> insertAt(const std::shared_ptr<const Node>& node, uint64_t hash, unsigned shift,
+                                                const K& key, const V& value, bool& added) {
+        uint32_t bit = 1u << indexAt(hash, shift);
+        unsigned pos = positionOf(node->bitmap, bit);
+        if (!(node->bitmap & bit)) {
+            // Khaali slot - Seedha entry
+            Slot slot = makeLeaf(hash, key, value);
+            added = true;
+            std::shared_ptr<Node> copy = withSlot(*node, pos, &slot, true);
+            copy->bitmap |= bit;
+            return copy;
+        }
+        const Slot& existing = node->slots[pos];
+        Slot slot;
+        if (existing.child) {
+            slot.child = insertAt(existing.child, hash, shift + BITS, key, value, added);
+        } else if (existing.hash == hash) {
+            // Wahi hash - Key update, ya (poora hash takraya) bucket mein jodo
+            slot = existing;
+            if (existing.key == key) {
+                slot.value = value;
+            } else {
+                std::shared_ptr<Bucket> bucket = existing.more ? std::make_shared<Bucket>(*existing.more)
+                                                               : std::make_shared<Bucket>();
+                size_t i = 0;
+                while (i < bucket->keys.getSize() && !(bucket->keys[i] == key)) ++i;
+                if (i < bucket->keys.getSize()) {
+                    bucket->values[i] = value;
+                } else {
+                    bucket->keys.push_back(key);
+                    bucket->values.push_back(value);
+                    added = true;
+                }
+                slot.more = bucket;
+            }
+        } else {
+            // Alag hash, isi slot par - Neeche ek naya node dono ke liye
+            slot.child = mergeLeaves(existing, makeLeaf(hash, key, value), shift + BITS);
+            added = true;
+        }
+        return withSlot(*node, pos, &slot, false);
+    }
+
+    // Entry slot se key nikalo - False = slot khaali ho gaya
+    static bool withoutKey(const Slot& existing, const K& key, Slot& result, bool& removed) {
+        result = existing;
+        const Bucket* more = existing.more.get();
+        size_t dropped = 0;                     // Bucket ki kaunsi entry nikli
+        if (existing.key == key) {
+            removed = true;
+            if (!more) return false;
+            // Bucket ki pehli entry slot mein aa jati hai
+            result.key = more->keys[0];
+            result.value = more->values[0];
+        } else {
+            if (!more) return true;
+            while (dropped < more->keys.getSize() && !(more->keys[dropped] == key)) ++dropped;
+            if (dropped == more->keys.getSize()) return true;
+            removed = true;
+        }
+        std::shared_ptr<Bucket> bucket = std::make_shared<Bucket>();
+        for (size_t i = 0; i < more->keys.getSize(); ++i) {
+            if (i == dropped) continue;
+            bucket->keys.push_back(more->keys[i]);
+            bucket->values.push_back(more->values[i]);
+        }
+        result.more = bucket->keys.empty() ? std::shared_ptr<const Bucket>() : std::shared_ptr<const Bucket>(bucket);
+        return true;
+    }
+
+    // nullptr = node khaali ho gaya (parent slot hata de)
+    static std::shared_ptr<const Node> removeAt(const std::shared_ptr<const Node>& node, uint64_t hash, unsigned shift,
+                                                const K& key, bool& removed) {
+        uint32_t bit = 1u << indexAt(hash, shift);
+        if (!(node->bitmap & bit)) return node;
+        unsigned pos = positionOf(node->bitmap, bit);
+        const Slot& existing = node->slots[pos];
+        Slot slot;
+        bool keep = true;
+        if (existing.child) {
+            std::shared_ptr<const Node> child = removeAt(existing.child, hash, shift + BITS, key, removed);
+            if (!removed) return node;
+            if (!child) {
+                keep = false;
+            } else if (child->slots.getSize() == 1 && !child->slots[0].child) {
+                slot = child->slots[0];   // Akeli entry bachi - Upar khinch lo
+            } else {
+                slot.child = child;
+            }
+        } else {
+            if (existing.hash != hash) return node;
+            keep = withoutKey(existing, key, slot, removed);
+            if (!removed) return node;
+        }
+        if (keep) return withSlot(*node, pos, &slot, false);
+        if (node->slots.getSize() == 1) return nullptr;
+        std::shared_ptr<Node> copy = withSlot(*node, pos, nullptr, false);
+        copy->bitmap &= ~bit;
+        return copy;
+    }
+
+    template<typename F>
+    static bool visit(const Node& node, F& f) {
+        for (size_t i = 0; i < node.slots.getSize(); ++i) {
+            const Slot& slot = node.slots[i];
+            if (slot.child) {
+                if (!visit(*slot.child, f)) return false;
+                continue;
+            }
+            if (!f(slot.key, slot.value)) return false;
+            if (!slot.more) continue;
+            for (size_t k = 0; k < slot.more->keys.getSize(); ++k) {
+                if (!f(slot.more->keys[k], slot.more->values[k])) return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    typedef K Key;
+    typedef V Value;
+
+    PersistentHashMap() : root(std::make_shared<Node>()), size(0) {}
+
+    // Copy/assignment compiler wale - Sirf root pointer aur size, O(1)
+    // (yahi snapshot hai). Baad ki insert/remove sirf is object ka root badalti hain
+
+    // INSERT: Path copy - Purani copies par asar nahi
+    void insert(const K& key, const V& value) {
+        bool added = false;
+        root = insertAt(root, hashOf(key), 0, key, value, added);
+        if (added) ++size;
+    }
+
+    bool get(const K& key, V& value) const {
+        uint64_t hash = hashOf(key);
+        const Node* node = root.get();
+        for (unsigned shift = 0; shift < MAX_SHIFT; shift += BITS) {
+            uint32_t bit = 1u << indexAt(hash, shift);
+            if (!(node->bitmap & bit)) return false;
+            const Slot& slot = node->slots[positionOf(node->bitmap, bit)];
+            if (slot.child) {
+                node = slot.child.get();
+                continue;
+            }
+            if (slot.hash != hash) return false;
+            if (slot.key == key) {
+                value = slot.value;
+                return true;
+            }
+            if (!slot.more) return false;
+            for (size_t i = 0; i < slot.more->keys.getSize(); ++i) {
+                if (slot.more->keys[i] == key) {
+                    value = slot.more->values[i];
+                    return true;
+                }
+            }
+            return false;
+        }
+        return false;
+    }
+
+    bool contains(const K& key) const {
+        V ignored;
+        return get(key, ignored);
+    }
+
+    bool remove(const K& key) {
+        bool removed = false;
+        std::shared_ptr<const Node> updated = removeAt(root, hashOf(key), 0, key, removed);
+        if (!removed) return false;
+        root = updated ? updated : std::make_shared<Node>();
+        --size;
+        return true;
+    }
+
+    size_t getSize() const { return size; }
+
+    bool empty() const { return size == 0; }
+
+    // Sab entries - f(key, value) false de to ruk jao
+    template<typename F>
+    void forEach(F f) const {
+        visit(*root, f);
+    }
+
+    CustomVector<K> getKeys() const {
+        CustomVector<K> keys(size ? size : 1);
+        forEach([&keys](const K& key, const V&) {
+            keys.push_back(key);
+            return true;
+        });
+        return keys;
+    }
+};
+
+// ===========================================================================
+// PERSISTENT HASH MAP SUMMARY:
+// 1. Lookup: log32(n) nodes (10 lakh entries = 4 levels) - Har level ek
+//    bitmap check aur popcount
+// 2. Insert/Remove: Utne hi nodes ki nayi copies (har copy max 32 pointers)
+// 3. Snapshot (copy): O(1) - Sirf root
+// 4. Memory: Purane versions ke nodes tab tak jab tak koi copy zinda hai
+// ===========================================================================
+
+#endif // PERSISTENT_HASHMAP_HPP
@@ -0,0 +1,245 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include "CustomVector.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// ==================== TIMING WHEEL BASICS ====================
+// Hazaron (ya millions) timers - Request expiry, reservation timeout,
+// eligibility. Heap mein har insert/cancel O(log n) aur har tick par
+// top check. Timing wheel ghadi ki tarah hai:
+//
+// Level 0: 64 slots, har slot = 1 tick        (0 - 63 ticks)
+// Level 1: 64 slots, har slot = 64 ticks      (64 - 4095)
+// Level 2: 64 slots, har slot = 4096 ticks    (~1 ghanta tak, 1s tick)
+// Level 3: 64 slots, har slot = 262144 ticks  (~194 din tak)
+//
+// Insert: expiry se level aur slot nikalo, list mein jodo - O(1)
+// Cancel: list se unlink - O(1) (handle mein pool index + generation)
+// Tick:   level 0 ka agla slot fire. Level 0 ghoom jaye to upar wale
+//         level ka ek slot neeche "cascade" (dobara distribute) hota hai.
+//         Har timer zyada se zyada 3 dafa cascade hota hai - Per-tick kaam
+//         sirf us slot ke timers jitna, total timers se independent
+// ===============================================================
+
+class TimerWheel {
+public:
+    typedef unsigned long long TimerId; // (generation << 32) | pool index
+    static const TimerId NO_TIMER = 0;
+
+    struct Stats {
+        size_t active;           // Abhi kitne timers lage hain
+        unsigned long long ticks;
+        unsigned long long fired;
+        unsigned long long cancelled;
+        unsigned long long cascaded; // Upar ke level se neeche aaye
+        Stats() : active(0), ticks(0), fired(0), cancelled(0), cascaded(0) {}
+    };
+
+private:
+    static const int BITS = 6;
+    static const int SLOTS = 1 << BITS;
+    static const int MASK = SLOTS - 1;
+    static const int LEVELS = 4;
+    static const unsigned long long MAX_SPAN = 1ULL << (BITS * LEVELS);
+
+    struct Node {
+        unsigned long long expiry;     // Absolute tick
+        int prev;
+        int next;
+        int slot;                      // heads[] index, -1 = kisi list mein nahi
+        unsigned generation;           // Purane handle se cancel na ho
+        std::function<void()> callback;
+        Node() : expiry(0), prev(-1), next(-1), slot(-1), generation(1) {}
+    };
+
+    CustomVector<Node> pool;
+    CustomVector<int> freeList;        // Khali pool indexes
+    int heads[LEVELS * SLOTS];         // Har slot ki list ka pehla node
+    unsigned long long now;            // Agla tick jo process hona hai
+    Stats stats;
+
+    std::chrono::milliseconds tickLength;
+    std::mutex lock;
+    std::condition_variable wake;
+    bool stopping;
+    std::thread worker;
+
+    void link(int index, int slot) {
+        Node& node = pool[index];
+        node.slot = slot;
+        node.prev = -1;
+        node.next = heads[slot];
+        if (heads[slot] != -1) pool[heads[slot]].prev = index;
+        heads[slot] = index;
+    }
+
+    void unlink(int index) {
+        Node& node = pool[index];
+        if (node.prev != -1) pool[node.prev].next = node.next;
+        else heads[node.slot] = node.next;
+        if (node.next != -1) pool[node.next].prev = node.prev;
+        node.slot = -1;
+    }
+
+    // Expiry ke hisaab se sahi level/slot mein daalo
+    void place(int index) {
+        unsigned long long expiry = pool[index].expiry;
+        if (expiry < now) expiry = now;               // Late - Agle tick par
+        unsigned long long delta = expiry - now;
+        if (delta >= MAX_SPAN) expiry = now + MAX_SPAN - 1; // Bahut door - Top level par, baad mein cascade
+        delta = expiry - now;
+
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (1ULL << (BITS * (level + 1)))) ++level;
+        int slot = static_cast<int>((expiry >> (BITS * level)) & MASK);
+        link(index, level * SLOTS + slot);
+    }
+
+    // CASCADE: Level ka ek slot khali karke timers dobara place karo
+    // Return = slot index (0 matlab is level ne bhi chakkar poora kiya)
+    int cascade(int level, int slot) {
+        int head = heads[level * SLOTS + slot];
+        heads[level * SLOTS + slot] = -1;
+        while (head != -1) {
+            int next = pool[head].next;
+            pool[head].slot = -1;
+            place(head);
+            ++stats.cascaded;
+            head = next;
+        }
+        return slot;
+    }
+
+    // Ek tick - Due callbacks out mein (lock ke andar call karo)
+    void tickLocked(CustomVector<std::function<void()>>& out) {
+        int index = static_cast<int>(now & MASK);
+        if (index == 0) {
+            for (int level = 1; level < LEVELS; ++level) {
+                if (cascade(level, static_cast<int>((now >> (BITS * level)) & MASK)) != 0) break;
+            }
+        }
+        ++now;
+        ++stats.ticks;
+
+        int head = heads[index];
+        heads[index] = -1;
+        while (head != -1) {
+            Node& node = pool[head];
+            int next = node.next;
+            out.push_back(node.callback);
+            release(head);
+            ++stats.fired;
+            head = next;
+        }
+    }
+
+    // Node wapas pool mein - Generation badhao taake purana handle bekaar ho
+    void release(int index) {
+        Node& node = pool[index];
+        node.slot = -1;
+        node.callback = std::function<void()>();
+        ++node.generation;
+        freeList.push_back(index);
+        --stats.active;
+    }
+
+    void workerLoop() {
+        auto next = std::chrono::steady_clock::now() + tickLength;
+        while (true) {
+            CustomVector<std::function<void()>> due;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                if (wake.wait_until(guard, next, [&] { return stopping; })) return;
+                // Der se jage (load) to chhoote ticks bhi chala do
+                auto current = std::chrono::steady_clock::now();
+                while (next <= current) {
+                    tickLocked(due);
+                    next += tickLength;
+                }
+            }
+            // Callbacks lock ke bahar - Woh khud schedule/cancel kar sakte hain
+            for (size_t i = 0; i < due.getSize(); ++i) due[i]();
+        }
+    }
+
+public:
+    // tick = ek slot ka waqt. Thread start() se chalta hai
+    explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(1000))
+        : now(0), tickLength(tick), stopping(false) {
+        for (int i = 0; i < LEVELS * SLOTS; ++i) heads[i] = -1;
+    }
+
+    ~TimerWheel() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_one();
+        if (worker.joinable()) worker.join();
+    }
+
+    // Apne thread par ticking shuru
+    void start() {
+        if (!worker.joinable()) worker = std::thread(&TimerWheel::workerLoop, this);
+    }
+
+    // SCHEDULE: delay ke baad callback (wheel ke thread par) - O(1)
+    // Tick se chhota delay agle tick par round up hota hai
+    TimerId schedule(std::chrono::milliseconds delay, const std::function<void()>& callback) {
+        long long ticks = (delay.count() + tickLength.count() - 1) / tickLength.count();
+        if (ticks < 1) ticks = 1;
+        std::lock_guard<std::mutex> guard(lock);
+        int index;
+        if (!freeList.empty()) {
+            index = freeList[freeList.getSize() - 1];
+            freeList.pop_back();
+        } else {
+            index = static_cast<int>(pool.getSize());
+            pool.push_back(Node());
+        }
+        Node& node = pool[index];
+        node.expiry = now + static_cast<unsigned long long>(ticks) - 1;
+        node.callback = callback;
+        place(index);
+        ++stats.active;
+        return (static_cast<TimerId>(node.generation) << 32) | static_cast<TimerId>(index);
+    }
+
+    // CANCEL: O(1) - False agar pehle hi fire/cancel ho chuka
+    bool cancel(TimerId id) {
+        if (id == NO_TIMER) return false;
+        int index = static_cast<int>(id & 0xffffffffULL);
+        unsigned generation = static_cast<unsigned>(id >> 32);
+        std::lock_guard<std::mutex> guard(lock);
+        if (index < 0 || static_cast<size_t>(index) >= pool.getSize()) return false;
+        Node& node = pool[index];
+        if (node.generation != generation || node.slot == -1) return false;
+        unlink(index);
+        release(index);
+        ++stats.cancelled;
+        return true;
+    }
+
+    // ADVANCE: Thread ke bagair ticks chalao (tools/benchmarks) - Fired count
+    size_t advance(unsigned long long ticks) {
+        CustomVector<std::function<void()>> due;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (unsigned long long t = 0; t < ticks; ++t) tickLocked(due);
+        }
+        for (size_t i = 0; i < due.getSize(); ++i) due[i]();
+        return due.getSize();
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> guard(lock);
+        return stats;
+    }
+};
+
+#endif // TIMER_WHEEL_HPP
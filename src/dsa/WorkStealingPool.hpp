@@ -0,0 +1,208 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include "CustomVector.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// ==================== WORK STEALING POOL BASICS ====================
+// Crow ke I/O threads sockets padhte/likhte hain. Agar matching ya poori
+// CSV save unhi par chale to us thread ke saare connections (e.g. ek
+// sasta /api/health) us kaam ke khatam hone tak atke rehte hain.
+// Is liye bhaari kaam alag threads par - Ye pool.
+//
+// Har worker ki apni deque (ring buffer):
+//   - Worker apni deque ke PEECHE se leta hai (LIFO) - Abhi dala hua kaam,
+//     cache mein garam
+//   - Khaali ho to doosre worker ki deque ke AAGE se "churata" hai (FIFO) -
+//     Sabse purana kaam, jo sabse der se ruka hai
+//   - Bahar (I/O thread) se aaya kaam round-robin deques mein
+// Ek global queue par sab threads ka ek lock nahi - Har deque ka apna
+// chhota lock, contention sirf stealing ke waqt
+// =====================================================================
+
+class WorkStealingPool {
+public:
+    typedef std::function<void()> Task;
+
+    struct Stats {
+        size_t threads;
+        unsigned long submitted;
+        unsigned long executed;
+        unsigned long stolen;       // Doosre worker ki deque se liye
+        size_t queued;              // Abhi intezar mein
+        Stats() : threads(0), submitted(0), executed(0), stolen(0), queued(0) {}
+    };
+
+private:
+    // Ring buffer deque - Bhar jaye to double
+    struct WorkDeque {
+        std::mutex lock;
+        CustomVector<Task*> ring;
+        size_t head;    // Aage (steal yahan se)
+        size_t count;
+        WorkDeque() : head(0), count(0) {
+            for (size_t i = 0; i < 64; ++i) ring.push_back(nullptr);
+        }
+
+        void pushBack(Task* task) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (count == ring.getSize()) {
+                CustomVector<Task*> bigger(ring.getSize() * 2);
+                for (size_t i = 0; i < ring.getSize() * 2; ++i) {
+                    bigger.push_back(i < count ? ring[(head + i) % ring.getSize()] : nullptr);
+                }
+                ring = bigger;
+                head = 0;
+            }
+            ring[(head + count) % ring.getSize()] = task;
+            ++count;
+        }
+
+        Task* popBack() {
+            std::lock_guard<std::mutex> guard(lock);
+            if (count == 0) return nullptr;
+            --count;
+            return ring[(head + count) % ring.getSize()];
+        }
+
+        Task* popFront() {
+            std::lock_guard<std::mutex> guard(lock);
+            if (count == 0) return nullptr;
+            Task* task = ring[head];
+            head = (head + 1) % ring.getSize();
+            --count;
+            return task;
+        }
+    };
+
+    CustomVector<WorkDeque*> deques;
+    CustomVector<std::thread*> workers;
+    std::atomic<size_t> pending{0};          // Sab deques mein kul
+    std::atomic<size_t> nextDeque{0};        // Bahar se aaye kaam ka round-robin
+    std::atomic<unsigned long> submittedCount{0};
+    std::atomic<unsigned long> executedCount{0};
+    std::atomic<unsigned long> stolenCount{0};
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    bool stopping;
+
+    // Is thread ka worker index (pool ka thread nahi to -1)
+    static long& currentWorker() {
+        thread_local long index = -1;
+        return index;
+    }
+
+    static const WorkStealingPool*& currentPool() {
+        thread_local const WorkStealingPool* pool = nullptr;
+        return pool;
+    }
+
+    // Apni deque, phir baaki sab se churao (apne se agle wale se shuru,
+    // taake sab ek hi victim par na toot padein)
+    Task* findTask(size_t self) {
+        Task* task = deques[self]->popBack();
+        if (task) return task;
+        size_t n = deques.getSize();
+        for (size_t k = 1; k < n; ++k) {
+            task = deques[(self + k) % n]->popFront();
+            if (task) {
+                ++stolenCount;
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    void workerLoop(size_t self) {
+        currentWorker() = static_cast<long>(self);
+        currentPool() = this;
+        while (true) {
+            Task* task = findTask(self);
+            if (!task) {
+                std::unique_lock<std::mutex> guard(sleepLock);
+                wake.wait(guard, [&] { return stopping || pending.load() > 0; });
+                if (stopping && pending.load() == 0) return;
+                continue;
+            }
+            --pending;
+            try {
+                (*task)();
+            } catch (...) {
+                // Kaam ki apni zimmedari - Worker thread zinda rahe
+            }
+            delete task;
+            ++executedCount;
+        }
+    }
+
+public:
+    // threads = 0 -> CPU cores jitne (kam se kam 2)
+    explicit WorkStealingPool(size_t threads = 0) : stopping(false) {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+            if (threads < 2) threads = 2;
+        }
+        for (size_t i = 0; i < threads; ++i) deques.push_back(new WorkDeque());
+        for (size_t i = 0; i < threads; ++i) {
+            workers.push_back(new std::thread(&WorkStealingPool::workerLoop, this, i));
+        }
+    }
+
+    // Baaki kaam khatam karke band
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (size_t i = 0; i < workers.getSize(); ++i) {
+            workers[i]->join();
+            delete workers[i];
+        }
+        for (size_t i = 0; i < deques.getSize(); ++i) {
+            Task* task;
+            while ((task = deques[i]->popFront()) != nullptr) delete task;
+            delete deques[i];
+        }
+    }
+
+    // SUBMIT: Pool ke worker se aaye to apni deque (LIFO), warna round-robin
+    void submit(const Task& work) {
+        Task* task = new Task(work);
+        size_t target;
+        if (currentPool() == this && currentWorker() >= 0) {
+            target = static_cast<size_t>(currentWorker());
+        } else {
+            target = nextDeque.fetch_add(1) % deques.getSize();
+        }
+        {
+            // Lock ke saath taake sone wala worker wake miss na kare. Push se
+            // pehle - Warna koi worker utha kar pending ko 0 se neeche le jaye
+            std::lock_guard<std::mutex> guard(sleepLock);
+            ++pending;
+        }
+        deques[target]->pushBack(task);
+        ++submittedCount;
+        wake.notify_one();
+    }
+
+    size_t threadCount() const {
+        return workers.getSize();
+    }
+
+    Stats getStats() const {
+        Stats s;
+        s.threads = workers.getSize();
+        s.submitted = submittedCount.load();
+        s.executed = executedCount.load();
+        s.stolen = stolenCount.load();
+        s.queued = pending.load();
+        return s;
+    }
+};
+
+#endif // WORK_STEALING_POOL_HPP
@@ -2,11 +2,13 @@
 #define CSV_HANDLER_HPP
 
 #include <fstream>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include "../dsa/CustomVector.hpp"
 #include "../dsa/CustomHashMap.hpp"
 #include "../models/Models.hpp"
+#include "Eligibility.hpp"
 
 class CSVHandler {
 public:
@@ -109,7 +111,8 @@ public:
            << escape(r.createdByUserId) << ","
            << r.age << ","
            << escape(r.medicalCondition) << ","
-           << r.unitsNeeded;
+           << r.unitsNeeded << ","
+           << escape(r.acceptedDonorIds);
         return ss.str();
     }
 
@@ -149,10 +152,26 @@ public:
         return t;
     }
 
+    // Poori file dobara likhne wale saves - Pool ke do threads ek hi file
+    // ek saath na likhein (warna lines aapas mein mix)
+    static std::mutex& fileLock() {
+        static std::mutex lock;
+        return lock;
+    }
+
+    static const char* donorHeader() {
+        return "id,name,age,gender,cnic,email,phone,address,city,area,bloodGroup,status,lastDonationDate,totalDonations,badgeLevel,isVerified,nextEligibleDate,locationNodeId,passwordHash\n";
+    }
+
+    static const char* recipientHeader() {
+        return "id,patientName,patientId,bloodGroupNeeded,urgency,locationType,hospitalName,locationNodeId,contactPerson,contactPhone,status,timestamp,matchedDonorId,createdByUserId,age,medicalCondition,unitsNeeded,acceptedDonorIds\n";
+    }
+
     static void saveAllDonors(const std::string& filename, const CustomHashMap<std::string, Donor*>& database) {
+        std::lock_guard<std::mutex> guard(fileLock());
         std::ofstream file(filename);
         if (file.is_open()) {
-            file << "id,name,age,gender,cnic,email,phone,address,city,area,bloodGroup,status,lastDonationDate,totalDonations,badgeLevel,isVerified,nextEligibleDate,locationNodeId,passwordHash\n";
+            file << donorHeader();
             CustomVector<std::string> keys = database.getKeys();
             for (size_t i = 0; i < keys.getSize(); ++i) {
                 Donor* d;
@@ -165,9 +184,10 @@ public:
     }
 
     static void saveAllRecipients(const std::string& filename, const CustomHashMap<std::string, Recipient*>& database) {
+        std::lock_guard<std::mutex> guard(fileLock());
         std::ofstream file(filename);
         if (file.is_open()) {
-            file << "id,patientName,patientId,bloodGroupNeeded,urgency,locationType,hospitalName,locationNodeId,contactPerson,contactPhone,status,timestamp,matchedDonorId,createdByUserId,age,medicalCondition,unitsNeeded\n";
+            file << recipientHeader();
             CustomVector<std::string> keys = database.getKeys();
             for (size_t i = 0; i < keys.getSize(); ++i) {
                 Recipient* r;
@@ -179,6 +199,32 @@ public:
         }
     }
 
+    // SNAPSHOT SAVE: Published snapshot ki immutable copies se (PersistentHashMap
+    // of SnapshotEntry) - Live objects nahi padhte, engine unhein badalta rahe
+    template<typename Views>
+    static void saveDonorViews(const std::string& filename, const Views& views) {
+        std::lock_guard<std::mutex> guard(fileLock());
+        std::ofstream file(filename);
+        if (!file.is_open()) return;
+        file << donorHeader();
+        views.forEach([&file](const std::string&, const typename Views::Value& entry) {
+            file << donorToCSV(*entry.view) << "\n";
+            return true;
+        });
+    }
+
+    template<typename Views>
+    static void saveRecipientViews(const std::string& filename, const Views& views) {
+        std::lock_guard<std::mutex> guard(fileLock());
+        std::ofstream file(filename);
+        if (!file.is_open()) return;
+        file << recipientHeader();
+        views.forEach([&file](const std::string&, const typename Views::Value& entry) {
+            file << recipientToCSV(*entry.view) << "\n";
+            return true;
+        });
+    }
+
     static Donor* csvToDonor(const std::string& line) {
         auto fields = splitCSV(line);
         if (fields.getSize() < 19) return nullptr;
@@ -203,6 +249,8 @@ public:
         d->nextEligibleDate = fields[16];
         d->locationNodeId = fields[17];
         d->passwordHash = fields[18];
+        d->lastDonationDay = EpochDays::parse(d->lastDonationDate);
+        d->nextEligibleDay = EpochDays::parse(d->nextEligibleDate);
         return d;
     }
 
@@ -228,6 +276,7 @@ public:
         r->age = std::stoi(fields[14]);
         r->medicalCondition = fields[15];
         r->unitsNeeded = std::stoi(fields[16]);
+        if (fields.getSize() > 17) r->acceptedDonorIds = fields[17]; // Purani files mein column nahi
         return r;
     }
 };
@@ -0,0 +1,230 @@
+#ifndef DISPATCH_BOARD_HPP
+#define DISPATCH_BOARD_HPP
+
+#include "../dsa/CustomHashMap.hpp"
+#include "../dsa/CustomVector.hpp"
+#include "../dsa/TimerWheel.hpp"
+#include "WebSocketHub.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Dispatch Board - Broadcast-and-claim. Immediate request par ek donor se
+// pooch kar intezar karna bahut slow hai. Is liye top N nearest donors ko
+// ek saath "donor:<id>" par offer jata hai, aur jo pehle accept kare woh
+// jeet jata hai:
+//
+//   remaining = unitsNeeded (atomic)
+//   claim: remaining ko CAS se ek kam karo - 0 par pahunch chuka to haar
+//
+// Lock sirf offer dhoondne ke liye (map) - Jeet/haar ka faisla ek atomic
+// compare-exchange hai, is liye 10 donors ek saath accept karein to bhi
+// sirf unitsNeeded jeetenge. Saare slots bharte hi baaki notified donors
+// ko "filled" frame (ek hi publish, kayi topics).
+// Timeout tak koi accept na kare to offer band aur fallback (normal
+// reservation path)
+class DispatchBoard {
+public:
+    enum ClaimResult {
+        NO_OFFER,       // Ye request broadcast par nahi - Purana accept flow
+        WON,            // Slot mil gaya
+        FILLED,         // Der ho gayi - Sab slots bhar chuke (ya offer band)
+        NOT_OFFERED,    // Is donor ko offer gaya hi nahi
+        ALREADY_CLAIMED // Isi donor ne pehle hi claim kar liya
+    };
+
+    struct Stats {
+        unsigned long offers;            // Broadcasts khule
+        unsigned long notified;          // Kul donors ko offer gaya
+        unsigned long won;               // Jeete hue claims
+        unsigned long lost;              // Bhare hue offer par claims (contention)
+        unsigned long rejected;          // NOT_OFFERED / ALREADY_CLAIMED
+        unsigned long filled;            // Poore bhare offers
+        unsigned long expired;           // Timeout, koi/poore accept nahi
+        double firstAcceptSumMs;         // Offer se pehle accept tak
+        double firstAcceptMaxMs;
+        unsigned long firstAccepts;
+        Stats() : offers(0), notified(0), won(0), lost(0), rejected(0), filled(0), expired(0),
+                  firstAcceptSumMs(0), firstAcceptMaxMs(0), firstAccepts(0) {}
+        double firstAcceptAvgMs() const { return firstAccepts ? firstAcceptSumMs / firstAccepts : 0.0; }
+    };
+
+    // Timeout par kitne units khaali reh gaye - Caller normal path par daale
+    typedef std::function<void(const std::string& requestId, int unitsOpen)> ExpiryHandler;
+
+private:
+    struct Offer {
+        std::string requestId;
+        CustomVector<std::string> donorIds;
+        std::unique_ptr<std::atomic<bool>[]> claimedBy; // donorIds ke parallel
+        int unitsNeeded;
+        std::atomic<int> remaining;
+        bool closed;                      // expire() ho chuka - lock ke andar
+        std::chrono::steady_clock::time_point openedAt;
+        TimerWheel::TimerId timer;
+        Offer() : unitsNeeded(1), remaining(0), closed(false), timer(TimerWheel::NO_TIMER) {}
+    };
+
+    WebSocketHub* hub;
+    TimerWheel* timers;
+    std::chrono::milliseconds offerTimeout;
+    ExpiryHandler onExpired;
+    CustomHashMap<std::string, std::shared_ptr<Offer>> offers;
+    std::mutex lock;                  // offers map, stats, aur expire/release ka faisla
+    Stats stats;
+
+    std::shared_ptr<Offer> find(const std::string& requestId) {
+        std::lock_guard<std::mutex> guard(lock);
+        std::shared_ptr<Offer> offer;
+        offers.get(requestId, offer);
+        return offer;
+    }
+
+    // Jin donors ne jeeta nahi unko frame - Ek publish
+    void notifyOthers(const std::shared_ptr<Offer>& offer, const std::string& type) {
+        CustomVector<std::string> topics;
+        for (size_t i = 0; i < offer->donorIds.getSize(); ++i) {
+            if (!offer->claimedBy[i].load()) topics.push_back(WebSocketHub::donorTopic(offer->donorIds[i]));
+        }
+        if (topics.empty()) return;
+        hub->publish(topics, "{\"type\":\"" + type + "\",\"requestId\":\"" + offer->requestId + "\"}");
+    }
+
+    // TIMEOUT: Jo slots khaali hain band karo - exchange(0) claims ke saath atomic
+    // Bhara hua offer bhi yahin map se hat'ta hai. Lock ke andar, taake
+    // release() band offer mein slot wapas na daale (woh unit gum ho jata)
+    void expire(const std::string& requestId) {
+        std::shared_ptr<Offer> offer;
+        int open = 0;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (!offers.get(requestId, offer)) return;
+            open = offer->remaining.exchange(0);
+            offer->closed = true;
+            offers.remove(requestId);
+            if (open <= 0) return; // Isi waqt bhar gaya
+            ++stats.expired;
+        }
+        notifyOthers(offer, "withdrawn");
+        if (onExpired) onExpired(requestId, open);
+    }
+
+public:
+    DispatchBoard(WebSocketHub* wsHub, TimerWheel* wheel, std::chrono::milliseconds timeout,
+                  const ExpiryHandler& expiryHandler)
+        : hub(wsHub), timers(wheel), offerTimeout(timeout), onExpired(expiryHandler) {}
+
+    // OPEN: Donors ko offer bhejo (payload = dispatch frame, ek hi dafa bana)
+    // Return = kitne connections tak pahuncha (donor offline ho to 0)
+    size_t open(const std::string& requestId, int unitsNeeded, const CustomVector<std::string>& donorIds,
+                const std::string& payload) {
+        std::shared_ptr<Offer> offer = std::make_shared<Offer>();
+        offer->requestId = requestId;
+        offer->donorIds = donorIds;
+        offer->claimedBy.reset(new std::atomic<bool>[donorIds.getSize() ? donorIds.getSize() : 1]);
+        for (size_t i = 0; i < donorIds.getSize(); ++i) offer->claimedBy[i] = false;
+        offer->unitsNeeded = unitsNeeded > 0 ? unitsNeeded : 1;
+        offer->remaining = offer->unitsNeeded;
+        offer->openedAt = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            offers.insert(requestId, offer);
+            ++stats.offers;
+            stats.notified += donorIds.getSize();
+        }
+        if (timers) {
+            offer->timer = timers->schedule(offerTimeout, [this, requestId] { expire(requestId); });
+        }
+
+        CustomVector<std::string> topics;
+        for (size_t i = 0; i < donorIds.getSize(); ++i) topics.push_back(WebSocketHub::donorTopic(donorIds[i]));
+        return hub->publish(topics, payload);
+    }
+
+    // CLAIM: Donor ne accept kiya - WON sirf pehle unitsNeeded ko
+    // unitsLeft = jeet ke baad kitne slots baaki (0 = request poori)
+    ClaimResult claim(const std::string& requestId, const std::string& donorId, int* unitsLeft = nullptr) {
+        std::shared_ptr<Offer> offer = find(requestId);
+        if (!offer) return NO_OFFER;
+
+        size_t index = offer->donorIds.getSize();
+        for (size_t i = 0; i < offer->donorIds.getSize(); ++i) {
+            if (offer->donorIds[i] == donorId) {
+                index = i;
+                break;
+            }
+        }
+        if (index == offer->donorIds.getSize() || offer->claimedBy[index].exchange(true)) {
+            std::lock_guard<std::mutex> guard(lock);
+            ++stats.rejected;
+            return index == offer->donorIds.getSize() ? NOT_OFFERED : ALREADY_CLAIMED;
+        }
+
+        // Slot lo - Lock-free, bas CAS
+        int left = offer->remaining.load();
+        while (left > 0 && !offer->remaining.compare_exchange_weak(left, left - 1)) {}
+        if (left <= 0) {
+            offer->claimedBy[index] = false; // Haara - "filled" usay bhi mile
+            std::lock_guard<std::mutex> guard(lock);
+            ++stats.lost;
+            return FILLED;
+        }
+
+        if (unitsLeft) *unitsLeft = left - 1;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            ++stats.won;
+            if (left == offer->unitsNeeded) {
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - offer->openedAt).count();
+                ++stats.firstAccepts;
+                stats.firstAcceptSumMs += ms;
+                if (ms > stats.firstAcceptMaxMs) stats.firstAcceptMaxMs = ms;
+            }
+        }
+        if (left == 1) {
+            // Aakhri slot - Baaki ko turant "filled". Offer timeout tak map
+            // mein rehta hai (remaining = 0) taake der se aane wale claims
+            // FILLED paayein, purane accept flow mein na girein
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                ++stats.filled;
+            }
+            notifyOthers(offer, "filled");
+        }
+        return WON;
+    }
+
+    // RELEASE: Jeeta hua slot wapas (e.g. donor asal mein available nahi tha)
+    // Bhare offer par bhi - Slot timeout tak khula, phir expire() fallback karega
+    // Sirf us donor ka jis ne sach mein jeeta tha - Warna remaining unitsNeeded
+    // se upar chala jata. expire() ke saath ek hi lock: Band offer mein slot
+    // wapas nahi aata
+    // False = offer timeout ho chuka (ya donor ka claim tha hi nahi), caller
+    // khud fallback kare
+    bool release(const std::string& requestId, const std::string& donorId) {
+        std::lock_guard<std::mutex> guard(lock);
+        std::shared_ptr<Offer> offer;
+        if (!offers.get(requestId, offer) || offer->closed) return false;
+        size_t index = offer->donorIds.getSize();
+        for (size_t i = 0; i < offer->donorIds.getSize(); ++i) {
+            if (offer->donorIds[i] == donorId) {
+                index = i;
+                break;
+            }
+        }
+        if (index == offer->donorIds.getSize() || !offer->claimedBy[index].exchange(false)) return false;
+        ++offer->remaining;
+        --stats.won;
+        return true;
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> guard(lock);
+        return stats;
+    }
+};
+
+#endif // DISPATCH_BOARD_HPP
@@ -0,0 +1,321 @@
+#ifndef DISTANCE_CACHE_HPP
+#define DISTANCE_CACHE_HPP
+
+#include "../dsa/CustomGraph.hpp"
+#include "../dsa/CustomHashMap.hpp"
+#include "../dsa/CustomVector.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <limits>
+
+// Distance Cache - Ek hi (donor node, hospital node) distance baar baar
+// poocha jata hai. Graph kabhi kabhi hi badalta hai, is liye result yaad
+// rakhte hain. Har entry graph ka epoch saath rakhti hai - addNode/addEdge
+// epoch badha dete hain to purani entries khud hi stale ho jati hain.
+//
+// Teen levels (pehle wala sabse tez):
+// 1. All-pairs matrix - Chhote graph ke liye poora n x n precompute
+// 2. Source vectors  - Hot hospital se har node ka distance (full SSSP)
+// 3. Pair entries    - (source, target) -> distance, bounded FIFO shards
+//
+// Road update (edgeChanged) par source trees incrementally repair hote hain,
+// baaki levels stale ho kar dobara bante hain.
+class DistanceCache {
+public:
+    // Hit-rate metrics - Sab atomic, scrape ke waqt snapshot
+    struct Stats {
+        unsigned long pairHits;
+        unsigned long vectorHits;
+        unsigned long matrixHits;
+        unsigned long misses;
+        unsigned long staleEntries;   // Entry mili par epoch purana tha
+        unsigned long promotions;     // Kitne hospitals ka full vector bana
+        unsigned long repairs;        // Edge change par kitne trees repair hue
+        unsigned long repairedLabels; // Repair mein kitne distances dobara likhe
+
+        Stats() : pairHits(0), vectorHits(0), matrixHits(0), misses(0), staleEntries(0), promotions(0),
+                  repairs(0), repairedLabels(0) {}
+
+        unsigned long lookups() const { return pairHits + vectorHits + matrixHits + misses; }
+        double hitRate() const {
+            unsigned long total = lookups();
+            return total == 0 ? 0.0 : static_cast<double>(total - misses) / total;
+        }
+    };
+
+private:
+    static const size_t SHARD_COUNT = 16;
+
+    struct PairEntry {
+        double distance;
+        unsigned long epoch;
+        PairEntry() : distance(0.0), epoch(0) {}
+        PairEntry(double d, unsigned long e) : distance(d), epoch(e) {}
+    };
+
+    // Ek shard - Apna lock, apna map, apna FIFO eviction ring
+    struct Shard {
+        std::mutex lock;
+        CustomHashMap<std::string, PairEntry> entries;
+        CustomVector<std::string> ring;  // Insertion order - Purana pehle nikle
+        size_t nextVictim;
+        Shard() : nextVictim(0) {}
+    };
+
+    // Full shortest path tree ek source se (index = graph node index)
+    // Parent bhi rakhte hain taaki edge change par incremental repair ho sake
+    // Apna lock - Road update tree ko isi ke andar in-place repair karta
+    // hai (copy nahi), readers ek label padhne tak hi lock pakadte hain
+    struct SourceVector {
+        std::mutex lock;
+        unsigned long epoch;
+        CustomVector<double> dist;
+        CustomVector<int> parent;
+    };
+
+    // All-pairs matrix - dist[i * n + j]
+    struct Matrix {
+        unsigned long epoch;
+        size_t n;
+        CustomVector<double> dist;
+    };
+
+    const CustomGraph* graph;
+    size_t shardCapacity;            // Har shard mein max pair entries
+    size_t maxSourceVectors;         // Kitne hot hospitals ka vector rakhein
+    int promoteAfterMisses;          // Itne misses ke baad source "hot" hai
+
+    Shard shards[SHARD_COUNT];
+
+    std::mutex sourceLock;
+    CustomHashMap<std::string, std::shared_ptr<SourceVector>> sourceVectors;
+    CustomVector<std::string> sourceRing;
+    size_t nextSourceVictim;
+    CustomHashMap<std::string, int> sourceMisses;
+
+    std::shared_ptr<const Matrix> matrix; // std::atomic_load/store se access
+
+    std::atomic<unsigned long> pairHits{0};
+    std::atomic<unsigned long> vectorHits{0};
+    std::atomic<unsigned long> matrixHits{0};
+    std::atomic<unsigned long> misses{0};
+    std::atomic<unsigned long> staleEntries{0};
+    std::atomic<unsigned long> promotions{0};
+    std::atomic<unsigned long> repairs{0};
+    std::atomic<unsigned long> repairedLabels{0};
+
+    // Graph undirected hai - (a, b) aur (b, a) ek hi entry
+    static std::string pairKey(const std::string& a, const std::string& b) {
+        return a < b ? a + "|" + b : b + "|" + a;
+    }
+
+    Shard& shardFor(const std::string& key) {
+        return shards[std::hash<std::string>{}(key) % SHARD_COUNT];
+    }
+
+    // Pair entry store karo - Shard full ho to sabse purani nikal do
+    void storePair(const std::string& key, double distance, unsigned long epoch) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        if (shard.entries.contains(key)) {
+            shard.entries.insert(key, PairEntry(distance, epoch)); // Update in place
+            return;
+        }
+        if (shard.ring.getSize() < shardCapacity) {
+            shard.ring.push_back(key);
+        } else {
+            shard.entries.remove(shard.ring[shard.nextVictim]);
+            shard.ring[shard.nextVictim] = key;
+            shard.nextVictim = (shard.nextVictim + 1) % shardCapacity;
+        }
+        shard.entries.insert(key, PairEntry(distance, epoch));
+    }
+
+    // Hot source ke vector se source -> other ka distance. False agar
+    // vector nahi, stale hai, ya other us se naya node hai
+    bool readSourceVector(const std::string& source, const std::string& other, unsigned long epoch, double& out) {
+        std::shared_ptr<SourceVector> vec;
+        {
+            std::lock_guard<std::mutex> guard(sourceLock);
+            if (!sourceVectors.get(source, vec)) return false;
+        }
+        int idx = graph->getNodeIndex(other);
+        std::lock_guard<std::mutex> guard(vec->lock);
+        if (vec->epoch != epoch || idx < 0 || static_cast<size_t>(idx) >= vec->dist.getSize()) return false;
+        out = vec->dist[idx];
+        return true;
+    }
+
+    // Target ne kaafi misses kar liye? To uska poora vector bana do
+    void notePossibleHotSource(const std::string& nodeId, unsigned long epoch) {
+        {
+            std::lock_guard<std::mutex> guard(sourceLock);
+            int count = 0;
+            sourceMisses.get(nodeId, count);
+            if (++count < promoteAfterMisses) {
+                sourceMisses.insert(nodeId, count);
+                return;
+            }
+            sourceMisses.remove(nodeId);
+        }
+
+        // Lock ke bahar compute - Full SSSP mehnga hai
+        std::shared_ptr<SourceVector> vec = std::make_shared<SourceVector>();
+        vec->epoch = epoch;
+        graph->shortestPathTree(nodeId, vec->dist, vec->parent);
+
+        std::lock_guard<std::mutex> guard(sourceLock);
+        if (!sourceVectors.contains(nodeId)) {
+            if (sourceRing.getSize() < maxSourceVectors) {
+                sourceRing.push_back(nodeId);
+            } else {
+                sourceVectors.remove(sourceRing[nextSourceVictim]);
+                sourceRing[nextSourceVictim] = nodeId;
+                nextSourceVictim = (nextSourceVictim + 1) % maxSourceVectors;
+            }
+        }
+        sourceVectors.insert(nodeId, vec);
+        ++promotions;
+    }
+
+public:
+    DistanceCache(const CustomGraph* g, size_t capacity = 65536, size_t hotSources = 8, int promoteAfter = 16)
+        : graph(g), shardCapacity(capacity / SHARD_COUNT > 0 ? capacity / SHARD_COUNT : 1),
+          maxSourceVectors(hotSources > 0 ? hotSources : 1), promoteAfterMisses(promoteAfter),
+          nextSourceVictim(0) {}
+
+    // DISTANCE: from -> to ka shortest distance, cache se ya compute karke
+    // "to" ko hospital side samjha jata hai - Wahi hot source banta hai
+    double distance(const std::string& from, const std::string& to) {
+        unsigned long epoch = graph->getEpoch();
+
+        // Level 1: All-pairs matrix
+        std::shared_ptr<const Matrix> m = std::atomic_load(&matrix);
+        if (m && m->epoch == epoch) {
+            int i = graph->getNodeIndex(from);
+            int j = graph->getNodeIndex(to);
+            if (i >= 0 && j >= 0) {
+                ++matrixHits;
+                return m->dist[static_cast<size_t>(i) * m->n + j];
+            }
+        }
+
+        // Level 2: Hot hospital ka full vector (undirected - koi bhi side)
+        double fromVector;
+        if (readSourceVector(to, from, epoch, fromVector) || readSourceVector(from, to, epoch, fromVector)) {
+            ++vectorHits;
+            return fromVector;
+        }
+
+        // Level 3: Pair entry
+        std::string key = pairKey(from, to);
+        {
+            Shard& shard = shardFor(key);
+            std::lock_guard<std::mutex> guard(shard.lock);
+            PairEntry entry;
+            if (shard.entries.get(key, entry)) {
+                if (entry.epoch == epoch) {
+                    ++pairHits;
+                    return entry.distance;
+                }
+                ++staleEntries;
+            }
+        }
+
+        // Miss - Compute karke store
+        ++misses;
+        double d = graph->bidirectionalDijkstra(from, to).distance;
+        storePair(key, d, epoch);
+        notePossibleHotSource(to, epoch);
+        return d;
+    }
+
+    // REMEMBER: Kisi aur search (e.g. frontier expansion) ne distance nikal
+    // liya hai to cache mein daal do - Muft ka entry
+    void remember(const std::string& from, const std::string& to, double distance) {
+        storePair(pairKey(from, to), distance, graph->getEpoch());
+    }
+
+    // ALL-PAIRS MODE: Chhote graph ke liye poora matrix precompute
+    // n SSSP runs - n^2 memory, is liye sirf maxNodes tak allow
+    // Return false agar graph bahut bada hai
+    bool buildAllPairs(size_t maxNodes = 1024) {
+        size_t n = graph->getNodeCount();
+        if (n == 0 || n > maxNodes) {
+            return false;
+        }
+
+        std::shared_ptr<Matrix> m = std::make_shared<Matrix>();
+        m->epoch = graph->getEpoch();
+        m->n = n;
+        m->dist = CustomVector<double>(n * n);
+        CustomVector<std::string> ids = graph->getNodeIds();
+        for (size_t i = 0; i < n; ++i) {
+            CustomVector<double> row = graph->distancesFrom(ids[i]);
+            for (size_t j = 0; j < n; ++j) {
+                m->dist.push_back(row[j]);
+            }
+        }
+        std::atomic_store(&matrix, std::shared_ptr<const Matrix>(m));
+        return true;
+    }
+
+    // EDGE CHANGED: Graph mein (from, to) ka weight abhi badla hai (ek hi
+    // change, epoch ek badha). Hot hospitals ke cached trees ko poora
+    // dobara compute karne ke bajaye incrementally repair karte hain -
+    // Sirf affected subtree, tree ke apne lock ke andar in-place (O(n)
+    // copy nahi). Repair ke dauran us source ke readers ruk jate hain,
+    // baaki sources aur levels chalte rehte hain.
+    // Graph writes aur ye call ek hi writer se serialize hone chahiye.
+    // Pair entries stale ho jati hain (miss par dobara), chhota all-pairs
+    // matrix poora rebuild hota hai.
+    void edgeChanged(const std::string& from, const std::string& to, double oldWeight, double newWeight) {
+        unsigned long epoch = graph->getEpoch();
+
+        CustomVector<std::shared_ptr<SourceVector>> hot;
+        {
+            std::lock_guard<std::mutex> guard(sourceLock);
+            for (size_t i = 0; i < sourceRing.getSize(); ++i) {
+                std::shared_ptr<SourceVector> vec;
+                if (sourceVectors.get(sourceRing[i], vec)) hot.push_back(vec);
+            }
+        }
+
+        for (size_t i = 0; i < hot.getSize(); ++i) {
+            std::lock_guard<std::mutex> guard(hot[i]->lock);
+            if (hot[i]->epoch + 1 != epoch) continue; // Pehle se stale - Agli promotion naya banayegi
+            repairedLabels += graph->repairAfterEdgeChange(from, to, oldWeight, newWeight,
+                                                           hot[i]->dist, hot[i]->parent);
+            hot[i]->epoch = epoch;
+            ++repairs;
+        }
+
+        std::shared_ptr<const Matrix> m = std::atomic_load(&matrix);
+        if (m && m->epoch + 1 == epoch) {
+            buildAllPairs(m->n);
+        }
+    }
+
+    // All-pairs matrix abhi valid hai? (graph badla to nahi)
+    bool hasValidMatrix() const {
+        std::shared_ptr<const Matrix> m = std::atomic_load(&matrix);
+        return m && m->epoch == graph->getEpoch();
+    }
+
+    Stats getStats() const {
+        Stats s;
+        s.pairHits = pairHits.load();
+        s.vectorHits = vectorHits.load();
+        s.matrixHits = matrixHits.load();
+        s.misses = misses.load();
+        s.staleEntries = staleEntries.load();
+        s.promotions = promotions.load();
+        s.repairs = repairs.load();
+        s.repairedLabels = repairedLabels.load();
+        return s;
+    }
+};
+
+#endif // DISTANCE_CACHE_HPP
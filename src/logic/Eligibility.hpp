@@ -0,0 +1,134 @@
+#ifndef ELIGIBILITY_HPP
+#define ELIGIBILITY_HPP
+
+#include "../dsa/CustomPriorityQueue.hpp"
+#include "../dsa/CustomVector.hpp"
+#include "../models/Models.hpp"
+#include <cstdio>
+#include <ctime>
+#include <sstream>
+#include <string>
+#include <utility>
+
+// Epoch Days - "YYYY-MM-DD" strings ko ek dafa integer days (1970-01-01
+// se) mein badalte hain. Compare/add sirf integer math - Har match par
+// string parse nahi
+class EpochDays {
+public:
+    static const int NONE = -1; // Date nahi di - Koi restriction nahi
+
+    // Civil date -> days since 1970-01-01 (proleptic Gregorian)
+    static int fromCivil(int year, int month, int day) {
+        year -= month <= 2;
+        int era = (year >= 0 ? year : year - 399) / 400;
+        int yearOfEra = year - era * 400;
+        int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    // "2024-12-15" -> epoch day. Ghalat/khali string = NONE
+    static int parse(const std::string& date) {
+        int year, month, day;
+        char dash1, dash2;
+        std::istringstream in(date);
+        if (!(in >> year >> dash1 >> month >> dash2 >> day) || dash1 != '-' || dash2 != '-') {
+            return NONE;
+        }
+        if (month < 1 || month > 12 || day < 1 || day > 31) return NONE;
+        return fromCivil(year, month, day);
+    }
+
+    // Epoch day -> "YYYY-MM-DD" (CSV mein wapas likhne ke liye)
+    static std::string format(int days) {
+        if (days == NONE) return "";
+        days += 719468;
+        int era = (days >= 0 ? days : days - 146096) / 146097;
+        int dayOfEra = days - era * 146097;
+        int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        int mp = (5 * dayOfYear + 2) / 153;
+        int day = dayOfYear - (153 * mp + 2) / 5 + 1;
+        int month = mp + (mp < 10 ? 3 : -9);
+        int year = yearOfEra + era * 400 + (month <= 2);
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%04d-%02d-%02d", year, month, day);
+        return std::string(buf);
+    }
+
+    // Aaj ka epoch day - Pakistan time (UTC+5), din raat 12 baje badalta hai
+    static int today() {
+        return static_cast<int>((time(0) + 5 * 3600) / 86400);
+    }
+
+    // Us din ke shuru (PKT raat 12 baje) tak kitne seconds - Guzar chuka to 0
+    static long long secondsUntil(int day) {
+        long long remaining = static_cast<long long>(day) * 86400 - (static_cast<long long>(time(0)) + 5 * 3600);
+        return remaining > 0 ? remaining : 0;
+    }
+};
+
+// Reactivation Index - Jo donors abhi donate nahi kar sakte (pichli
+// donation ke baad ka waqfa), woh available index se bahar is min-heap
+// mein rehte hain, eligibility day ke hisaab se. Din guzarte hi top se
+// nikal kar wapas index mein - Poori donor list kabhi scan nahi hoti.
+// popDue: O(k log n), k = jitne aaj eligible hue
+class ReactivationIndex {
+private:
+    typedef std::pair<int, Donor*> Entry; // (nextEligibleDay, donor)
+
+    struct EarliestFirst {
+        bool operator()(const Entry& a, const Entry& b) const {
+            return a.first < b.first;
+        }
+    };
+
+    CustomPriorityQueue<Entry, EarliestFirst> heap;
+
+public:
+    // Donor ko heap mein daalo - Uska nextEligibleDay key hai
+    void push(Donor* donor) {
+        heap.push(Entry(donor->nextEligibleDay, donor));
+    }
+
+    // Jin ka din aa gaya (day <= today) woh out mein. Purani entries
+    // (donor ne dobara donate kiya, nayi date) skip - Nayi entry baad mein aayegi
+    void popDue(int today, CustomVector<Donor*>& out) {
+        while (!heap.empty() && heap.top().first <= today) {
+            Entry top = heap.top();
+            heap.pop();
+            if (top.second->nextEligibleDay != top.first) continue; // Stale
+            out.push_back(top.second);
+        }
+    }
+
+    // Donor (system se) hata diya - Uski entries heap se nikalo, warna
+    // popDue usay wapas index kar deta. O(n log n) rebuild, sirf admin
+    // removal ke liye (roz ka kaam nahi). Return = koi entry mili
+    bool remove(const std::string& donorId) {
+        CustomVector<Entry> kept;
+        bool found = false;
+        while (!heap.empty()) {
+            Entry top = heap.top();
+            heap.pop();
+            if (top.second->id == donorId) {
+                found = true;
+            } else {
+                kept.push_back(top);
+            }
+        }
+        for (size_t i = 0; i < kept.getSize(); ++i) heap.push(kept[i]);
+        return found;
+    }
+
+    // Agla reactivation kab - NONE agar heap khali
+    int nextDay() const {
+        return heap.empty() ? EpochDays::NONE : heap.top().first;
+    }
+
+    size_t size() const {
+        return heap.size();
+    }
+};
+
+#endif // ELIGIBILITY_HPP
@@ -0,0 +1,262 @@
+#ifndef HTTP_GATEWAY_HPP
+#define HTTP_GATEWAY_HPP
+
+#ifndef ASIO_STANDALONE
+#define ASIO_STANDALONE
+#endif
+#include <asio.hpp>
+#include "../dsa/CustomVector.hpp"
+#include "NotificationOutbox.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+// Http Gateway - Outbox ki batch ek HTTP POST mein (SMS/push provider ka
+// batch endpoint, ya testing ke liye server ka apna stub):
+//
+//   POST /path  {"messages":[{"id":7,"to":"0300...","channel":"sms","kind":"match","text":"..."}]}
+//   200         {"failed":[7]}      - Jo ids list mein nahi woh delivered
+//   5xx / band connection           - Poori batch fail (outbox retry karega)
+//
+// Keep-alive connections ka chhota pool - Har worker thread apna socket
+// le leta hai, har batch par naya TCP handshake nahi. Har call (resolve,
+// connect, write, read) ek deadline ke andar, taake latka hua gateway
+// worker ko hamesha ke liye na rok de. asio ke sync calls (aur socket par
+// SO_RCVTIMEO) yeh nahi karte - Woh poll(-1) par ruk jate hain. Is liye
+// async op aur connection ka apna io_context, run_until(deadline) tak
+class HttpGateway {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    // Har connection ka apna io_context - Ek waqt mein ek hi worker use
+    // karta hai, is liye workers ek doosre ke handlers nahi chalate
+    struct Connection {
+        asio::io_context io;
+        asio::ip::tcp::socket socket;
+        Connection() : socket(io) {}
+    };
+
+    std::string host;
+    std::string port;
+    std::string path;
+    int timeoutMs;
+
+    std::mutex poolLock;
+    CustomVector<Connection*> idle;
+
+    // Shuru kiya hua async op deadline tak chalao. Der ho gayi to abort()
+    // (socket band / resolve cancel) - Op operation_aborted se khatam, false
+    template<typename Abort>
+    static bool await(Connection& conn, const bool& done, Clock::time_point deadline, Abort abort) {
+        conn.io.restart();
+        conn.io.run_until(deadline);
+        if (done) return true;
+        abort();
+        conn.io.restart();
+        conn.io.run(); // Aborted handler chal jaye - Woh hamare locals par likhta hai
+        return false;
+    }
+
+    Connection* acquire(Clock::time_point deadline) {
+        {
+            std::lock_guard<std::mutex> guard(poolLock);
+            if (!idle.empty()) {
+                Connection* conn = idle[idle.getSize() - 1];
+                idle.pop_back();
+                return conn;
+            }
+        }
+        Connection* conn = new Connection();
+        asio::ip::tcp::resolver resolver(conn->io);
+        asio::ip::tcp::resolver::results_type endpoints;
+        asio::error_code error;
+        bool done = false;
+        resolver.async_resolve(host, port, [&](const asio::error_code& e, asio::ip::tcp::resolver::results_type results) {
+            error = e;
+            endpoints = results;
+            done = true;
+        });
+        if (!await(*conn, done, deadline, [&resolver] { resolver.cancel(); }) || error) {
+            delete conn;
+            return nullptr;
+        }
+
+        done = false;
+        asio::async_connect(conn->socket, endpoints, [&](const asio::error_code& e, const asio::ip::tcp::endpoint&) {
+            error = e;
+            done = true;
+        });
+        if (!await(*conn, done, deadline, [conn] { closeSocket(*conn); }) || error) {
+            releaseConnection(conn, false);
+            return nullptr;
+        }
+        conn->socket.set_option(asio::ip::tcp::no_delay(true), error);
+        return conn;
+    }
+
+    static void closeSocket(Connection& conn) {
+        asio::error_code ignored;
+        conn.socket.close(ignored);
+    }
+
+    void releaseConnection(Connection* conn, bool reusable) {
+        if (reusable) {
+            std::lock_guard<std::mutex> guard(poolLock);
+            idle.push_back(conn);
+            return;
+        }
+        closeSocket(*conn);
+        delete conn;
+    }
+
+    static void appendString(std::string& out, const std::string& value) {
+        out += '"';
+        for (size_t i = 0; i < value.size(); ++i) {
+            char c = value[i];
+            if (c == '"' || c == '\\') out += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) out += c;
+        }
+        out += '"';
+    }
+
+    static std::string batchBody(const CustomVector<Notification*>& batch) {
+        std::string body = "{\"messages\":[";
+        for (size_t i = 0; i < batch.getSize(); ++i) {
+            const Notification* n = batch[i];
+            if (i) body += ',';
+            body += "{\"id\":" + std::to_string(n->id) + ",\"to\":";
+            appendString(body, n->to);
+            body += ",\"channel\":";
+            appendString(body, n->channel);
+            body += ",\"kind\":";
+            appendString(body, n->kind);
+            body += ",\"text\":";
+            appendString(body, n->text);
+            body += '}';
+        }
+        body += "]}";
+        return body;
+    }
+
+    // {"failed":[3,9]} se ids - Baaki sab delivered
+    static void markDelivered(const std::string& body, const CustomVector<Notification*>& batch,
+                              CustomVector<bool>& delivered) {
+        for (size_t i = 0; i < delivered.getSize(); ++i) delivered[i] = true;
+        size_t start = body.find("\"failed\"");
+        if (start == std::string::npos) return;
+        start = body.find('[', start);
+        size_t end = start == std::string::npos ? std::string::npos : body.find(']', start);
+        if (end == std::string::npos) return;
+        std::string list = body.substr(start + 1, end - start - 1);
+        const char* p = list.c_str();
+        while (*p) {
+            char* next = nullptr;
+            unsigned long id = std::strtoul(p, &next, 10);
+            if (next == p) {
+                ++p;
+                continue;
+            }
+            for (size_t i = 0; i < batch.getSize(); ++i) {
+                if (batch[i]->id == id) delivered[i] = false;
+            }
+            p = next;
+        }
+    }
+
+    // Ek request/response deadline ke andar - False = connection kharab ya
+    // gateway ne der kar di (batch fail, socket band)
+    bool exchange(Connection& conn, const std::string& request, Clock::time_point deadline, int& status,
+                  std::string& body, bool& keepAlive) {
+        asio::error_code error;
+        bool done = false;
+        size_t transferred = 0;
+        std::function<void()> abort = [&conn] { closeSocket(conn); };
+        auto completed = [&](const asio::error_code& e, size_t bytes) {
+            error = e;
+            transferred = bytes;
+            done = true;
+        };
+
+        asio::async_write(conn.socket, asio::buffer(request), completed);
+        if (!await(conn, done, deadline, abort) || error) return false;
+
+        asio::streambuf buffer;
+        done = false;
+        asio::async_read_until(conn.socket, buffer, "\r\n\r\n", completed);
+        if (!await(conn, done, deadline, abort) || error) return false;
+        size_t headerBytes = transferred;
+        std::string data(asio::buffers_begin(buffer.data()), asio::buffers_end(buffer.data()));
+        std::string headers = data.substr(0, headerBytes);
+        body = data.substr(headerBytes);
+
+        status = 0;
+        size_t space = headers.find(' ');
+        if (space != std::string::npos) status = std::atoi(headers.c_str() + space + 1);
+        std::string lower = headers;
+        for (size_t i = 0; i < lower.size(); ++i) lower[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(lower[i])));
+        keepAlive = lower.find("connection: close") == std::string::npos;
+        size_t lengthAt = lower.find("content-length:");
+        if (lengthAt == std::string::npos) return false; // Chunked - Stub/provider content-length bhejte hain
+        size_t length = std::strtoul(lower.c_str() + lengthAt + 15, nullptr, 10);
+        if (body.size() < length) {
+            std::string rest(length - body.size(), '\0');
+            done = false;
+            asio::async_read(conn.socket, asio::buffer(&rest[0], rest.size()), completed);
+            if (!await(conn, done, deadline, abort) || error) return false;
+            body += rest;
+        }
+        return true;
+    }
+
+public:
+    // url = "http://host:port/path" (https nahi - Provider ke saamne TLS proxy)
+    explicit HttpGateway(const std::string& url, int timeoutMillis = 5000) : timeoutMs(timeoutMillis) {
+        std::string rest = url.compare(0, 7, "http://") == 0 ? url.substr(7) : url;
+        size_t slash = rest.find('/');
+        std::string authority = rest.substr(0, slash);
+        path = slash == std::string::npos ? "/" : rest.substr(slash);
+        size_t colon = authority.find(':');
+        host = authority.substr(0, colon);
+        port = colon == std::string::npos ? "80" : authority.substr(colon + 1);
+    }
+
+    ~HttpGateway() {
+        for (size_t i = 0; i < idle.getSize(); ++i) releaseConnection(idle[i], false);
+    }
+
+    // Outbox::Gateway - Ek batch, ek POST
+    void send(const CustomVector<Notification*>& batch, CustomVector<bool>& delivered) {
+        std::string body = batchBody(batch);
+        std::ostringstream request;
+        request << "POST " << path << " HTTP/1.1\r\nHost: " << host << "\r\nContent-Type: application/json\r\n"
+                << "Content-Length: " << body.size() << "\r\nConnection: keep-alive\r\n\r\n" << body;
+        std::string raw = request.str();
+
+        // Poori batch ka ek deadline (retry bhi isi ke andar)
+        Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+        // Pool wala socket server ne band kar diya ho sakta hai - Ek dafa naye se
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            Connection* conn = acquire(deadline);
+            if (!conn) return;
+            int status = 0;
+            bool keepAlive = false;
+            std::string response;
+            bool ok = exchange(*conn, raw, deadline, status, response, keepAlive);
+            releaseConnection(conn, ok && keepAlive);
+            if (!ok) continue;
+            if (status >= 200 && status < 300) markDelivered(response, batch, delivered);
+            return;
+        }
+    }
+
+    NotificationOutbox::Gateway asGateway() {
+        return [this](const CustomVector<Notification*>& batch, CustomVector<bool>& delivered) {
+            send(batch, delivered);
+        };
+    }
+};
+
+#endif // HTTP_GATEWAY_HPP
@@ -0,0 +1,463 @@
+#ifndef JSON_CODEC_HPP
+#define JSON_CODEC_HPP
+
+#include "../models/Models.hpp"
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// ==================== JSON CODEC BASICS ====================
+// crow::json::wvalue har key ke liye map node banata hai, aur load() ke
+// baad har body["x"].s() ek string copy. Hot handlers (register, request,
+// dashboard) ke liye:
+//
+//   FIELD LIST (compile time) - Har struct ke liye ek schema:
+//     { "name" -> &Donor::name, "age" -> &Donor::age, ... }
+//   Isi list se templates seedha serializer aur parser bana dete hain -
+//   Koi runtime map/tree nahi
+//
+//   WRITER - Ek thread ka apna buffer (capacity reuse), numbers
+//   std::to_chars se, field names pehle se pata
+//   PARSER - Body ek dafa scan, key mili to seedha struct ke member mein
+//   (string unescape bhi wahin). Schema mein nahi to value skip
+//
+// Struct ke members jo parse se pehle set hain (e.g. locationNodeId = "D1")
+// woh default - Body mein na hon to waise hi rehte hain
+// ===========================================================
+
+// Ek field - JSON naam aur member pointer
+template<typename T, typename M>
+struct JsonField {
+    std::string_view name;
+    M T::* member;
+};
+
+template<typename T, typename M>
+constexpr JsonField<T, M> jsonField(std::string_view name, M T::* member) {
+    return JsonField<T, M>{name, member};
+}
+
+// ==================== SCHEMAS ====================
+
+// Donor registration form (password -> passwordHash)
+struct DonorRegistrationJson {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("name", &Donor::name), jsonField("cnic", &Donor::cnic), jsonField("age", &Donor::age),
+        jsonField("gender", &Donor::gender), jsonField("email", &Donor::email), jsonField("phone", &Donor::phone),
+        jsonField("address", &Donor::address), jsonField("bloodGroup", &Donor::bloodGroup),
+        jsonField("city", &Donor::city), jsonField("area", &Donor::area),
+        jsonField("locationNodeId", &Donor::locationNodeId), jsonField("password", &Donor::passwordHash),
+        jsonField("lastDonationDate", &Donor::lastDonationDate));
+};
+
+// Dashboard response (eligible alag se - Member nahi, hisaab hai)
+struct DonorDashboardJson {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("id", &Donor::id), jsonField("name", &Donor::name), jsonField("bloodGroup", &Donor::bloodGroup),
+        jsonField("status", &Donor::status), jsonField("totalDonations", &Donor::totalDonations),
+        jsonField("badgeLevel", &Donor::badgeLevel), jsonField("city", &Donor::city), jsonField("area", &Donor::area),
+        jsonField("lastDonationDate", &Donor::lastDonationDate),
+        jsonField("nextEligibleDate", &Donor::nextEligibleDate));
+};
+
+// Recipient registration aur blood request form
+struct RecipientFormJson {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("patientName", &Recipient::patientName), jsonField("age", &Recipient::age),
+        jsonField("bloodGroupNeeded", &Recipient::bloodGroupNeeded), jsonField("urgency", &Recipient::urgency),
+        jsonField("hospitalName", &Recipient::hospitalName), jsonField("locationNodeId", &Recipient::locationNodeId),
+        jsonField("contactPerson", &Recipient::contactPerson), jsonField("contactPhone", &Recipient::contactPhone),
+        jsonField("unitsNeeded", &Recipient::unitsNeeded));
+};
+
+struct TransactionJson {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("id", &Transaction::id), jsonField("donorId", &Transaction::donorId),
+        jsonField("recipientId", &Transaction::recipientId), jsonField("bloodGroup", &Transaction::bloodGroup),
+        jsonField("units", &Transaction::units), jsonField("hospitalId", &Transaction::hospitalId),
+        jsonField("distance", &Transaction::distance), jsonField("matchTime", &Transaction::matchTime),
+        jsonField("travelTime", &Transaction::travelTime), jsonField("status", &Transaction::status),
+        jsonField("timestamp", &Transaction::timestamp));
+};
+
+// ==================== WRITER ====================
+class JsonWriter {
+private:
+    std::string& out;
+    bool needComma[32];     // Har nesting level par - Pehle se koi value likhi?
+    int depth;
+    bool afterKey;          // Key likh di, ab uski value (comma nahi)
+
+    void separate() {
+        if (afterKey) {
+            afterKey = false;
+            return;
+        }
+        if (depth > 0 && needComma[depth]) out += ',';
+        needComma[depth] = true;
+    }
+
+    void appendEscaped(const char* s, size_t n) {
+        out += '"';
+        size_t start = 0;
+        for (size_t i = 0; i < n; ++i) {
+            unsigned char c = static_cast<unsigned char>(s[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+            out.append(s + start, i - start);
+            start = i + 1;
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default: {
+                    static const char hex[] = "0123456789abcdef";
+                    char esc[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 15]};
+                    out.append(esc, 6);
+                }
+            }
+        }
+        out.append(s + start, n - start);
+        out += '"';
+    }
+
+    template<typename N>
+    void appendNumber(N n) {
+        char digits[32];
+        std::to_chars_result r = std::to_chars(digits, digits + sizeof(digits), n);
+        out.append(digits, r.ptr - digits);
+    }
+
+    template<size_t I, typename Tuple, typename T>
+    void writeFields(const Tuple& fields, const T& obj) {
+        if constexpr (I < std::tuple_size<Tuple>::value) {
+            field(std::get<I>(fields).name, obj.*(std::get<I>(fields).member));
+            writeFields<I + 1>(fields, obj);
+        }
+    }
+
+public:
+    // buffer khaali karke shuru (capacity wahi rehti hai)
+    explicit JsonWriter(std::string& buffer) : out(buffer), depth(0), afterKey(false) {
+        out.clear();
+        needComma[0] = false;
+    }
+
+    // Is thread ka reusable buffer - Har response par nayi allocation nahi
+    static std::string& threadBuffer() {
+        thread_local std::string buffer;
+        return buffer;
+    }
+
+    void beginObject() {
+        separate();
+        out += '{';
+        needComma[++depth] = false;
+    }
+    void endObject() {
+        out += '}';
+        --depth;
+    }
+    void beginArray() {
+        separate();
+        out += '[';
+        needComma[++depth] = false;
+    }
+    void endArray() {
+        out += ']';
+        --depth;
+    }
+
+    void key(std::string_view name) {
+        separate();
+        appendEscaped(name.data(), name.size());
+        out += ':';
+        afterKey = true;
+    }
+
+    void value(const std::string& s) {
+        separate();
+        appendEscaped(s.data(), s.size());
+    }
+    void value(const char* s) {
+        separate();
+        appendEscaped(s, std::strlen(s));
+    }
+    void value(bool b) {
+        separate();
+        out += b ? "true" : "false";
+    }
+    void value(double d) {
+        separate();
+        appendNumber(d);
+    }
+    template<typename N>
+    typename std::enable_if<std::is_integral<N>::value && !std::is_same<N, bool>::value>::type value(N n) {
+        separate();
+        appendNumber(n);
+    }
+
+    template<typename V>
+    void field(std::string_view name, const V& v) {
+        key(name);
+        value(v);
+    }
+
+    // Schema ke sab fields (object ke andar)
+    template<typename Schema, typename T>
+    void fields(const T& obj) {
+        writeFields<0>(Schema::fields, obj);
+    }
+
+    const std::string& str() const { return out; }
+};
+
+// ==================== PARSER ====================
+class JsonReader {
+private:
+    const char* p;
+    const char* end;
+
+    void skipSpace() {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) ++p;
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (p >= end || *p != c) return false;
+        ++p;
+        return true;
+    }
+
+    static int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    static void appendUtf8(std::string& out, unsigned cp) {
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    bool readHex4(unsigned& cp) {
+        if (end - p < 4) return false;
+        cp = 0;
+        for (int i = 0; i < 4; ++i) {
+            int h = hexValue(p[i]);
+            if (h < 0) return false;
+            cp = cp * 16 + static_cast<unsigned>(h);
+        }
+        p += 4;
+        return true;
+    }
+
+    // "..." -> out (escapes khol kar)
+    bool readString(std::string& out) {
+        if (!consume('"')) return false;
+        out.clear();
+        const char* start = p;
+        while (p < end && *p != '"') {
+            if (*p != '\\') {
+                ++p;
+                continue;
+            }
+            out.append(start, p - start);
+            if (++p >= end) return false;
+            char c = *p++;
+            switch (c) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    unsigned cp;
+                    if (!readHex4(cp)) return false;
+                    // Surrogate pair (emoji waghera)
+                    if (cp >= 0xD800 && cp < 0xDC00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                        p += 2;
+                        unsigned low;
+                        if (!readHex4(low)) return false;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, cp);
+                    break;
+                }
+                default: return false;
+            }
+            start = p;
+        }
+        if (p >= end) return false;
+        out.append(start, p - start);
+        ++p;
+        return true;
+    }
+
+    // Key - Escape na ho to body ke andar hi view (copy nahi)
+    bool readKey(std::string_view& key, std::string& scratch) {
+        skipSpace();
+        if (p >= end || *p != '"') return false;
+        const char* start = p + 1;
+        const char* q = start;
+        while (q < end && *q != '"' && *q != '\\') ++q;
+        if (q < end && *q == '"') {
+            key = std::string_view(start, q - start);
+            p = q + 1;
+            return true;
+        }
+        if (!readString(scratch)) return false;
+        key = scratch;
+        return true;
+    }
+
+    bool readLiteral(const char* word) {
+        size_t n = std::strlen(word);
+        if (static_cast<size_t>(end - p) < n || std::memcmp(p, word, n) != 0) return false;
+        p += n;
+        return true;
+    }
+
+    bool isNull() {
+        skipSpace();
+        return end - p >= 4 && std::memcmp(p, "null", 4) == 0;
+    }
+
+    bool readValue(std::string& out) {
+        return readString(out);
+    }
+
+    bool readValue(bool& out) {
+        skipSpace();
+        if (readLiteral("true")) {
+            out = true;
+            return true;
+        }
+        if (readLiteral("false")) {
+            out = false;
+            return true;
+        }
+        return false;
+    }
+
+    bool readValue(double& out) {
+        skipSpace();
+        if (p < end && *p == '+') return false;
+        std::from_chars_result r = std::from_chars(p, end, out);
+        if (r.ec != std::errc()) return false;
+        p = r.ptr;
+        return true;
+    }
+
+    // Integer field - "30" ya "30.0" dono (crow ka i() bhi dono leta tha)
+    template<typename N>
+    typename std::enable_if<std::is_integral<N>::value && !std::is_same<N, bool>::value, bool>::type
+    readValue(N& out) {
+        skipSpace();
+        const char* start = p;
+        std::from_chars_result r = std::from_chars(p, end, out);
+        if (r.ec == std::errc() && (r.ptr == end || (*r.ptr != '.' && *r.ptr != 'e' && *r.ptr != 'E'))) {
+            p = r.ptr;
+            return true;
+        }
+        p = start;
+        double d;
+        if (!readValue(d)) return false;
+        out = static_cast<N>(d);
+        return true;
+    }
+
+    // Schema mein nahi - Value chhod do (nested bhi)
+    bool skipValue(int nesting = 0) {
+        if (nesting > 64) return false;
+        skipSpace();
+        if (p >= end) return false;
+        char c = *p;
+        if (c == '"') {
+            ++p;
+            while (p < end && *p != '"') p += *p == '\\' ? 2 : 1;
+            if (p >= end) return false;
+            ++p;
+            return true;
+        }
+        if (c == '{' || c == '[') {
+            char close = c == '{' ? '}' : ']';
+            ++p;
+            if (consume(close)) return true;
+            while (true) {
+                if (c == '{') {
+                    std::string_view key;
+                    std::string scratch;
+                    if (!readKey(key, scratch) || !consume(':')) return false;
+                }
+                if (!skipValue(nesting + 1)) return false;
+                if (consume(close)) return true;
+                if (!consume(',')) return false;
+            }
+        }
+        if (readLiteral("true") || readLiteral("false") || readLiteral("null")) return true;
+        double ignored;
+        return readValue(ignored);
+    }
+
+    template<size_t I, typename Tuple, typename T>
+    bool assign(const Tuple& fields, std::string_view key, T& obj, bool& ok) {
+        if constexpr (I == std::tuple_size<Tuple>::value) {
+            return false;
+        } else {
+            const auto& field = std::get<I>(fields);
+            if (key == field.name) {
+                ok = isNull() ? readLiteral("null") : readValue(obj.*(field.member));
+                return true;
+            }
+            return assign<I + 1>(fields, key, obj, ok);
+        }
+    }
+
+public:
+    explicit JsonReader(const std::string& body) : p(body.data()), end(body.data() + body.size()) {}
+
+    // PARSE: Top-level object -> obj ke members. False = JSON kharab ya
+    // kisi field ka type galat (jo fields us se pehle aaye woh set ho chuke)
+    template<typename Schema, typename T>
+    bool parse(T& obj) {
+        if (!consume('{')) return false;
+        if (consume('}')) return true;
+        std::string scratch;
+        while (true) {
+            std::string_view key;
+            if (!readKey(key, scratch) || !consume(':')) return false;
+            bool ok = true;
+            if (!assign<0>(Schema::fields, key, obj, ok)) ok = skipValue();
+            if (!ok) return false;
+            if (consume('}')) break;
+            if (!consume(',')) return false;
+        }
+        skipSpace();
+        return p == end;
+    }
+};
+
+#endif // JSON_CODEC_HPP
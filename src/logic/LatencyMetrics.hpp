@@ -0,0 +1,281 @@
+#ifndef LATENCY_METRICS_HPP
+#define LATENCY_METRICS_HPP
+
+#include "../dsa/CustomVector.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// ==================== LATENCY METRICS BASICS ====================
+// Har route aur har phase (HTTP, matching, graph search, persistence,
+// JSON encoding) ka latency histogram, aur kuch counters (donors scanned,
+// searches) - /metrics par Prometheus text format mein.
+//
+// Hot path par lock nahi, shared atomic bhi nahi:
+//   - Har thread ka apna SHARD (pehli observe par ek dafa registry lock ke
+//     saath banta hai, phir thread_local pointer)
+//   - Shard ka sirf ek likhne wala (wahi thread) - Increment = relaxed
+//     load + store, koi lock-prefixed instruction / cache line ping-pong nahi
+//   - SCRAPE sab shards ko relaxed load se jodta hai. Beech mein likhi
+//     observation agli scrape mein aa jati hai (count/sum ek dusre se ek
+//     aadh observation aage peeche ho sakte hain - Prometheus ke liye theek)
+//
+// Series (histogram/counter) startup par register hoti hain - Index wapas,
+// phir observe(index, ...). Shards fixed size ke arrays, is liye baad mein
+// register hui series bhi purane shards mein jagah paati hain
+// ================================================================
+
+class LatencyMetrics {
+public:
+    typedef int Series;                          // -1 = koi nahi (observe kuch nahi karta)
+    static const size_t MAX_HISTOGRAMS = 96;
+    static const size_t MAX_COUNTERS = 16;
+    static const size_t BUCKETS = 20;            // 19 bounds + Inf
+
+    // Timer: Banne se destructor tak ka waqt histogram mein. metrics = nullptr -> kuch nahi
+    class Timer {
+    private:
+        LatencyMetrics* metrics;
+        Series series;
+        std::chrono::steady_clock::time_point started;
+    public:
+        Timer(LatencyMetrics* m, Series s) : metrics(m), series(s) {
+            if (metrics) started = std::chrono::steady_clock::now();
+        }
+        ~Timer() {
+            if (metrics) {
+                metrics->observeNanos(series, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - started).count()));
+            }
+        }
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+    };
+
+private:
+    struct Shard {
+        std::thread::id thread;      // Likhne wala
+        std::atomic<uint64_t> buckets[MAX_HISTOGRAMS][BUCKETS];
+        std::atomic<uint64_t> sumNanos[MAX_HISTOGRAMS];
+        std::atomic<uint64_t> counters[MAX_COUNTERS];
+        explicit Shard(std::thread::id owner) : thread(owner) {
+            for (size_t h = 0; h < MAX_HISTOGRAMS; ++h) {
+                for (size_t b = 0; b < BUCKETS; ++b) buckets[h][b].store(0, std::memory_order_relaxed);
+                sumNanos[h].store(0, std::memory_order_relaxed);
+            }
+            for (size_t c = 0; c < MAX_COUNTERS; ++c) counters[c].store(0, std::memory_order_relaxed);
+        }
+    };
+
+    struct Info {
+        std::string name;
+        std::string help;
+        std::string labels;     // 'route="/api/health"' - Khaali = label nahi
+    };
+
+    // Bucket upper bounds (ns): 10us ... 10s
+    static const uint64_t* bounds() {
+        static const uint64_t b[BUCKETS - 1] = {
+            10000ULL, 25000ULL, 50000ULL, 100000ULL, 250000ULL, 500000ULL,
+            1000000ULL, 2500000ULL, 5000000ULL, 10000000ULL, 25000000ULL, 50000000ULL,
+            100000000ULL, 250000000ULL, 500000000ULL, 1000000000ULL, 2500000000ULL, 5000000000ULL,
+            10000000000ULL};
+        return b;
+    }
+
+    mutable std::mutex registryLock;     // Series register aur naya shard - Hot path par nahi
+    CustomVector<Info> histograms;
+    CustomVector<Info> counters;
+    CustomVector<Shard*> shards;
+
+    // Is thread ka shard - Pehli dafa registry mein jodo. thread_local cache
+    // ek hi instance yaad rakhta hai - Doosra instance ho to registry se
+    // wahi purana shard milta hai (naya nahi banta)
+    Shard& localShard() {
+        struct Cached {
+            const LatencyMetrics* owner;
+            Shard* shard;
+            Cached() : owner(nullptr), shard(nullptr) {}
+        };
+        thread_local Cached cache;
+        if (cache.owner != this) {
+            std::thread::id self = std::this_thread::get_id();
+            Shard* shard = nullptr;
+            {
+                std::lock_guard<std::mutex> guard(registryLock);
+                for (size_t i = 0; i < shards.getSize() && !shard; ++i) {
+                    if (shards[i]->thread == self) shard = shards[i];
+                }
+                if (!shard) {
+                    shard = new Shard(self);
+                    shards.push_back(shard);
+                }
+            }
+            cache.owner = this;
+            cache.shard = shard;
+        }
+        return *cache.shard;
+    }
+
+    // Sirf is thread ka likha hua - Atomic RMW ki zarurat nahi
+    static void bump(std::atomic<uint64_t>& cell, uint64_t by) {
+        cell.store(cell.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    static void appendSeconds(std::string& out, uint64_t nanos) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.9g", nanos / 1e9);
+        out += buf;
+    }
+
+    static void appendSeriesName(std::string& out, const std::string& name, const char* suffix,
+                                 const std::string& labels, const char* le) {
+        out += name;
+        out += suffix;
+        if (labels.empty() && !le) return;
+        out += '{';
+        out += labels;
+        if (le) {
+            if (!labels.empty()) out += ',';
+            out += "le=\"";
+            out += le;
+            out += '"';
+        }
+        out += '}';
+    }
+
+    // Label value escape (\ " newline) - Prometheus text format
+    static std::string escapeLabel(const std::string& value) {
+        std::string out;
+        for (char c : value) {
+            if (c == '\\' || c == '"') out += '\\';
+            if (c == '\n') {
+                out += "\\n";
+                continue;
+            }
+            out += c;
+        }
+        return out;
+    }
+
+public:
+    LatencyMetrics() {}
+
+    ~LatencyMetrics() {
+        for (size_t i = 0; i < shards.getSize(); ++i) delete shards[i];
+    }
+
+    // REGISTER: name (e.g. "bloodconnect_phase_duration_seconds"), ek label
+    // (e.g. phase="matching"). Pehle se hai to wahi index (do jagah se ek
+    // phase time ho sakta hai). Jagah khatam = -1
+    Series histogram(const std::string& name, const std::string& help,
+                     const std::string& labelName = "", const std::string& labelValue = "") {
+        Info info;
+        info.name = name;
+        info.help = help;
+        if (!labelName.empty()) info.labels = labelName + "=\"" + escapeLabel(labelValue) + "\"";
+        std::lock_guard<std::mutex> guard(registryLock);
+        for (size_t h = 0; h < histograms.getSize(); ++h) {
+            if (histograms[h].name == name && histograms[h].labels == info.labels) return static_cast<Series>(h);
+        }
+        if (histograms.getSize() >= MAX_HISTOGRAMS) return -1;
+        histograms.push_back(info);
+        return static_cast<Series>(histograms.getSize() - 1);
+    }
+
+    Series counter(const std::string& name, const std::string& help) {
+        std::lock_guard<std::mutex> guard(registryLock);
+        if (counters.getSize() >= MAX_COUNTERS) return -1;
+        Info info;
+        info.name = name;
+        info.help = help;
+        counters.push_back(info);
+        return static_cast<Series>(counters.getSize() - 1);
+    }
+
+    // Do standard families - Sab jagah ek hi naam aur help rahe
+    Series phase(const std::string& name) {
+        return histogram("bloodconnect_phase_duration_seconds",
+                         "Time spent per processing phase", "phase", name);
+    }
+
+    Series route(const std::string& path) {
+        return histogram("bloodconnect_http_request_duration_seconds",
+                         "HTTP request latency per route, handler and response included", "route", path);
+    }
+
+    void observeNanos(Series series, uint64_t nanos) {
+        if (series < 0) return;
+        const uint64_t* b = bounds();
+        size_t bucket = 0;
+        while (bucket < BUCKETS - 1 && nanos > b[bucket]) ++bucket;
+        Shard& shard = localShard();
+        bump(shard.buckets[series][bucket], 1);
+        bump(shard.sumNanos[series], nanos);
+    }
+
+    void add(Series series, uint64_t by = 1) {
+        if (series < 0) return;
+        bump(localShard().counters[series], by);
+    }
+
+    // SCRAPE: Prometheus text (version 0.0.4). Ek naam ki series ek saath,
+    // HELP/TYPE ek dafa
+    std::string scrape() const {
+        std::lock_guard<std::mutex> guard(registryLock);
+        std::string out;
+        CustomVector<bool> written;
+        for (size_t h = 0; h < histograms.getSize(); ++h) written.push_back(false);
+
+        for (size_t h = 0; h < histograms.getSize(); ++h) {
+            if (written[h]) continue;
+            const std::string& name = histograms[h].name;
+            out += "# HELP " + name + " " + histograms[h].help + "\n";
+            out += "# TYPE " + name + " histogram\n";
+            for (size_t s = h; s < histograms.getSize(); ++s) {
+                if (written[s] || histograms[s].name != name) continue;
+                written[s] = true;
+                uint64_t counts[BUCKETS] = {0};
+                uint64_t sum = 0;
+                for (size_t i = 0; i < shards.getSize(); ++i) {
+                    for (size_t b = 0; b < BUCKETS; ++b) {
+                        counts[b] += shards[i]->buckets[s][b].load(std::memory_order_relaxed);
+                    }
+                    sum += shards[i]->sumNanos[s].load(std::memory_order_relaxed);
+                }
+                uint64_t cumulative = 0;
+                for (size_t b = 0; b < BUCKETS; ++b) {
+                    cumulative += counts[b];
+                    std::string le;
+                    if (b + 1 < BUCKETS) appendSeconds(le, bounds()[b]);
+                    else le = "+Inf";
+                    appendSeriesName(out, name, "_bucket", histograms[s].labels, le.c_str());
+                    out += " " + std::to_string(cumulative) + "\n";
+                }
+                appendSeriesName(out, name, "_sum", histograms[s].labels, nullptr);
+                out += " ";
+                appendSeconds(out, sum);
+                out += "\n";
+                appendSeriesName(out, name, "_count", histograms[s].labels, nullptr);
+                out += " " + std::to_string(cumulative) + "\n";
+            }
+        }
+
+        for (size_t c = 0; c < counters.getSize(); ++c) {
+            uint64_t total = 0;
+            for (size_t i = 0; i < shards.getSize(); ++i) {
+                total += shards[i]->counters[c].load(std::memory_order_relaxed);
+            }
+            out += "# HELP " + counters[c].name + " " + counters[c].help + "\n";
+            out += "# TYPE " + counters[c].name + " counter\n";
+            out += counters[c].name + " " + std::to_string(total) + "\n";
+        }
+        return out;
+    }
+};
+
+#endif // LATENCY_METRICS_HPP
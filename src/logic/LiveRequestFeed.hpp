@@ -0,0 +1,234 @@
+#ifndef LIVE_REQUEST_FEED_HPP
+#define LIVE_REQUEST_FEED_HPP
+
+#include "../dsa/CustomHashMap.hpp"
+#include "../dsa/CustomVector.hpp"
+#include "../models/Models.hpp"
+#include "WebSocketHub.hpp"
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+// Live Request Feed - Request ka status badalte hi "request:<id>" topic
+// par push (Searching -> Matched -> Accepted -> Completed, ya Pending /
+// Expired). Poora object nahi, sirf jo badla (delta):
+//   {"type":"delta","requestId":"REC-001","version":3,"t":<epoch micros>,
+//    "changes":{"status":"Matched","unitsReserved":2,"donorsAdded":["DON-004"]}}
+//
+// Har request ka pichla published state yahan yaad hai - Usi se diff.
+// Completed/Expired/Cancelled ka aakhri delta jate hi state hata dete hain
+// (map har request ke saath na badhe) - Uske baad snapshot version 0 deta hai.
+// version har delta par +1: Client ko gap dikhe (slow client ke frames
+// DROP_OLDEST ne giraye) to snapshot() wala full state HTTP se le le.
+// t = transition ka waqt - Client end-to-end latency naap sakta hai
+class LiveRequestFeed {
+public:
+    struct Stats {
+        unsigned long deltas;          // Publish hue
+        unsigned long unchanged;       // notify() aaya par kuch nahi badla
+        unsigned long latencyReports;  // Clients ne latency bheji
+        double latencySumMs;
+        double latencyMaxMs;
+        Stats() : deltas(0), unchanged(0), latencyReports(0), latencySumMs(0), latencyMaxMs(0) {}
+        double latencyAvgMs() const { return latencyReports ? latencySumMs / latencyReports : 0.0; }
+    };
+
+private:
+    struct State {
+        unsigned long version;
+        std::string status;
+        std::string donors;            // matchedDonorId (';' se joined)
+        int unitsNeeded;
+        size_t unitsReserved;
+        State() : version(0), unitsNeeded(0), unitsReserved(0) {}
+    };
+
+    WebSocketHub* hub;
+    CustomHashMap<std::string, State> states;
+    Stats stats;
+    std::mutex lock;
+
+    static CustomVector<std::string> splitIds(const std::string& joined) {
+        CustomVector<std::string> ids;
+        size_t start = 0;
+        while (start <= joined.size()) {
+            size_t end = joined.find(';', start);
+            if (end == std::string::npos) end = joined.size();
+            if (end > start) ids.push_back(joined.substr(start, end - start));
+            start = end + 1;
+        }
+        return ids;
+    }
+
+    // a mein hain, b mein nahi
+    static CustomVector<std::string> missingFrom(const CustomVector<std::string>& a, const CustomVector<std::string>& b) {
+        CustomVector<std::string> out;
+        for (size_t i = 0; i < a.getSize(); ++i) {
+            bool found = false;
+            for (size_t j = 0; j < b.getSize() && !found; ++j) found = a[i] == b[j];
+            if (!found) out.push_back(a[i]);
+        }
+        return out;
+    }
+
+    // IDs aur statuses server ke banaye hue hain (REC-001, DON-004, Matched) -
+    // Phir bhi quote/backslash escape
+    static void appendString(std::ostringstream& out, const std::string& value) {
+        out << '"';
+        for (size_t i = 0; i < value.size(); ++i) {
+            char c = value[i];
+            if (c == '"' || c == '\\') out << '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) out << c;
+        }
+        out << '"';
+    }
+
+    static void appendList(std::ostringstream& out, const CustomVector<std::string>& values) {
+        out << '[';
+        for (size_t i = 0; i < values.getSize(); ++i) {
+            if (i) out << ',';
+            appendString(out, values[i]);
+        }
+        out << ']';
+    }
+
+    static long long nowMicros() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static size_t reservedUnits(const Recipient* r) {
+        return splitIds(r->matchedDonorId).getSize();
+    }
+
+    // Is ke baad request mein kuch nahi badalta
+    static bool isFinal(const std::string& status) {
+        return status == "Completed" || status == "Expired" || status == "Cancelled";
+    }
+
+public:
+    explicit LiveRequestFeed(WebSocketHub* wsHub) : hub(wsHub) {}
+
+    // NOTIFY: Request badli ho sakti hai - Diff nikalo, kuch badla to publish
+    // Return = delta publish hua ya nahi
+    bool notify(const Recipient* r) {
+        std::lock_guard<std::mutex> guard(lock);
+        State previous;
+        bool known = states.get(r->id, previous);
+        if (!known && isFinal(r->status)) {
+            ++stats.unchanged; // Aakhri delta ja chuka (state hat gaya) - Dobara nahi
+            return false;
+        }
+        State current = previous;
+        current.status = r->status;
+        current.donors = r->matchedDonorId;
+        current.unitsNeeded = r->unitsNeeded;
+        current.unitsReserved = reservedUnits(r);
+
+        std::ostringstream changes;
+        bool any = false;
+        if (!known || current.status != previous.status) {
+            changes << "\"status\":";
+            appendString(changes, current.status);
+            any = true;
+        }
+        if (!known || current.unitsNeeded != previous.unitsNeeded) {
+            changes << (any ? "," : "") << "\"unitsNeeded\":" << current.unitsNeeded;
+            any = true;
+        }
+        if (!known || current.unitsReserved != previous.unitsReserved) {
+            changes << (any ? "," : "") << "\"unitsReserved\":" << current.unitsReserved;
+            any = true;
+        }
+        if (current.donors != previous.donors) {
+            CustomVector<std::string> before = splitIds(previous.donors);
+            CustomVector<std::string> after = splitIds(current.donors);
+            CustomVector<std::string> added = missingFrom(after, before);
+            CustomVector<std::string> removed = missingFrom(before, after);
+            if (!added.empty()) {
+                changes << (any ? "," : "") << "\"donorsAdded\":";
+                appendList(changes, added);
+                any = true;
+            }
+            if (!removed.empty()) {
+                changes << (any ? "," : "") << "\"donorsRemoved\":";
+                appendList(changes, removed);
+                any = true;
+            }
+        }
+        if (!any) {
+            ++stats.unchanged;
+            return false;
+        }
+        current.version = previous.version + 1;
+        if (isFinal(current.status)) {
+            states.remove(r->id);
+        } else {
+            states.insert(r->id, current);
+        }
+        ++stats.deltas;
+
+        std::ostringstream frame;
+        frame << "{\"type\":\"delta\",\"requestId\":";
+        appendString(frame, r->id);
+        frame << ",\"version\":" << current.version << ",\"t\":" << nowMicros()
+              << ",\"changes\":{" << changes.str() << "}}";
+        hub->publish(WebSocketHub::requestTopic(r->id), frame.str());
+        return true;
+    }
+
+    // ACCEPTED: Donor ne haan ki - Completed se pehle ka alag step
+    // (accept-request ek hi call mein dono karta hai, client ko dono dikhte hain)
+    void accepted(const Recipient* r, const std::string& donorId) {
+        std::lock_guard<std::mutex> guard(lock);
+        State state;
+        states.get(r->id, state);
+        state.status = "Accepted";
+        state.version += 1;
+        states.insert(r->id, state);
+        ++stats.deltas;
+
+        std::ostringstream frame;
+        frame << "{\"type\":\"delta\",\"requestId\":";
+        appendString(frame, r->id);
+        frame << ",\"version\":" << state.version << ",\"t\":" << nowMicros() << ",\"changes\":{\"status\":\"Accepted\",\"acceptedBy\":";
+        appendString(frame, donorId);
+        frame << "}}";
+        hub->publish(WebSocketHub::requestTopic(r->id), frame.str());
+    }
+
+    // SNAPSHOT: Poora state + version - Subscribe ke baad ya version gap par
+    // Client is version ke baad wale deltas hi apply kare
+    std::string snapshot(const Recipient* r) {
+        std::lock_guard<std::mutex> guard(lock);
+        State state;
+        states.get(r->id, state);
+        std::ostringstream out;
+        out << "{\"type\":\"snapshot\",\"requestId\":";
+        appendString(out, r->id);
+        out << ",\"version\":" << state.version << ",\"t\":" << nowMicros() << ",\"status\":";
+        appendString(out, r->status);
+        out << ",\"unitsNeeded\":" << r->unitsNeeded << ",\"unitsReserved\":"
+            << reservedUnits(r) << ",\"donors\":";
+        appendList(out, splitIds(r->matchedDonorId));
+        out << '}';
+        return out.str();
+    }
+
+    // Client ne delta ka end-to-end latency bheja (receive waqt - t)
+    void recordLatency(double ms) {
+        if (ms < 0 || ms > 60000) return; // Ghadi ka farq / bekaar value
+        std::lock_guard<std::mutex> guard(lock);
+        ++stats.latencyReports;
+        stats.latencySumMs += ms;
+        if (ms > stats.latencyMaxMs) stats.latencyMaxMs = ms;
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> guard(lock);
+        return stats;
+    }
+};
+
+#endif // LIVE_REQUEST_FEED_HPP
@@ -0,0 +1,177 @@
+#ifndef MATCH_BATCHER_HPP
+#define MATCH_BATCHER_HPP
+
+#include "MatchingEngine.hpp"
+#include "../dsa/CustomHashMap.hpp"
+#include "../dsa/CustomVector.hpp"
+#include "../models/Models.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Match Batcher - Incident ke waqt ek hi hospital ke liye bahut saari
+// requests ek saath aati hain. Har request alag search chalaye to same
+// frontier baar baar banta hai. Batcher ek chhoti window (e.g. 2 ms) tak
+// requests jama karta hai, hospital node ke hisaab se group karta hai, aur
+// har group ke liye ek shared search (MatchingEngine::matchGroup) chalata hai.
+//
+// Sab matching isi ek thread par hoti hai - Donor reservation serialize,
+// koi donor do requests ko assign nahi hota.
+class MatchBatcher {
+public:
+    struct Stats {
+        unsigned long requests;   // Kitni requests aayin
+        unsigned long batches;    // Kitni windows process hui
+        unsigned long searches;   // Kitne shared searches (groups) chale
+        Stats() : requests(0), batches(0), searches(0) {}
+    };
+
+private:
+    struct PendingMatch {
+        Recipient* recipient;
+        double departureMinute;
+        MatchingEngine::Deadline deadline;
+        std::function<void(const MatchingEngine::TimedMatch&)> done;
+    };
+
+    MatchingEngine* engine;
+    std::chrono::microseconds window;
+
+    std::mutex lock;
+    std::condition_variable arrived;
+    CustomVector<std::shared_ptr<PendingMatch>> queue;
+    bool stopping;
+
+    std::atomic<unsigned long> requestCount{0};
+    std::atomic<unsigned long> batchCount{0};
+    std::atomic<unsigned long> searchCount{0};
+
+    std::thread worker;
+
+    void workerLoop() {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                arrived.wait(guard, [&] { return stopping || !queue.empty(); });
+                if (stopping && queue.empty()) return;
+            }
+
+            // Pehli request aa gayi - Window bhar aur aane do
+            if (window.count() > 0) {
+                std::this_thread::sleep_for(window);
+            }
+
+            CustomVector<std::shared_ptr<PendingMatch>> batch;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                batch = queue;
+                queue.clear();
+            }
+            ++batchCount;
+            processBatch(batch);
+        }
+    }
+
+    // Hospital node ke hisaab se group, phir har group ka ek shared search
+    void processBatch(const CustomVector<std::shared_ptr<PendingMatch>>& batch) {
+        CustomHashMap<std::string, CustomVector<size_t>> groups; // nodeId -> batch indices
+        CustomVector<std::string> nodeOrder;                     // Pehle aaye group pehle
+        for (size_t i = 0; i < batch.getSize(); ++i) {
+            const std::string& node = batch[i]->recipient->locationNodeId;
+            CustomVector<size_t> members;
+            if (!groups.get(node, members)) {
+                nodeOrder.push_back(node);
+            }
+            members.push_back(i);
+            groups.insert(node, members);
+        }
+
+        for (size_t g = 0; g < nodeOrder.getSize(); ++g) {
+            CustomVector<size_t> members;
+            groups.get(nodeOrder[g], members);
+
+            // Group ki deadline = sabse jaldi wali (sab ka jawab ek saath jata hai)
+            CustomVector<Recipient*> recipients;
+            MatchingEngine::Deadline deadline = MatchingEngine::Deadline::max();
+            for (size_t m = 0; m < members.getSize(); ++m) {
+                recipients.push_back(batch[members[m]]->recipient);
+                if (batch[members[m]]->deadline < deadline) deadline = batch[members[m]]->deadline;
+            }
+
+            // Group ka departure = pehli request ka (sab ek window ke andar hain)
+            CustomVector<MatchingEngine::TimedMatch> matches =
+                engine->matchGroup(recipients, batch[members[0]]->departureMinute, 8, deadline);
+            ++searchCount;
+
+            for (size_t m = 0; m < members.getSize(); ++m) {
+                try {
+                    batch[members[m]]->done(matches[m]);
+                } catch (...) {
+                    // Callback ka error uska apna - Baaki group ko jawab milta rahe
+                }
+            }
+        }
+    }
+
+public:
+    // windowMicros = kitni der requests jama karni hain (0 = foran)
+    MatchBatcher(MatchingEngine* e, long windowMicros = 2000)
+        : engine(e), window(windowMicros), stopping(false) {
+        worker = std::thread(&MatchBatcher::workerLoop, this);
+    }
+
+    ~MatchBatcher() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        arrived.notify_one();
+        worker.join();
+    }
+
+    // SUBMIT: Request batcher ko do - Group search ke baad done(match)
+    // batcher thread par chalta hai (donor nullptr = koi nahi mila). Donor
+    // already "Busy" reserve ho chuka hoga. done jaldi return kare - Ruke to
+    // agli window ruki. deadline = is waqt tak jawab chahiye (window ka
+    // intezar bhi shamil)
+    void submit(Recipient* recipient, double departureMinute, MatchingEngine::Deadline deadline,
+                const std::function<void(const MatchingEngine::TimedMatch&)>& done) {
+        std::shared_ptr<PendingMatch> pending = std::make_shared<PendingMatch>();
+        pending->recipient = recipient;
+        pending->departureMinute = departureMinute;
+        pending->deadline = deadline;
+        pending->done = done;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            queue.push_back(pending);
+        }
+        ++requestCount;
+        arrived.notify_one();
+    }
+
+    // Future wala version - Jawab tak rukne wale callers ke liye
+    std::future<MatchingEngine::TimedMatch> submit(Recipient* recipient, double departureMinute,
+                                                   MatchingEngine::Deadline deadline = MatchingEngine::Deadline::max()) {
+        std::shared_ptr<std::promise<MatchingEngine::TimedMatch>> promise =
+            std::make_shared<std::promise<MatchingEngine::TimedMatch>>();
+        submit(recipient, departureMinute, deadline,
+               [promise](const MatchingEngine::TimedMatch& match) { promise->set_value(match); });
+        return promise->get_future();
+    }
+
+    Stats getStats() const {
+        Stats s;
+        s.requests = requestCount.load();
+        s.batches = batchCount.load();
+        s.searches = searchCount.load();
+        return s;
+    }
+};
+
+#endif // MATCH_BATCHER_HPP
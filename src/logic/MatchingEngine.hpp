@@ -5,35 +5,537 @@
 #include "../dsa/CustomHashMap.hpp"
 #include "../dsa/CustomVector.hpp"
 #include "../dsa/CustomGraph.hpp"
+#include "../dsa/CoordinatePrefilter.hpp"
 #include "../models/Models.hpp"
 #include "BloodCompatibility.hpp"
+#include "DistanceCache.hpp"
+#include "Eligibility.hpp"
+#include "../dsa/MinCostAssignment.hpp"
+#include "../dsa/TimerWheel.hpp"
+#include "LatencyMetrics.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <limits>
+#include <mutex>
 
 // Matching Engine - Donor aur Recipient ko ek dusre se match karte hain
 // Sabse behtar donor nikal te hain recipient ke liye
 class MatchingEngine {
+public:
+    // Donor ke saath kuch hua jis ki donor ko khabar deni hai (SMS/push)
+    enum DonorEvent {
+        DONOR_RESERVED,   // Kisi request ke liye reserve - recipient set
+        DONOR_ELIGIBLE,   // Donation waqfa khatam, dobara matching mein - recipient nullptr
+        DONOR_RELEASED    // Reservation chhoot gayi (timeout/expiry) - Wapas "Available"
+    };
+    
+    // Reserved donor ka accept - Kya hua
+    enum AcceptResult {
+        ACCEPTED,            // Donor ka unit ho gaya, baaki units abhi baaki
+        REQUEST_COMPLETED,   // Aakhri unit - Request "Completed"
+        NOT_RESERVED,        // Ye donor is request ke liye reserve nahi
+        ALREADY_ACCEPTED,    // Is donor ka unit pehle hi ho chuka
+        REQUEST_CLOSED       // Request Completed/Expired/Cancelled
+    };
+    typedef std::function<void(DonorEvent, const Donor*, const Recipient*)> DonorListener;
+
 private:
     // Priority queue mein recipients ko store karte hain - Urgent wale pehle
     CustomPriorityQueue<Recipient*, RecipientUrgencyComparator> recipientQueue;
     // Blood group wise donors ke liye HashMap - O+ mein sab O+ donors rehte hain
     CustomHashMap<std::string, CustomVector<Donor*>> donorMap; // bloodGroup -> donors
+    // Location wise donors - Frontier search mein node settle hote hi
+    // wahan ke donors seedha mil jate hain
+    CustomHashMap<std::string, CustomVector<Donor*>> donorsByNode; // nodeId -> donors
     // Location graph - Cities aur hospitals ka connection
     CustomGraph* locationGraph;
     // Blood compatibility checker
     BloodCompatibility compatibility;
+    // Shortest distances ka cache - Graph epoch se invalidate hota hai
+    DistanceCache distanceCache;
+    // Road updates ek waqt mein ek - Graph change + cache repair saath
+    std::mutex roadUpdateLock;
+    // recipientQueue handler threads se bhi badalti hai
+    std::mutex queueLock;
+    // Donor reservation - matchGroup aur global assignment ek waqt mein ek
+    // (donor indexes ki har tabdeeli bhi isi ke andar)
+    std::mutex matchLock;
+    // Jo donors abhi donate nahi kar sakte - Indexes se bahar, eligibility
+    // day ke hisaab se min-heap mein
+    ReactivationIndex reactivation;
+    // Timeouts - Reservation release, request expiry, eligibility
+    // (attachTimers se pehle nullptr - Kuch expire nahi hota)
+    TimerWheel* timers;
+    std::chrono::milliseconds reservationTimeout;
+    std::chrono::milliseconds requestExpiry;
+    struct PendingRelease {
+        TimerWheel::TimerId timer;
+        Donor* donor;
+        PendingRelease() : timer(TimerWheel::NO_TIMER), donor(nullptr) {}
+        PendingRelease(TimerWheel::TimerId t, Donor* d) : timer(t), donor(d) {}
+    };
+    CustomHashMap<std::string, PendingRelease> reservations;           // donorId -> release timer
+    CustomHashMap<std::string, TimerWheel::TimerId> requestTimers;     // recipientId -> timer
+    // Expiry ke waqt Matched/Broadcast the - Deadline guzar chuki, wapas
+    // Pending hote hi Expired (queue mein nahi)
+    CustomHashMap<std::string, bool> overdueRequests;
+    CustomHashMap<std::string, TimerWheel::TimerId> eligibilityTimers; // donorId -> reactivation timer
+    // Request status badla (timeout release, expiry, global pass) - Live feed ko batao
+    std::function<void(const Recipient*)> requestListener;
+    // Donor events - Notification outbox (sirf enqueue, lock ke andar chalta hai)
+    DonorListener donorListener;
+    // Deadline metrics - Kitni dafa deadline ne search kaati
+    std::atomic<unsigned long> deadlineRequests{0};
+    std::atomic<unsigned long> deadlineTruncated{0};
+    std::atomic<unsigned long> frontierCuts{0};
+    std::atomic<unsigned long> estimatedRoutes{0};
+    // Prefilter metrics - Kitni graph queries coordinates ne bachayi
+    std::atomic<unsigned long> prefilterSearches{0};
+    std::atomic<unsigned long> prefilterCandidates{0};
+    std::atomic<unsigned long> prefilterQueries{0};
+    // /metrics - Phase histograms aur counters (attachMetrics se pehle
+    // nullptr - Timer aur count kuch nahi karte)
+    LatencyMetrics* metrics;
+    LatencyMetrics::Series matchingPhase;
+    LatencyMetrics::Series graphSearchPhase;
+    LatencyMetrics::Series donorsScanned;
+    LatencyMetrics::Series searchesRun;
+    LatencyMetrics::Series matchesRun;
+    
+    void count(LatencyMetrics::Series series, uint64_t by = 1) {
+        if (metrics) metrics->add(series, by);
+    }
     
 public:
+    // Ek candidate donor aur recipient se uska road distance
+    struct DonorCandidate {
+        Donor* donor;
+        double distance;
+        
+        DonorCandidate() : donor(nullptr), distance(0.0) {}
+        DonorCandidate(Donor* d, double dist) : donor(d), distance(dist) {}
+    };
+    
+    // Ek reserved unit - Donor aur uska travel time (minutes)
+    struct ReservedUnit {
+        Donor* donor;
+        double travelMinutes;
+        
+        ReservedUnit() : donor(nullptr), travelMinutes(0.0) {}
+        ReservedUnit(Donor* d, double minutes) : donor(d), travelMinutes(minutes) {}
+    };
+    
+    // Time-dependent match - Donor aur uska travel time (minutes)
+    // Multi-unit request mein units = sab reserved donors (jaldi wala
+    // pehle), donor/travelMinutes = units[0]
+    // optimal = deadline ne search nahi kaati - Wahi result jo bina
+    // deadline ke milta. False = ab tak ka best (anytime answer)
+    struct TimedMatch {
+        Donor* donor;
+        double travelMinutes;
+        CustomVector<ReservedUnit> units;
+        bool optimal;
+        
+        TimedMatch() : donor(nullptr), travelMinutes(std::numeric_limits<double>::infinity()), optimal(true) {}
+        
+        // Aakhri unit kab pahunchegi - Request tab poori hoti hai
+        double completionMinutes() const {
+            return units.empty() ? travelMinutes : units[units.getSize() - 1].travelMinutes;
+        }
+    };
+    
+    // Global assignment ka nateeja - Kis recipient ko kaun sa donor
+    struct AssignmentReport {
+        CustomVector<Recipient*> recipients;   // Har reserved unit ka recipient (repeat ho sakta hai)
+        CustomVector<DonorCandidate> donors;   // Same index - Donor aur distance (km)
+        size_t pending;                        // Kitne pending recipients the
+        size_t unitsRequested;                 // Un ke kitne units baaki the
+        size_t donorsConsidered;               // Candidate graph ke columns
+        size_t candidateEdges;                 // Candidate graph ki edges
+        size_t rounds;                         // Kitne solve rounds chale
+        double totalCost;                      // Urgency-weighted km + unmatched penalty
+        long candidateMicros;                  // Frontier searches ka time
+        long solveMicros;                      // Sirf solver ka time
+        MinCostAssignment::Stats solverStats;
+        
+        AssignmentReport() : pending(0), unitsRequested(0), donorsConsidered(0), candidateEdges(0), rounds(0), totalCost(0),
+                             candidateMicros(0), solveMicros(0) {}
+    };
+    
+    // Matching deadline - steady clock par absolute waqt
+    typedef std::chrono::steady_clock::time_point Deadline;
+    
+    // Deadline metrics snapshot
+    struct DeadlineStats {
+        unsigned long requests;         // Deadline ke saath kitni requests match hui
+        unsigned long truncated;        // Jin ka result optimal nahi tha
+        unsigned long frontierCuts;     // Frontier deadline se pehle roka
+        unsigned long estimatedRoutes;  // Exact route ki jagah frontier estimate
+        DeadlineStats() : requests(0), truncated(0), frontierCuts(0), estimatedRoutes(0) {}
+    };
+    
+    // Prefilter metrics snapshot - pruned = candidates - graphQueries
+    struct PrefilterStats {
+        unsigned long searches;       // matchGroup mein har recipient ki candidate search
+        unsigned long candidates;     // Considered candidates (frontier order wale)
+        unsigned long graphQueries;   // Jin ki asal graph distance poochi
+        PrefilterStats() : searches(0), candidates(0), graphQueries(0) {}
+        unsigned long pruned() const { return candidates - graphQueries; }
+    };
+    
+    // Unmatched unit ki qeemat (km, urgency weight se multiply) -
+    // Kisi bhi realistic route se bahut zyada, is liye pehle zyada se
+    // zyada recipients match hote hain, phir distance kam hota hai
+    static constexpr double UNASSIGNED_PENALTY_KM = 1000.0;
+    
+    // Whole blood donation ke baad waqfa (days) - Is se pehle dobara nahi
+    static const int DONATION_INTERVAL_DAYS = 90;
+    
     // Constructor - graph pointer pass karte hain
-    MatchingEngine(CustomGraph* graph) : locationGraph(graph) {}
+    MatchingEngine(CustomGraph* graph)
+        : locationGraph(graph), distanceCache(graph), timers(nullptr),
+          reservationTimeout(0), requestExpiry(0), metrics(nullptr), matchingPhase(-1),
+          graphSearchPhase(-1), donorsScanned(-1), searchesRun(-1), matchesRun(-1) {}
+    
+    // TIMERS: Wheel attach karo - Is ke baad reservations reservationTimeout
+    // mein accept na hon to release, requests requestExpiry ke baad expire,
+    // aur parked donors apne eligibility din par khud wapas
+    void attachTimers(TimerWheel* wheel, std::chrono::milliseconds reservationTimeoutAfter,
+                      std::chrono::milliseconds requestExpiryAfter) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        timers = wheel;
+        reservationTimeout = reservationTimeoutAfter;
+        requestExpiry = requestExpiryAfter;
+    }
+    
+    // METRICS: matching aur graph_search phases, aur donors scanned /
+    // searches run counters - Match count se bhaag do to per-match figure
+    void attachMetrics(LatencyMetrics* m) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        matchingPhase = m->phase("matching");
+        graphSearchPhase = m->phase("graph_search");
+        donorsScanned = m->counter("bloodconnect_match_donors_scanned_total",
+                                   "Donors examined while matching");
+        searchesRun = m->counter("bloodconnect_match_searches_total",
+                                 "Graph searches (frontier expansions and exact routes) run while matching");
+        matchesRun = m->counter("bloodconnect_matches_total",
+                                "Requests put through matching");
+        metrics = m;
+    }
+    
+    // LISTENER: Engine ke andar hone wale request changes (background
+    // matcher, reservation timeout, expiry) - matchLock ke andar call hota hai
+    void setRequestListener(const std::function<void(const Recipient*)>& listener) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        requestListener = listener;
+    }
+    
+    void requestChanged(const Recipient* recipient) {
+        if (requestListener) requestListener(recipient);
+    }
+    
+    // Donor listener - Ye bhi matchLock ke andar, is liye jaldi return kare
+    void setDonorListener(const DonorListener& listener) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        donorListener = listener;
+    }
+    
+    // SYNCHRONIZED: Donor/Recipient ke woh fields jo engine bhi badalta hai
+    // (status, matchedDonorId) - Bahar se inhein padhna/likhna isi ke andar
+    template<typename F>
+    void synchronized(F f) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        f();
+    }
     
     // Recipient request queue mein add karte hain
     // Priority queue ko automatic sort kar dega urgency ke hisaab se
     void addRecipientRequest(Recipient* recipient) {
+        enqueue(recipient);
+        std::lock_guard<std::mutex> guard(matchLock);
+        if (timers) {
+            requestTimers.insert(recipient->id,
+                timers->schedule(requestExpiry, [this, recipient] { expireRequest(recipient); }));
+        }
+    }
+    
+    void enqueue(Recipient* recipient) {
+        std::lock_guard<std::mutex> guard(queueLock);
         recipientQueue.push(recipient);
     }
     
-    // Donor ko donorMap mein add karte hain - Blood group wise
+    // Kitne units chahiye - CSV/form mein 0 ya negative ho to 1
+    static size_t unitsRequested(const Recipient* recipient) {
+        return recipient->unitsNeeded > 0 ? static_cast<size_t>(recipient->unitsNeeded) : 1;
+    }
+    
+    // Kitne donors reserve ho chuke - matchedDonorId mein ';' se alag ids
+    static size_t unitsReserved(const Recipient* recipient) {
+        if (recipient->matchedDonorId.empty()) return 0;
+        size_t count = 1;
+        for (size_t i = 0; i < recipient->matchedDonorId.size(); ++i) {
+            if (recipient->matchedDonorId[i] == ';') ++count;
+        }
+        return count;
+    }
+    
+    // ';' list (matchedDonorId, acceptedDonorIds) ke ids
+    static CustomVector<std::string> splitIds(const std::string& joined) {
+        CustomVector<std::string> ids;
+        size_t start = 0;
+        while (start <= joined.size()) {
+            size_t end = joined.find(';', start);
+            if (end == std::string::npos) end = joined.size();
+            if (end > start) ids.push_back(joined.substr(start, end - start));
+            start = end + 1;
+        }
+        return ids;
+    }
+    
+    static bool listContains(const std::string& joined, const std::string& id) {
+        CustomVector<std::string> ids = splitIds(joined);
+        for (size_t i = 0; i < ids.getSize(); ++i) {
+            if (ids[i] == id) return true;
+        }
+        return false;
+    }
+    
+    // Kitne units ka donation ho chuka
+    static size_t unitsAccepted(const Recipient* recipient) {
+        return splitIds(recipient->acceptedDonorIds).getSize();
+    }
+    
+    // Donor ka unit donate ho gaya - matchedDonorId mein bhi ho (broadcast
+    // winner ka pehle recordReservation)
+    static void recordAcceptance(Recipient* recipient, const Donor* donor) {
+        if (!recipient->acceptedDonorIds.empty()) recipient->acceptedDonorIds += ";";
+        recipient->acceptedDonorIds += donor->id;
+    }
+    
+    // Reserve kiya donor recipient ke record mein jodo
+    static void recordReservation(Recipient* recipient, const Donor* donor) {
+        if (!recipient->matchedDonorId.empty()) recipient->matchedDonorId += ";";
+        recipient->matchedDonorId += donor->id;
+    }
+    
+    // Record se donor nikalo - False agar list mein tha hi nahi
+    static bool dropReservation(Recipient* recipient, const std::string& donorId) {
+        std::string kept;
+        bool found = false;
+        size_t start = 0;
+        while (start <= recipient->matchedDonorId.size()) {
+            size_t end = recipient->matchedDonorId.find(';', start);
+            if (end == std::string::npos) end = recipient->matchedDonorId.size();
+            std::string id = recipient->matchedDonorId.substr(start, end - start);
+            if (!found && id == donorId) {
+                found = true;
+            } else if (!id.empty()) {
+                if (!kept.empty()) kept += ";";
+                kept += id;
+            }
+            start = end + 1;
+        }
+        if (found) recipient->matchedDonorId = kept;
+        return found;
+    }
+    
+    // RESERVE: Donor "Busy", recipient ke record mein, aur release timer
+    // matchLock ke andar call karo
+    void reserve(Recipient* recipient, Donor* donor) {
+        donor->status = "Busy";
+        recordReservation(recipient, donor);
+        if (donorListener) donorListener(DONOR_RESERVED, donor, recipient);
+        if (timers) {
+            cancelReservationTimer(donor->id);
+            TimerWheel::TimerId id =
+                timers->schedule(reservationTimeout, [this, recipient, donor] { releaseReservation(recipient, donor); });
+            reservations.insert(donor->id, PendingRelease(id, donor));
+        }
+    }
+    
+    // CLAIM DONOR: Broadcast offer jeetne wala donor - Sirf "Available" ho
+    // to "Busy" (usi waqt koi matcher usay reserve na kar raha ho)
+    bool claimDonor(Donor* donor) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        if (donor->status != "Available") return false;
+        donor->status = "Busy";
+        return true;
+    }
+    
+    // ACCEPT RESERVED UNIT: Reserve mode ka accept - Sirf woh donor jo is
+    // request ke liye reserve hai (matchedDonorId mein, abhi accept nahi
+    // kiya). Sirf usi ka unit hota hai; sab units accept hon tab hi
+    // "Completed", aur tab jo reservations bachi hon woh release + expiry
+    // timer cancel. Donation record (park) bhi isi lock mein - Beech mein
+    // matcher donor ko "Available" dekh kar dobara reserve na kar le
+    AcceptResult acceptReservedUnit(Recipient* recipient, Donor* donor, int day = EpochDays::today()) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        if (recipient->status == "Completed" || recipient->status == "Expired" || recipient->status == "Cancelled") {
+            return REQUEST_CLOSED;
+        }
+        if (listContains(recipient->acceptedDonorIds, donor->id)) return ALREADY_ACCEPTED;
+        if (!listContains(recipient->matchedDonorId, donor->id) || donor->status != "Busy") return NOT_RESERVED;
+        
+        recordAcceptance(recipient, donor);
+        donated(donor, day);
+        if (unitsAccepted(recipient) < unitsRequested(recipient)) return ACCEPTED;
+        
+        recipient->status = "Completed";
+        releaseUnaccepted(recipient);
+        cancelTimer(requestTimers, recipient->id);
+        overdueRequests.remove(recipient->id);
+        return REQUEST_COMPLETED;
+    }
+    
+    // ACCEPT BROADCAST UNIT: Dispatch board par jeeta hua slot (claimDonor
+    // ne donor "Busy" kiya). Har winner ka unit record mein; aakhri (last)
+    // request "Completed" aur expiry timer cancel. Donation record isi lock mein
+    void acceptBroadcastUnit(Recipient* recipient, Donor* donor, bool last, int day = EpochDays::today()) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        recordReservation(recipient, donor);
+        recordAcceptance(recipient, donor);
+        donated(donor, day);
+        if (!last) return;
+        recipient->status = "Completed";
+        cancelTimer(requestTimers, recipient->id);
+        overdueRequests.remove(recipient->id);
+    }
+    
+    // Jo reserved donors accept nahi kar paye - Record se bahar, wapas
+    // "Available" aur unke release timers cancel (matchLock ke andar)
+    void releaseUnaccepted(Recipient* recipient) {
+        CustomVector<std::string> ids = splitIds(recipient->matchedDonorId);
+        for (size_t i = 0; i < ids.getSize(); ++i) {
+            if (listContains(recipient->acceptedDonorIds, ids[i])) continue;
+            dropReservation(recipient, ids[i]);
+            PendingRelease pending;
+            if (reservations.get(ids[i], pending)) {
+                if (pending.donor->status == "Busy") {
+                    pending.donor->status = "Available";
+                    if (donorListener) donorListener(DONOR_RELEASED, pending.donor, recipient);
+                }
+                cancelReservationTimer(ids[i]);
+            }
+        }
+    }
+    
+    // Timer cancel aur map se hatao (matchLock ke andar)
+    void cancelTimer(CustomHashMap<std::string, TimerWheel::TimerId>& map, const std::string& key) {
+        TimerWheel::TimerId id;
+        if (timers && map.get(key, id)) {
+            timers->cancel(id);
+            map.remove(key);
+        }
+    }
+    
+    // Donor ka release timer cancel (donation accept / request expire)
+    void cancelReservationTimer(const std::string& donorId) {
+        PendingRelease pending;
+        if (timers && reservations.get(donorId, pending)) {
+            timers->cancel(pending.timer);
+            reservations.remove(donorId);
+        }
+    }
+    
+    // RESERVATION TIMEOUT: Donor ne waqt par accept nahi kiya - Wapas
+    // "Available", recipient ke record se bahar, aur recipient dobara queue
+    // mein (agla global pass naya donor dhoondega)
+    void releaseReservation(Recipient* recipient, Donor* donor) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        reservations.remove(donor->id);
+        if (donor->status != "Busy" || recipient->status == "Completed") return;
+        if (!dropReservation(recipient, donor->id)) return; // Kisi aur ka reservation
+        donor->status = "Available";
+        if (donorListener) donorListener(DONOR_RELEASED, donor, recipient);
+        if (recipient->status == "Matched") revertToPending(recipient);
+        requestChanged(recipient);
+    }
+    
+    // REOPEN BROADCAST: Offer band hua aur units khaali - "Broadcast" request
+    // wapas Pending (ya deadline guzar chuki ho to Expired)
+    // False = request broadcast par thi hi nahi (pehle hi complete/expire)
+    bool reopenBroadcast(Recipient* recipient) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        if (recipient->status != "Broadcast") return false;
+        revertToPending(recipient);
+        return true;
+    }
+    
+    // Held (Matched/Broadcast) request wapas Pending aur queue mein - Lekin
+    // expiry is dauran guzar chuki ho to Expired (matchLock ke andar)
+    void revertToPending(Recipient* recipient) {
+        bool overdue = false;
+        if (overdueRequests.get(recipient->id, overdue)) {
+            expireLocked(recipient);
+            return;
+        }
+        recipient->status = "Pending";
+        enqueue(recipient);
+    }
+    
+    // REQUEST EXPIRY: Itni der mein match nahi hua - "Expired", aur jo
+    // units reserve the woh donors release. Us waqt reserve/broadcast par
+    // ho to deadline yaad rakhte hain - Wapas Pending hote hi expire
+    void expireRequest(Recipient* recipient) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        requestTimers.remove(recipient->id);
+        if (recipient->status == "Pending" || recipient->status == "Searching") {
+            expireLocked(recipient);
+            requestChanged(recipient);
+        } else if (recipient->status != "Completed" && recipient->status != "Expired" &&
+                   recipient->status != "Cancelled") {
+            overdueRequests.insert(recipient->id, true);
+        }
+    }
+    
+    // matchLock ke andar
+    void expireLocked(Recipient* recipient) {
+        overdueRequests.remove(recipient->id);
+        releaseUnaccepted(recipient); // Jo units donate ho chuke woh record mein rehte hain
+        recipient->status = "Expired"; // Queue se agle collect par hat jayega
+    }
+    
+    // Abhi kitne units baaki hain
+    static size_t unitsRemaining(const Recipient* recipient) {
+        size_t needed = unitsRequested(recipient);
+        size_t reserved = unitsReserved(recipient);
+        return reserved >= needed ? 0 : needed - reserved;
+    }
+    
+    // Urgency se matching ka time budget - Immediate ko abhi ka achha
+    // jawab chahiye, baad ka behtareen nahi
+    static std::chrono::milliseconds matchBudget(const Recipient* recipient) {
+        switch (recipient->getUrgencyPriority()) {
+            case 1: return std::chrono::milliseconds(50);    // Immediate
+            case 2: return std::chrono::milliseconds(150);   // High
+            case 3: return std::chrono::milliseconds(400);   // Medium
+            default: return std::chrono::milliseconds(1000); // Low
+        }
+    }
+    
+    DeadlineStats getDeadlineStats() const {
+        DeadlineStats s;
+        s.requests = deadlineRequests.load();
+        s.truncated = deadlineTruncated.load();
+        s.frontierCuts = frontierCuts.load();
+        s.estimatedRoutes = estimatedRoutes.load();
+        return s;
+    }
+    
+    // Donor register karte hain - Eligible hai to indexes mein, warna
+    // reactivation heap mein (eligibility day par khud wapas aa jayega)
     void addDonor(Donor* donor) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        if (donor->nextEligibleDay != EpochDays::NONE && donor->nextEligibleDay > EpochDays::today()) {
+            park(donor);
+            return;
+        }
+        indexDonor(donor);
+    }
+    
+    // Donor ko donorMap mein add karte hain - Blood group wise
+    void indexDonor(Donor* donor) {
         CustomVector<Donor*> donors;
         // Pehle check karte hain ke is blood group ke donors pehle se hain ya nahi
         if (donorMap.get(donor->bloodGroup, donors)) {
@@ -46,10 +548,32 @@ public:
             newDonors.push_back(donor);
             donorMap.insert(donor->bloodGroup, newDonors);
         }
+        
+        // Location index mein bhi add karte hain
+        CustomVector<Donor*> atNode;
+        donorsByNode.get(donor->locationNodeId, atNode);
+        atNode.push_back(donor);
+        donorsByNode.insert(donor->locationNodeId, atNode);
+    }
+    
+    // Donor ko dono indexes se nikalte hain (sirf uski group/node list)
+    void unindexDonor(Donor* donor) {
+        CustomVector<Donor*> donors;
+        if (donorMap.get(donor->bloodGroup, donors)) {
+            CustomVector<Donor*> updated;
+            for (size_t i = 0; i < donors.getSize(); ++i) {
+                if (donors[i] != donor) {
+                    updated.push_back(donors[i]);
+                }
+            }
+            donorMap.insert(donor->bloodGroup, updated);
+        }
+        removeFromNodeIndex(donor);
     }
     
     // Donor ko remove karte hain - Shayd busy ho gaya ya donation de diya
     void removeDonor(const std::string& donorId, const std::string& bloodGroup) {
+        std::lock_guard<std::mutex> guard(matchLock);
         CustomVector<Donor*> donors;
         // Pehle us blood group ke sab donors nikal te hain
         if (donorMap.get(bloodGroup, donors)) {
@@ -63,41 +587,597 @@ public:
             }
             // Updated list ko back insert karte hain
             donorMap.insert(bloodGroup, updated);
+            
+            // Location index se bhi hatao
+            for (size_t i = 0; i < donors.getSize(); ++i) {
+                if (donors[i]->id == donorId) {
+                    removeFromNodeIndex(donors[i]);
+                    break;
+                }
+            }
         }
+        // Waqfe wala (parked) donor indexes mein hota hi nahi - Heap aur
+        // eligibility timer se bhi hatao, warna reactivateDue usay wapas le aata
+        reactivation.remove(donorId);
+        cancelTimer(eligibilityTimers, donorId);
+    }
+    
+    // DONATION RECORD: Donor ne aaj (day) donate kiya - Agli eligibility
+    // day + DONATION_INTERVAL_DAYS. Indexes se nikal kar heap mein, taake
+    // waqfe ke dauran kisi match mein na aaye
+    void recordDonation(Donor* donor, int day = EpochDays::today()) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        donated(donor, day);
+    }
+    
+    // Donation ki bookkeeping (matchLock ke andar) - Donor pehle park, phir
+    // "Available": Lock chhootne tak woh kisi index mein nahi
+    void donated(Donor* donor, int day) {
+        bool wasIndexed = donor->nextEligibleDay == EpochDays::NONE || donor->nextEligibleDay <= day;
+        donor->lastDonationDay = day;
+        donor->lastDonationDate = EpochDays::format(day);
+        donor->nextEligibleDay = day + DONATION_INTERVAL_DAYS;
+        donor->nextEligibleDate = EpochDays::format(donor->nextEligibleDay);
+        if (wasIndexed) unindexDonor(donor);
+        cancelReservationTimer(donor->id);
+        cancelTimer(eligibilityTimers, donor->id); // Purani eligibility date ab bekaar
+        park(donor);
+        donor->status = "Available";
+        donor->totalDonations++;
+    }
+    
+    // Donor heap mein, aur eligibility din par reactivation timer
+    // (matchLock ke andar)
+    // Timer id donor ke naam par - Nayi donation usay cancel karti hai
+    void park(Donor* donor) {
+        reactivation.push(donor);
+        if (timers) {
+            int day = donor->nextEligibleDay;
+            eligibilityTimers.insert(donor->id,
+                timers->schedule(std::chrono::seconds(EpochDays::secondsUntil(day)),
+                                 [this, donor, day] { eligibilityDue(donor, day); }));
+        }
+    }
+    
+    // Eligibility timer fire hua - Map se hatao (agar beech mein naya park
+    // na hua ho) aur due donors wapas
+    void eligibilityDue(Donor* donor, int day) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        if (donor->nextEligibleDay == day) eligibilityTimers.remove(donor->id);
+        reactivateDue(day);
+    }
+    
+    // REACTIVATION: Jin donors ka eligibility day aa gaya woh wapas indexes
+    // mein. Heap ka top dekhte hain - Koi due nahi to O(1)
+    // Return = kitne wapas aaye
+    size_t refreshEligibility(int today = EpochDays::today()) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        return reactivateDue(today);
+    }
+    
+    // matchLock ke andar - Heap se due donors nikal kar indexes mein
+    size_t reactivateDue(int today) {
+        CustomVector<Donor*> due;
+        reactivation.popDue(today, due);
+        for (size_t i = 0; i < due.getSize(); ++i) {
+            indexDonor(due[i]);
+            if (donorListener) donorListener(DONOR_ELIGIBLE, due[i], nullptr);
+        }
+        return due.getSize();
+    }
+    
+    // Kitne donors abhi waqfe mein hain
+    size_t waitingForEligibility() {
+        std::lock_guard<std::mutex> guard(matchLock);
+        return reactivation.size();
+    }
+    
+    // Donor ko uske node ki list se nikalte hain
+    void removeFromNodeIndex(Donor* donor) {
+        CustomVector<Donor*> atNode;
+        if (donorsByNode.get(donor->locationNodeId, atNode)) {
+            CustomVector<Donor*> updated;
+            for (size_t i = 0; i < atNode.getSize(); ++i) {
+                if (atNode[i] != donor) {
+                    updated.push_back(atNode[i]);
+                }
+            }
+            donorsByNode.insert(donor->locationNodeId, updated);
+        }
+    }
+    
+    PrefilterStats getPrefilterStats() const {
+        PrefilterStats s;
+        s.searches = prefilterSearches.load();
+        s.candidates = prefilterCandidates.load();
+        s.graphQueries = prefilterQueries.load();
+        return s;
+    }
+    
+    // K nearest compatible donors - Recipient ke node se Dijkstra frontier
+    // bahar ki taraf badhate hain. Har settled node par wahan ke available
+    // compatible donors utha lete hain. Nodes distance order mein settle hote
+    // hain, is liye k mil gaye to aage koi donor is se kareeb nahi ho sakta -
+    // Search wahi rok dete hain. Kaam k aur local density par depend karta
+    // hai, poori donor population par nahi.
+    // Result distance ke hisaab se sorted (kareeb wala pehle)
+    CustomVector<DonorCandidate> findTopKDonors(Recipient* recipient, size_t k) {
+        std::lock_guard<std::mutex> guard(matchLock); // Pool threads se bhi aata hai
+        return topKDonors(recipient, k);
     }
     
-    // Ye sabse important function hai - Best donor find karte hain recipient ke liye
-    Donor* findBestDonorFor(Recipient* recipient) {
-        // Pehle check karte hain ke konse blood types compatible hain
-        CustomVector<std::string> compatibleTypes = compatibility.getCompatibleDonors(recipient->bloodGroupNeeded);
-        
-        Donor* bestDonor = nullptr;
-        double minDistance = std::numeric_limits<double>::infinity(); // Sabse zyada distance se shuru
-        
-        // Sab compatible blood types ke liye
-        for (size_t i = 0; i < compatibleTypes.getSize(); ++i) {
-            CustomVector<Donor*> donors;
-            // Us blood group ke sab donors nikal te hain
-            if (donorMap.get(compatibleTypes[i], donors)) {
-                // Har donor ko check karte hain
-                for (size_t j = 0; j < donors.getSize(); ++j) {
-                    // Agar donor available hai tab hi check karte hain
-                    if (donors[j]->status == "Available") {
-                        // Dijkstra algorithm use karke distance nikal te hain
-                        // Donor ke location se recipient ke location tak
-                        auto result = locationGraph->dijkstra(donors[j]->locationNodeId, recipient->locationNodeId);
-                        
-                        // Agar ye distance pehle se chhota hai to ye best donor hai
-                        if (result.distance < minDistance) {
-                            minDistance = result.distance;
-                            bestDonor = donors[j];
+    // Radius ke andar sab available compatible donors - Emergency broadcast
+    // Sirf radiusKm ke andar wale nodes expand hote hain, bahar nahi
+    // DonorCandidate::distance = km
+    CustomVector<DonorCandidate> findDonorsWithinRadius(const std::string& neededGroup, const std::string& nodeId,
+                                                        double radiusKm) {
+        CustomVector<std::pair<std::string, double>> area = locationGraph->nodesWithin(nodeId, radiusKm);
+        return collectEligibleIn(area, neededGroup);
+    }
+    
+    // Isochrone version - departureMinute par nikle to minutesBudget ke andar
+    // pahunchne wale donors. DonorCandidate::distance = travel minutes
+    CustomVector<DonorCandidate> findDonorsWithinTime(const std::string& neededGroup, const std::string& nodeId,
+                                                      double departureMinute, double minutesBudget) {
+        CustomVector<std::pair<std::string, double>> area =
+            locationGraph->nodesWithinTime(nodeId, departureMinute, minutesBudget);
+        return collectEligibleIn(area, neededGroup);
+    }
+    
+    // Ek node par khade available compatible donors out mein add karo
+    // (limit tak). Return true agar koi mila
+    bool collectEligibleAt(const std::string& nodeId, const std::string& neededGroup, double distance,
+                           CustomVector<DonorCandidate>& out, size_t limit) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        return collectEligibleAtLocked(nodeId, neededGroup, distance, out, limit);
+    }
+    
+private:
+    // Neeche wale helpers matchLock ke andar call karo (assignRound,
+    // matchGroup, aur upar ke public wrappers)
+    
+    bool collectEligibleAtLocked(const std::string& nodeId, const std::string& neededGroup, double distance,
+                                 CustomVector<DonorCandidate>& out, size_t limit) {
+        CustomVector<Donor*> atNode;
+        if (!donorsByNode.get(nodeId, atNode)) {
+            return false;
+        }
+        bool found = false;
+        size_t i = 0;
+        for (; i < atNode.getSize() && out.getSize() < limit; ++i) {
+            Donor* d = atNode[i];
+            if (d->status == "Available" && compatibility.canDonateTo(d->bloodGroup, neededGroup)) {
+                out.push_back(DonorCandidate(d, distance));
+                found = true;
+            }
+        }
+        count(donorsScanned, i);
+        return found;
+    }
+    
+    CustomVector<DonorCandidate> topKDonors(Recipient* recipient, size_t k) {
+        CustomVector<DonorCandidate> result;
+        if (k == 0) {
+            return result;
+        }
+        
+        const std::string& neededGroup = recipient->bloodGroupNeeded;
+        LatencyMetrics::Timer searchTimer(metrics, graphSearchPhase);
+        count(searchesRun);
+        locationGraph->expandFrom(recipient->locationNodeId,
+            [&](const std::string& nodeId, double distance) {
+                if (collectEligibleAtLocked(nodeId, neededGroup, distance, result, k)) {
+                    distanceCache.remember(nodeId, recipient->locationNodeId, distance);
+                }
+                return result.getSize() < k; // k mil gaye to ruk jao
+            });
+        
+        return result;
+    }
+    
+    // Area graph se lock ke bahar nikalta hai, donors ek hi lock mein
+    CustomVector<DonorCandidate> collectEligibleIn(const CustomVector<std::pair<std::string, double>>& area,
+                                                   const std::string& neededGroup) {
+        CustomVector<DonorCandidate> result;
+        std::lock_guard<std::mutex> guard(matchLock);
+        for (size_t i = 0; i < area.getSize(); ++i) {
+            collectEligibleAtLocked(area[i].first, neededGroup, area[i].second, result,
+                                    std::numeric_limits<size_t>::max());
+        }
+        return result;
+    }
+    
+public:
+    // GROUP MATCH: Ek hi hospital ke kai requests ke liye ek shared search
+    // 1. Hospital se ek time-dependent frontier - Pool tab tak bharte hain
+    //    jab tak har needed blood group ke liye (group ke total units +
+    //    candidatePool - 1) compatible donors na mil jayein. O- jaisa donor
+    //    kisi bhi recipient ke paas ja sakta hai, is liye poora group -
+    //    Baaki sab ke le jane ke baad bhi har recipient ko candidatePool
+    //    options milte hain
+    // 2. Urgent recipients pehle: frontier order mein pehle (candidatePool
+    //    + units - 1) unassigned compatible donors. Exact donor -> hospital
+    //    travel time (memoized - recipients share karte hain) sirf un ka jin
+    //    ki coordinate lower bound (CoordinatePrefilter) ab tak ke
+    //    unitsNeeded-th best se chhoti hai - Baaki pakka bure, route nahi
+    // 3. Sabse jaldi wale unitsNeeded donors - Yehi total aur maximum
+    //    (aakhri unit ka) travel time dono minimum karte hain
+    // 4. Sab donors wahi "Busy" (reserve) aur recipient ke record mein -
+    //    Ek donor do requests ko nahi milta
+    // Result ka index = group ka index. Donor na mile to donor = nullptr
+    // matchLock ke andar - Ek request ke sab units ek saath reserve hote
+    // hain, beech mein koi doosra matcher nahi ghus sakta
+    // DEADLINE (anytime): Frontier budget ke 70% par ruk jata hai (jo donors
+    // mil chuke wahi pool), aur deadline guzarne ke baad exact route ki
+    // jagah frontier ka arrival estimate. Aisa hua to result.optimal = false
+    CustomVector<TimedMatch> matchGroup(const CustomVector<Recipient*>& group, double departureMinute,
+                                        size_t candidatePool = 8, Deadline deadline = Deadline::max()) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        LatencyMetrics::Timer matchTimer(metrics, matchingPhase);
+        count(matchesRun, group.getSize());
+        reactivateDue(EpochDays::today());
+        CustomVector<TimedMatch> result;
+        for (size_t i = 0; i < group.getSize(); ++i) result.push_back(TimedMatch());
+        if (group.empty()) return result;
+        
+        const std::string& hospital = group[0]->locationNodeId;
+        
+        // Har needed blood group ke liye kitne candidates chahiye
+        CustomVector<std::string> neededGroups;
+        CustomVector<size_t> wanted;
+        CustomVector<size_t> found;
+        for (size_t r = 0; r < group.getSize(); ++r) {
+            size_t g = 0;
+            while (g < neededGroups.getSize() && neededGroups[g] != group[r]->bloodGroupNeeded) ++g;
+            if (g == neededGroups.getSize()) {
+                neededGroups.push_back(group[r]->bloodGroupNeeded);
+                wanted.push_back(candidatePool - 1);
+                found.push_back(0);
+            }
+        }
+        size_t totalUnits = 0;
+        for (size_t r = 0; r < group.getSize(); ++r) totalUnits += unitsRemaining(group[r]);
+        for (size_t g = 0; g < wanted.getSize(); ++g) wanted[g] += totalUnits;
+        size_t satisfied = 0;
+        
+        // Frontier ka budget - Baaki 30% exact routes ke liye
+        bool bounded = deadline != Deadline::max();
+        Deadline frontierDeadline = deadline;
+        if (bounded) {
+            auto now = std::chrono::steady_clock::now();
+            frontierDeadline = deadline > now ? now + (deadline - now) * 7 / 10 : now;
+        }
+        bool truncated = false;
+        
+        // Shared frontier - Jo donor kisi bhi recipient ko de sake
+        CustomVector<Donor*> pool;
+        CustomVector<double> estimate;   // Frontier arrival (hospital se) - Fallback ETA
+        size_t settledNodes = 0;
+        size_t scanned = 0;
+        { // Sirf frontier ka waqt graph_search mein
+            LatencyMetrics::Timer searchTimer(metrics, graphSearchPhase);
+            count(searchesRun);
+            locationGraph->timeDependentExpandFrom(hospital, departureMinute,
+                [&](const std::string& nodeId, double arrival) {
+                    CustomVector<Donor*> atNode;
+                    if (donorsByNode.get(nodeId, atNode)) {
+                        scanned += atNode.getSize();
+                        for (size_t i = 0; i < atNode.getSize(); ++i) {
+                            Donor* d = atNode[i];
+                            if (d->status != "Available") continue;
+                            bool useful = false;
+                            for (size_t g = 0; g < neededGroups.getSize(); ++g) {
+                                if (!compatibility.canDonateTo(d->bloodGroup, neededGroups[g])) continue;
+                                useful = true;
+                                if (++found[g] == wanted[g]) ++satisfied;
+                            }
+                            if (useful) {
+                                pool.push_back(d);
+                                estimate.push_back(arrival - departureMinute);
+                            }
                         }
                     }
+                    if (satisfied == neededGroups.getSize()) return false;
+                    // Har 32 nodes par ghadi dekho - Budget khatam to ab tak ke donors
+                    if (bounded && ++settledNodes % 32 == 0 && std::chrono::steady_clock::now() >= frontierDeadline) {
+                        truncated = true;
+                        ++frontierCuts;
+                        return false;
+                    }
+                    return true;
+                });
+        }
+        count(donorsScanned, scanned);
+        
+        // Exact travel time - Sirf jab zarurat ho, ek dafa per candidate
+        CustomVector<double> minutes;
+        for (size_t i = 0; i < pool.getSize(); ++i) minutes.push_back(-1);
+        
+        // Lower bound ke liye coordinates - km bound x sabse tez pace = minutes bound
+        int hospitalX = 0, hospitalY = 0;
+        bool located = locationGraph->getCoordinates(hospital, hospitalX, hospitalY);
+        CustomVector<int> donorX, donorY;
+        for (size_t i = 0; i < pool.getSize(); ++i) {
+            int x = hospitalX, y = hospitalY; // Coordinates na hon to bound 0 - Kabhi prune nahi
+            locationGraph->getCoordinates(pool[i]->locationNodeId, x, y);
+            donorX.push_back(x);
+            donorY.push_back(y);
+        }
+        double minutesScale = located ? locationGraph->lowerBoundScale() * locationGraph->fastestMinutesPerKm() : 0.0;
+        
+        // Urgency order (stable insertion sort)
+        CustomVector<size_t> order;
+        for (size_t i = 0; i < group.getSize(); ++i) {
+            size_t j = order.getSize();
+            order.push_back(i);
+            while (j > 0 && group[order[j - 1]]->getUrgencyPriority() > group[i]->getUrgencyPriority()) {
+                order[j] = order[j - 1];
+                --j;
+            }
+            order[j] = i;
+        }
+        
+        for (size_t k = 0; k < order.getSize(); ++k) {
+            size_t r = order[k];
+            size_t need = unitsRemaining(group[r]);
+            if (need == 0) continue;
+            
+            // Considered candidates - Frontier order mein, coordinates prefilter mein
+            CustomVector<size_t> considered;
+            CoordinatePrefilter prefilter;
+            for (size_t i = 0; i < pool.getSize() && considered.getSize() < candidatePool + need - 1; ++i) {
+                if (pool[i]->status != "Available") continue; // Pehle assign ho chuka
+                if (!compatibility.canDonateTo(pool[i]->bloodGroup, group[r]->bloodGroupNeeded)) continue;
+                considered.push_back(i);
+                prefilter.add(donorX[i], donorY[i]);
+            }
+            prefilter.computeBounds(hospitalX, hospitalY, minutesScale);
+            
+            // Chhoti bound pehle - Picks ETA ke hisaab se sorted (insertion
+            // sort, sirf need rakhte hain). need picks ke baad cutoff = aakhri
+            // pick ka ETA; jis ki bound us se zyada woh kabhi pick nahi hota
+            CustomVector<size_t> picks;
+            size_t next, examined = 0;
+            while (prefilter.next(picks.getSize() < need ? std::numeric_limits<double>::infinity()
+                                                         : minutes[picks[need - 1]], next)) {
+                size_t i = considered[next];
+                ++examined;
+                if (minutes[i] < 0) {
+                    if (bounded && std::chrono::steady_clock::now() >= deadline) {
+                        // Deadline guzar gayi - Frontier ka estimate hi sahi
+                        minutes[i] = estimate[i];
+                        truncated = true;
+                        ++estimatedRoutes;
+                    } else {
+                        LatencyMetrics::Timer searchTimer(metrics, graphSearchPhase);
+                        count(searchesRun);
+                        minutes[i] = locationGraph->timeDependentRoute(pool[i]->locationNodeId, hospital,
+                                                                       departureMinute).travelMinutes();
+                    }
+                }
+                size_t j = picks.getSize();
+                picks.push_back(i);
+                while (j > 0 && minutes[picks[j - 1]] > minutes[i]) {
+                    picks[j] = picks[j - 1];
+                    --j;
                 }
+                picks[j] = i;
+                if (picks.getSize() > need) picks.pop_back();
+            }
+            ++prefilterSearches;
+            prefilterCandidates += considered.getSize();
+            prefilterQueries += examined;
+            
+            // Sabse jaldi wale need donors - Ek saath reserve
+            for (size_t p = 0; p < picks.getSize() && p < need; ++p) {
+                Donor* d = pool[picks[p]];
+                reserve(group[r], d); // "Busy" - Double booking nahi
+                result[r].units.push_back(ReservedUnit(d, minutes[picks[p]]));
             }
+            if (!result[r].units.empty()) {
+                result[r].donor = result[r].units[0].donor;
+                result[r].travelMinutes = result[r].units[0].travelMinutes;
+            }
+        }
+        
+        if (bounded) {
+            deadlineRequests += group.getSize();
+            if (truncated) deadlineTruncated += group.getSize();
+        }
+        for (size_t r = 0; r < group.getSize(); ++r) result[r].optimal = !truncated;
+        return result;
+    }
+    
+    // Urgency weight - Immediate ka ek km, Low ke chaar km jitna bhaari
+    static double urgencyWeight(const Recipient* recipient) {
+        int priority = recipient->getUrgencyPriority();
+        return priority >= 4 ? 1.0 : static_cast<double>(5 - priority);
+    }
+    
+    // Queue se sab "Pending" recipients - Matched/Completed/Cancelled wale
+    // queue se hat jate hain (dobara nahi aate)
+    CustomVector<Recipient*> collectPendingRecipients() {
+        std::lock_guard<std::mutex> guard(queueLock);
+        CustomVector<Recipient*> pending;
+        CustomVector<Recipient*> keep;
+        while (!recipientQueue.empty()) {
+            Recipient* r = recipientQueue.top();
+            recipientQueue.pop();
+            if (r->status == "Pending") pending.push_back(r);
+            if (r->status == "Pending" || r->status == "Searching") keep.push_back(r);
         }
+        for (size_t i = 0; i < keep.getSize(); ++i) recipientQueue.push(keep[i]);
+        return pending; // Urgency order mein
+    }
+    
+    // Ek assignment round - pending ko candidate graph par solve karke
+    // assign karo. Har baaki unit ek row (same recipient ki rows same
+    // candidates share karti hain, solver alag donors deta hai).
+    // leftovers = jin ke units reh gaye magar candidate list poori bhari
+    // thi (aage aur donors ho sakte hain)
+    void assignRound(const CustomVector<Recipient*>& pending, size_t candidatesPerRecipient,
+                     AssignmentReport& report, CustomVector<Recipient*>& leftovers) {
+        auto started = std::chrono::steady_clock::now();
         
-        return bestDonor; // Sabse paas wala donor return karte hain
+        // Ek hospital ke recipients same nearest donors dekhte hain - Har
+        // list mein (k + us hospital ke baaki units) donors, taake sab
+        // ke le jane ke baad bhi har recipient ke paas k options hon
+        CustomHashMap<std::string, size_t> loadAt; // nodeId -> units
+        CustomVector<size_t> rowOwner;             // Row -> pending index
+        for (size_t r = 0; r < pending.getSize(); ++r) {
+            size_t units = unitsRemaining(pending[r]);
+            size_t count = 0;
+            loadAt.get(pending[r]->locationNodeId, count);
+            loadAt.insert(pending[r]->locationNodeId, count + units);
+            for (size_t u = 0; u < units; ++u) rowOwner.push_back(r);
+        }
+        
+        // Candidate graph - Donor id -> column
+        CustomHashMap<std::string, int> columnOf;
+        CustomVector<Donor*> columns;
+        CustomVector<CustomVector<DonorCandidate>> candidates;
+        CustomVector<bool> truncated;   // List limit tak bhari thi?
+        CustomHashMap<std::string, CustomVector<DonorCandidate>> shared; // "node|group" -> donors
+        for (size_t r = 0; r < pending.getSize(); ++r) {
+            size_t load = 0;
+            loadAt.get(pending[r]->locationNodeId, load);
+            size_t limit = candidatesPerRecipient + load - 1;
+            std::string key = pending[r]->locationNodeId + "|" + pending[r]->bloodGroupNeeded;
+            CustomVector<DonorCandidate> list;
+            if (!shared.get(key, list)) {
+                list = topKDonors(pending[r], limit); // matchLock pehle se hai
+                shared.insert(key, list);
+            }
+            for (size_t i = 0; i < list.getSize(); ++i) {
+                int column = -1;
+                if (!columnOf.get(list[i].donor->id, column)) {
+                    column = static_cast<int>(columns.getSize());
+                    columns.push_back(list[i].donor);
+                    columnOf.insert(list[i].donor->id, column);
+                }
+            }
+            candidates.push_back(list);
+            truncated.push_back(list.getSize() == limit);
+            report.candidateEdges += list.getSize() * unitsRemaining(pending[r]);
+        }
+        report.donorsConsidered += columns.getSize();
+        
+        auto built = std::chrono::steady_clock::now();
+        
+        MinCostAssignment solver(rowOwner.getSize(), columns.getSize());
+        for (size_t row = 0; row < rowOwner.getSize(); ++row) {
+            size_t r = rowOwner[row];
+            double weight = urgencyWeight(pending[r]);
+            solver.setUnassignedCost(row, UNASSIGNED_PENALTY_KM * weight);
+            for (size_t i = 0; i < candidates[r].getSize(); ++i) {
+                int column = -1;
+                columnOf.get(candidates[r][i].donor->id, column);
+                solver.addCandidate(row, column, candidates[r][i].distance * weight);
+            }
+        }
+        solver.solve();
+        MinCostAssignment::Stats stats = solver.getLastStats();
+        report.solverStats.augmentations += stats.augmentations;
+        report.solverStats.scannedColumns += stats.scannedColumns;
+        report.solverStats.reassignments += stats.reassignments;
+        
+        auto solved = std::chrono::steady_clock::now();
+        report.candidateMicros += std::chrono::duration_cast<std::chrono::microseconds>(built - started).count();
+        report.solveMicros += std::chrono::duration_cast<std::chrono::microseconds>(solved - built).count();
+        
+        // Assignment apply - Reservation
+        for (size_t row = 0; row < rowOwner.getSize(); ++row) {
+            size_t r = rowOwner[row];
+            int column = solver.assignedColumn(row);
+            if (column < 0) continue;
+            Donor* donor = columns[column];
+            double distance = 0;
+            for (size_t i = 0; i < candidates[r].getSize(); ++i) {
+                if (candidates[r][i].donor == donor) distance = candidates[r][i].distance;
+            }
+            reserve(pending[r], donor);
+            report.recipients.push_back(pending[r]);
+            report.donors.push_back(DonorCandidate(donor, distance));
+        }
+        for (size_t r = 0; r < pending.getSize(); ++r) {
+            if (unitsRemaining(pending[r]) == 0) {
+                pending[r]->status = "Matched";
+            } else if (truncated[r]) {
+                leftovers.push_back(pending[r]);
+            }
+            requestChanged(pending[r]); // Kuch nahi badla to feed khud chhod deti hai
+        }
+    }
+    
+    // GLOBAL ASSIGNMENT: Queue ke sab pending recipients ek saath
+    // Greedy har request ko alag dekhta hai - Mass-casualty mein pehla
+    // recipient woh donor le leta hai jo baad wale ka akela option tha.
+    // 1. Har recipient ke liye nearest available compatible donors - k +
+    //    us hospital ka load (frontier search, same hospital + blood group
+    //    wale ek hi list share karte hain)
+    // 2. Sparse candidate graph: har baaki unit ek row, cost = km x urgency
+    //    weight, aur har unit ka unmatched option = UNASSIGNED_PENALTY_KM x weight
+    // 3. MinCostAssignment - Total weighted cost minimum
+    // 4. Reserved donors "Busy"; sab units mil gaye to recipient "Matched",
+    //    warna "Pending" (agle pass mein baaki units)
+    // Donor kam hon to doosre hospitals list ke donors le ja sakte hain -
+    // Jo reh gaye (aur list bhari thi) un ka agla round, bache donors par
+    AssignmentReport assignPendingRecipients(size_t candidatesPerRecipient = 16, size_t maxRounds = 4) {
+        std::lock_guard<std::mutex> guard(matchLock);
+        LatencyMetrics::Timer matchTimer(metrics, matchingPhase);
+        reactivateDue(EpochDays::today());
+        AssignmentReport report;
+        CustomVector<Recipient*> pending = collectPendingRecipients();
+        report.pending = pending.getSize();
+        count(matchesRun, pending.getSize());
+        for (size_t r = 0; r < pending.getSize(); ++r) report.unitsRequested += unitsRemaining(pending[r]);
+        
+        for (size_t round = 0; round < maxRounds && !pending.empty(); ++round) {
+            CustomVector<Recipient*> leftovers;
+            size_t matchedBefore = report.recipients.getSize();
+            assignRound(pending, candidatesPerRecipient, report, leftovers);
+            ++report.rounds;
+            if (report.recipients.getSize() == matchedBefore) break; // Koi progress nahi
+            pending = leftovers;
+        }
+        
+        // Total cost - Sab rounds ke baad
+        report.totalCost = 0;
+        for (size_t i = 0; i < report.recipients.getSize(); ++i) {
+            report.totalCost += report.donors[i].distance * urgencyWeight(report.recipients[i]);
+        }
+        CustomVector<Recipient*> all = collectPendingRecipients();
+        for (size_t i = 0; i < all.getSize(); ++i) {
+            report.totalCost += UNASSIGNED_PENALTY_KM * urgencyWeight(all[i]) * unitsRemaining(all[i]);
+        }
+        return report;
+    }
+    
+    // Do locations ke beech distance - Cache ke through (route/ETA step)
+    double distanceBetween(const std::string& from, const std::string& to) {
+        return distanceCache.distance(from, to);
+    }
+    
+    // Road ka weight badlo (congestion/detour) - Cached hospital trees
+    // poora recompute nahi, sirf affected subtree repair hota hai
+    bool updateRoad(const std::string& from, const std::string& to, double weight) {
+        std::lock_guard<std::mutex> guard(roadUpdateLock);
+        double oldWeight;
+        if (!locationGraph->updateEdgeWeight(from, to, weight, &oldWeight)) {
+            return false;
+        }
+        distanceCache.edgeChanged(from, to, oldWeight, weight);
+        return true;
+    }
+    
+    // Road band (closure) - Weight infinity, phir same repair
+    bool closeRoad(const std::string& from, const std::string& to) {
+        return updateRoad(from, to, std::numeric_limits<double>::infinity());
+    }
+    
+    // Cache access - Stats aur all-pairs mode ke liye
+    DistanceCache& getDistanceCache() {
+        return distanceCache;
     }
     
     // Match karne mein kitna time lagega ye estimate karte hain
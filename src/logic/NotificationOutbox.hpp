@@ -0,0 +1,393 @@
+#ifndef NOTIFICATION_OUTBOX_HPP
+#define NOTIFICATION_OUTBOX_HPP
+
+#include "../dsa/CustomHashMap.hpp"
+#include "../dsa/CustomPriorityQueue.hpp"
+#include "../dsa/CustomVector.hpp"
+#include "CSVHandler.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// ==================== NOTIFICATION OUTBOX BASICS ====================
+// SMS/push gateway ki call 50-500 ms leti hai, aur kabhi fail. Handler
+// (match, broadcast, reminder) us ka intezar kare to request atak jati hai.
+// Is liye handler sirf enqueue() karta hai - Lock, push, return (microseconds).
+//
+// Apne worker threads:
+//   1. Jo messages "due" hain un mein se batchSize tak ek batch - Pehla
+//      message due hone ke baad `linger` (e.g. 5 ms) tak aur aane do, jab
+//      tak batch bhar na jaye (MatchBatcher ki window jaisa). 10k/s par
+//      ek call mein ~50 messages, har message ki alag call nahi
+//   2. Batch journal mein (pehli dafa) - Restart par bhi nahi khoye
+//   3. Gateway ki ek call poori batch ke liye
+//   4. Delivered -> journal mein "D". Fail -> attempts++, aur
+//      due = ab + base * 2^(attempts-1) (max tak, thoda jitter taake
+//      sab retries ek saath gateway par na girein). maxAttempts ke baad dead
+//
+// JOURNAL (append-only CSV):
+//   E,<id>,<donorId>,<to>,<channel>,<kind>,<text>   - Naya message
+//   D,<id>                                         - Delivered
+//   X,<id>                                         - Dead (retries khatam)
+// Startup par replay: jin E ka D/X nahi woh dobara queue mein. Phir file
+// sirf unhi se dobara likhi jati hai (compaction) - Chalte hue bhi jab
+// bahut saari D lines jama ho jayein.
+// Enqueue aur pehli batch ke beech (milliseconds) crash ho to woh message
+// journal mein nahi - Handler ko disk par block na karne ki qeemat
+// ======================================================================
+
+struct Notification {
+    unsigned long id;
+    std::string donorId;
+    std::string to;        // Phone number (SMS) ya push token
+    std::string channel;   // "sms" / "push"
+    std::string kind;      // "match", "dispatch", "emergency", "reminder"
+    std::string text;
+    int attempts;
+    std::chrono::steady_clock::time_point due;
+    bool journaled;
+    Notification() : id(0), attempts(0), journaled(false) {}
+};
+
+class NotificationOutbox {
+public:
+    // GATEWAY: Poori batch bhejo, delivered[i] = batch[i] pahuncha ya nahi
+    // (delivered pehle se batch jitna, sab false). Exception = sab fail
+    typedef std::function<void(const CustomVector<Notification*>& batch, CustomVector<bool>& delivered)> Gateway;
+
+    struct Stats {
+        unsigned long enqueued;
+        unsigned long delivered;
+        unsigned long retried;          // Fail hue attempts (dobara schedule)
+        unsigned long dead;             // maxAttempts ke baad chhod diye
+        unsigned long gatewayCalls;
+        unsigned long recovered;        // Startup par journal se wapas
+        size_t pending;                 // Abhi undelivered (queue + in flight)
+        double gatewayMsSum;
+        Stats() : enqueued(0), delivered(0), retried(0), dead(0), gatewayCalls(0), recovered(0),
+                  pending(0), gatewayMsSum(0) {}
+        double avgBatch() const { return gatewayCalls ? static_cast<double>(delivered + retried + dead) / gatewayCalls : 0.0; }
+        double avgGatewayMs() const { return gatewayCalls ? gatewayMsSum / gatewayCalls : 0.0; }
+    };
+
+private:
+    struct EarliestDueFirst {
+        bool operator()(const Notification* a, const Notification* b) const {
+            if (a->due != b->due) return a->due < b->due;
+            return a->id < b->id;
+        }
+    };
+
+    Gateway gateway;
+    std::string journalPath;
+    size_t workerCount;
+    size_t batchSize;
+    std::chrono::milliseconds linger;
+    std::chrono::milliseconds baseBackoff;
+    std::chrono::milliseconds maxBackoff;
+    int maxAttempts;
+    unsigned long compactEvery;     // Itni D/X lines ke baad compaction
+
+    std::mutex lock;                // queue, live, stats, nextId
+    std::condition_variable ready;
+    CustomPriorityQueue<Notification*, EarliestDueFirst> queue;
+    CustomHashMap<unsigned long, Notification*> live; // Sab undelivered (queue + in flight)
+    size_t queuedFresh;             // Queue mein pehli koshish wale - Yeh aate hi due hain
+    unsigned long nextId;
+    bool stopping;
+    Stats stats;
+
+    std::mutex journalLock;         // File sirf is ke andar
+    std::ofstream journal;
+    unsigned long closedSinceCompact;
+
+    CustomVector<std::thread*> workers;
+
+    static std::string entryLine(const Notification* n) {
+        std::string text = n->text;
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (text[i] == '\n' || text[i] == '\r') text[i] = ' '; // Ek message = ek line
+        }
+        std::ostringstream line;
+        line << "E," << n->id << ',' << CSVHandler::escape(n->donorId) << ',' << CSVHandler::escape(n->to) << ','
+             << CSVHandler::escape(n->channel) << ',' << CSVHandler::escape(n->kind) << ','
+             << CSVHandler::escape(text) << '\n';
+        return line.str();
+    }
+
+    std::chrono::milliseconds backoffFor(int attempts) {
+        long long delay = baseBackoff.count();
+        for (int i = 1; i < attempts && delay < maxBackoff.count(); ++i) delay *= 2;
+        if (delay > maxBackoff.count()) delay = maxBackoff.count();
+        // Aadha fixed, aadha random - Retries phail jate hain
+        thread_local std::mt19937 rng(std::random_device{}());
+        std::uniform_int_distribution<long long> jitter(0, delay / 2);
+        return std::chrono::milliseconds(delay - delay / 2 + jitter(rng));
+    }
+
+    // JOURNAL REPLAY: Jo E bina D/X ke - Queue mein wapas (constructor se)
+    void recover() {
+        std::ifstream in(journalPath);
+        if (!in.is_open()) return;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.size() < 3) continue;
+            CustomVector<std::string> fields = CSVHandler::splitCSV(line);
+            if (fields.getSize() < 2) continue;
+            unsigned long id = std::strtoul(fields[1].c_str(), nullptr, 10);
+            if (fields[0] == "E" && fields.getSize() >= 7) {
+                Notification* n = new Notification();
+                n->id = id;
+                n->donorId = fields[2];
+                n->to = fields[3];
+                n->channel = fields[4];
+                n->kind = fields[5];
+                n->text = fields[6];
+                n->journaled = true;
+                Notification* old = nullptr;
+                if (live.get(id, old)) delete old;
+                live.insert(id, n);
+            } else if (fields[0] == "D" || fields[0] == "X") {
+                Notification* n = nullptr;
+                if (live.get(id, n)) {
+                    live.remove(id);
+                    delete n;
+                }
+            }
+            if (id >= nextId) nextId = id + 1;
+        }
+        in.close();
+
+        CustomVector<unsigned long> ids = live.getKeys();
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ids.getSize(); ++i) {
+            Notification* n = nullptr;
+            live.get(ids[i], n);
+            n->due = now;
+            queue.push(n);
+            ++queuedFresh;
+        }
+        stats.recovered = ids.getSize();
+    }
+
+    // COMPACTION: Sirf undelivered ki E lines - tmp file, phir rename
+    // journalLock ke andar call karo (live ke liye lock bhi yahin)
+    void compactLocked() {
+        if (journalPath.empty()) return;
+        std::string tmpPath = journalPath + ".tmp";
+        std::ofstream out(tmpPath, std::ios::trunc);
+        if (!out.is_open()) return;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            CustomVector<unsigned long> ids = live.getKeys();
+            for (size_t i = 0; i < ids.getSize(); ++i) {
+                Notification* n = nullptr;
+                live.get(ids[i], n);
+                // Worker ne abhi journal nahi kiya - Woh khud likhega
+                if (n->journaled) out << entryLine(n);
+            }
+        }
+        out.close();
+        if (journal.is_open()) journal.close();
+        std::remove(journalPath.c_str());
+        std::rename(tmpPath.c_str(), journalPath.c_str());
+        journal.open(journalPath, std::ios::app);
+        closedSinceCompact = 0;
+    }
+
+    void appendJournal(const std::string& lines, unsigned long closed) {
+        std::lock_guard<std::mutex> guard(journalLock);
+        if (!lines.empty() && journal.is_open()) {
+            journal << lines;
+            journal.flush();
+        }
+        closedSinceCompact += closed;
+        if (compactEvery && closedSinceCompact >= compactEvery) compactLocked();
+    }
+
+    void workerLoop() {
+        CustomVector<Notification*> batch;
+        CustomVector<bool> delivered;
+        CustomVector<bool> fresh;     // Is batch mein pehli dafa
+        while (true) {
+            batch.clear();
+            fresh.clear();
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                while (!stopping) {
+                    if (queue.empty()) {
+                        ready.wait(guard);
+                        continue;
+                    }
+                    // Sabse pehla message bhi abhi due nahi (retry backoff) to
+                    // kuch bhejne ko nahi - Bhari queue ho tab bhi uske due tak ruko.
+                    // Batch "bhara" sirf naye messages se ginte hain: backoff wale
+                    // queue mein hon to bhi abhi due nahi, linger unpar bhi lage
+                    std::chrono::steady_clock::time_point due = queue.top()->due;
+                    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                    if (due > now) {
+                        ready.wait_until(guard, due); // Agla retry
+                    } else if (queuedFresh >= batchSize || due + linger <= now) {
+                        break;
+                    } else {
+                        ready.wait_until(guard, due + linger); // Batch window
+                    }
+                }
+                if (stopping) return; // Undelivered journal mein hain - Agli dafa
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                while (batch.getSize() < batchSize && !queue.empty() && queue.top()->due <= now) {
+                    batch.push_back(queue.top());
+                    queue.pop();
+                    if (batch[batch.getSize() - 1]->attempts == 0) --queuedFresh;
+                }
+                // Neeche E line likhni hai - Flag abhi, taake compaction aur
+                // hum dono na chhodein (dobara E replay mein bekaar nahi)
+                for (size_t i = 0; i < batch.getSize(); ++i) {
+                    fresh.push_back(!batch[i]->journaled);
+                    batch[i]->journaled = true;
+                }
+            }
+            if (batch.empty()) continue; // Khaali batch gateway par kabhi nahi
+            // Aur bhi due hon to doosra worker utha le
+            ready.notify_one();
+
+            // Pehli koshish se pehle disk par
+            std::string entries;
+            for (size_t i = 0; i < batch.getSize(); ++i) {
+                if (fresh[i]) entries += entryLine(batch[i]);
+            }
+            if (!entries.empty()) appendJournal(entries, 0);
+
+            delivered.clear();
+            for (size_t i = 0; i < batch.getSize(); ++i) delivered.push_back(false);
+            std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+            try {
+                gateway(batch, delivered);
+            } catch (...) {
+                for (size_t i = 0; i < delivered.getSize(); ++i) delivered[i] = false;
+            }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+            std::string closedLines;
+            unsigned long closed = 0;
+            CustomVector<Notification*> finished;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                ++stats.gatewayCalls;
+                stats.gatewayMsSum += ms;
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < batch.getSize(); ++i) {
+                    Notification* n = batch[i];
+                    ++n->attempts;
+                    if (delivered[i] || n->attempts >= maxAttempts) {
+                        closedLines += (delivered[i] ? "D," : "X,") + std::to_string(n->id) + "\n";
+                        ++closed;
+                        ++(delivered[i] ? stats.delivered : stats.dead);
+                        live.remove(n->id);
+                        finished.push_back(n);
+                    } else {
+                        ++stats.retried;
+                        n->due = now + backoffFor(n->attempts);
+                        queue.push(n);
+                    }
+                }
+            }
+            ready.notify_one();
+            appendJournal(closedLines, closed);
+            for (size_t i = 0; i < finished.getSize(); ++i) delete finished[i];
+        }
+    }
+
+public:
+    // journalPath khaali = persistence nahi (benchmark)
+    NotificationOutbox(const Gateway& sender, const std::string& journalFile, size_t threads = 2,
+                       size_t maxBatch = 100, std::chrono::milliseconds lingerFor = std::chrono::milliseconds(5),
+                       std::chrono::milliseconds backoff = std::chrono::milliseconds(500),
+                       std::chrono::milliseconds backoffCap = std::chrono::minutes(5), int attemptsAllowed = 8,
+                       unsigned long compactAfter = 50000)
+        : gateway(sender), journalPath(journalFile), workerCount(threads ? threads : 1),
+          batchSize(maxBatch ? maxBatch : 1), linger(lingerFor), baseBackoff(backoff), maxBackoff(backoffCap),
+          maxAttempts(attemptsAllowed > 0 ? attemptsAllowed : 1), compactEvery(compactAfter),
+          queuedFresh(0), nextId(1), stopping(false), closedSinceCompact(0) {
+        if (!journalPath.empty()) {
+            recover();
+            std::lock_guard<std::mutex> guard(journalLock);
+            compactLocked(); // Purani D/X lines hata do
+        }
+    }
+
+    ~NotificationOutbox() {
+        stop();
+        CustomVector<unsigned long> ids = live.getKeys();
+        for (size_t i = 0; i < ids.getSize(); ++i) {
+            Notification* n = nullptr;
+            if (live.get(ids[i], n)) delete n;
+        }
+    }
+
+    // Workers shuru - Recovered messages foran bhejne lagte hain
+    void start() {
+        for (size_t i = 0; i < workerCount; ++i) {
+            workers.push_back(new std::thread(&NotificationOutbox::workerLoop, this));
+        }
+    }
+
+    // Workers rok do (chal rahi gateway call poori hone ke baad)
+    void stop() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (stopping) return;
+            stopping = true;
+        }
+        ready.notify_all();
+        for (size_t i = 0; i < workers.getSize(); ++i) {
+            workers[i]->join();
+            delete workers[i];
+        }
+        workers.clear();
+    }
+
+    // ENQUEUE: Handler se - Sirf lock aur push, gateway/disk ka intezar nahi
+    // Return = message id
+    unsigned long enqueue(const std::string& donorId, const std::string& to, const std::string& channel,
+                          const std::string& kind, const std::string& text) {
+        Notification* n = new Notification();
+        n->donorId = donorId;
+        n->to = to;
+        n->channel = channel;
+        n->kind = kind;
+        n->text = text;
+        n->due = std::chrono::steady_clock::now();
+        unsigned long id;
+        bool wake;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            id = n->id = nextId++;
+            live.insert(id, n);
+            queue.push(n);
+            ++queuedFresh;
+            ++stats.enqueued;
+            // Worker ko sirf tab jagao jab window shuru ho ya batch bhar gaya -
+            // Har enqueue par wake-up nahi
+            wake = queue.size() == 1 || queuedFresh % batchSize == 0 || queue.top() == n;
+        }
+        if (wake) ready.notify_one();
+        return id; // n ab worker ka - Deliver hote hi delete
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> guard(lock);
+        Stats s = stats;
+        s.pending = live.getSize();
+        return s;
+    }
+};
+
+#endif // NOTIFICATION_OUTBOX_HPP
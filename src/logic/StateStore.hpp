@@ -0,0 +1,409 @@
+#ifndef STATE_STORE_HPP
+#define STATE_STORE_HPP
+
+#include "../dsa/CustomHashMap.hpp"
+#include "../dsa/CustomLinkedList.hpp"
+#include "../dsa/CustomVector.hpp"
+#include "../dsa/PersistentHashMap.hpp"
+#include "../models/Models.hpp"
+#include "CSVHandler.hpp"
+#include "LatencyMetrics.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+// ==================== STATE STORE BASICS ====================
+// Donors/recipients ke maps, id counters aur transaction history - Pehle
+// har handler thread inhein seedha badalta tha (donorCounter++ do threads
+// par ek saath = ek hi id do donors ko). Ab in sab ka ek hi maalik:
+//
+//   WRITER THREAD (actor) - Commands ki queue, aane ke order mein ek ek
+//   kar ke chalti hain. Koi aur thread state nahi chhoota, is liye har
+//   write linearizable - Jis order mein queue mein gaye usi mein hue
+//
+//   execute(cmd) - Command bhejo aur uske publish hone tak ruko (result
+//                  wapas). Wapas aate hi isi thread ki snapshot() mein dikhega
+//   executeThen(cmd, then) - Ruko mat: publish (aur CSV save) ke baad
+//                  writer hi then(result) chalata hai - HTTP response wahin
+//                  se poora, koi pool thread promise par khada nahi
+//   post(cmd)    - Bhejo aur bhool jao (engine ke listeners - Woh matchLock
+//                  ke andar hain, ruk nahi sakte)
+//
+//   SNAPSHOT - Writer har batch ke baad ek naya immutable snapshot publish
+//   karta hai: badle hue donors/recipients ki copies (shared_ptr<const>).
+//   Readers (dashboard, login, health) koi lock nahi lete - Thread ka
+//   cache kiya hua snapshot, sirf version badle to naya uthao
+//
+// Queue mein jitne commands jama hon sab ek batch - Unke CSV saves bhi
+// ek hi dafa (10 status updates = ek saveAllDonors, 10 nahi)
+// =============================================================
+
+// SNAPSHOT ENTRY: id -> (immutable copy, live pointer, version)
+template<typename T>
+struct SnapshotEntry {
+    std::shared_ptr<const T> view;   // Publish ke waqt ki copy - Kabhi nahi badlegi
+    T* live;                         // Engine ke liye (matching, timers) - Sirf writer/engine badlein
+    // Jis snapshot mein ye copy bani - Har touch (har tabdeeli) par naya, aur
+    // pichhle se bada. Wahi version = wahi data (response caches ki key)
+    unsigned long version;
+    SnapshotEntry() : live(nullptr), version(0) {}
+    SnapshotEntry(const std::shared_ptr<const T>& v, T* l, unsigned long ver) : view(v), live(l), version(ver) {}
+};
+
+class StateStore {
+public:
+    typedef SnapshotEntry<Donor> DonorEntry;
+    typedef SnapshotEntry<Recipient> RecipientEntry;
+
+    // Readers ke liye - Publish hone ke baad kabhi nahi badalta. Maps
+    // persistent (HAMT) hain - Snapshot mein unki copy sirf root pointer
+    struct Snapshot {
+        PersistentHashMap<std::string, DonorEntry> donors;
+        PersistentHashMap<std::string, RecipientEntry> recipients;
+        size_t transactions;
+        unsigned long version;
+        Snapshot() : transactions(0), version(0) {}
+    };
+
+    // WRITER KI STATE - Sirf commands ke andar (writer thread) haath lagao
+    class State {
+        friend class StateStore;
+        CustomHashMap<std::string, Donor*> donors;
+        CustomHashMap<std::string, Recipient*> recipients;
+        CustomLinkedList<Transaction*> transactions;   // Naya pehle
+        int donorCounter;
+        int recipientCounter;
+        int transactionCounter;
+        // Is batch mein badle - Publish par inki nayi copies (do dafa aaye to
+        // bhi theek, baad wali copy jeet'ti hai). Map nahi: Load ke 30k touch
+        // ke baad uske khaali buckets har publish par scan hote
+        CustomVector<Donor*> touchedDonors;
+        CustomVector<Recipient*> touchedRecipients;
+        bool donorsDirty;
+        bool recipientsDirty;
+
+        State() : donorCounter(1), recipientCounter(1), transactionCounter(1),
+                  donorsDirty(false), recipientsDirty(false) {}
+
+        static std::string makeId(const std::string& prefix, int number) {
+            std::stringstream ss;
+            ss << prefix << std::setfill('0') << std::setw(3) << number;
+            return ss.str();
+        }
+
+        // CSV se aaye id (DON-042) ke baad wala number agla ho
+        static void bump(int& counter, const std::string& id) {
+            if (id.size() <= 4) return;
+            int number = std::atoi(id.c_str() + 4);
+            if (number >= counter) counter = number + 1;
+        }
+
+    public:
+        std::string nextDonorId() { return makeId("DON-", donorCounter++); }
+        std::string nextRecipientId() { return makeId("REC-", recipientCounter++); }
+        std::string nextTransactionId() { return "TRN-" + std::to_string(transactionCounter++); }
+
+        void addDonor(Donor* donor) {
+            donors.insert(donor->id, donor);
+            bump(donorCounter, donor->id);
+            touch(donor);
+        }
+
+        void addRecipient(Recipient* recipient) {
+            recipients.insert(recipient->id, recipient);
+            bump(recipientCounter, recipient->id);
+            touch(recipient);
+        }
+
+        void addTransaction(Transaction* transaction) {
+            transactions.push_front(transaction);
+            bump(transactionCounter, transaction->id);
+        }
+
+        Donor* donor(const std::string& id) const {
+            Donor* d = nullptr;
+            donors.get(id, d);
+            return d;
+        }
+
+        Recipient* recipient(const std::string& id) const {
+            Recipient* r = nullptr;
+            recipients.get(id, r);
+            return r;
+        }
+
+        // Badla - Agle snapshot mein nayi copy
+        void touch(Donor* donor) { touchedDonors.push_back(donor); }
+        void touch(Recipient* recipient) { touchedRecipients.push_back(recipient); }
+        void touchDonor(const std::string& id) {
+            Donor* d = donor(id);
+            if (d) touch(d);
+        }
+        void touchRecipient(const std::string& id) {
+            Recipient* r = recipient(id);
+            if (r) touch(r);
+        }
+
+        // Poori file dobara - Batch ke aakhir mein ek dafa
+        void saveDonors() { donorsDirty = true; }
+        void saveRecipients() { recipientsDirty = true; }
+
+        size_t donorCount() const { return donors.getSize(); }
+        size_t recipientCount() const { return recipients.getSize(); }
+        size_t transactionCount() const { return transactions.getSize(); }
+    };
+
+    typedef std::function<void(State&)> Command;
+    // Live objects ki copy banate waqt - Engine bhi inhein badalta hai
+    // (status, reservations), is liye copy uske lock ke andar
+    typedef std::function<void(const std::function<void()>&)> CopyGuard;
+
+    struct Stats {
+        unsigned long commands;
+        unsigned long batches;
+        unsigned long maxBatch;
+        unsigned long donorSaves;
+        unsigned long recipientSaves;
+        double publishMicrosSum;
+        unsigned long version;
+        Stats() : commands(0), batches(0), maxBatch(0), donorSaves(0), recipientSaves(0),
+                  publishMicrosSum(0), version(0) {}
+        double avgBatch() const { return batches ? static_cast<double>(commands) / batches : 0.0; }
+        double avgPublishMicros() const { return batches ? publishMicrosSum / batches : 0.0; }
+    };
+
+private:
+    struct Pending {
+        Command apply;
+        std::promise<void>* published;   // execute() yahan ruka hai (post = nullptr)
+        std::function<void()> then;      // executeThen() - Publish ke baad writer par
+        Pending(const Command& c, std::promise<void>* p, const std::function<void()>& t = std::function<void()>())
+            : apply(c), published(p), then(t) {}
+    };
+
+    State state;
+    // Readers wale maps ka taaza version - Writer inhein path-copy se
+    // badalta hai, publish par snapshot mein inki O(1) copy
+    PersistentHashMap<std::string, DonorEntry> donorViews;
+    PersistentHashMap<std::string, RecipientEntry> recipientViews;
+    std::string donorsPath;
+    std::string recipientsPath;
+    CopyGuard copyGuard;
+
+    std::mutex queueLock;
+    std::condition_variable wake;
+    CustomVector<Pending*> queue;
+    bool stopping;
+    std::thread* writer;
+    std::thread::id writerId;
+
+    std::shared_ptr<const Snapshot> current;     // std::atomic_load/store se
+    std::atomic<unsigned long> publishedVersion{0};
+    Stats stats;                                 // queueLock ke andar
+    // /metrics persistence phase - Writer chalte hue attach hota hai, is liye atomic
+    std::atomic<LatencyMetrics*> metrics{nullptr};
+    LatencyMetrics::Series persistencePhase = -1;
+
+    void enqueue(Pending* pending) {
+        {
+            std::lock_guard<std::mutex> guard(queueLock);
+            queue.push_back(pending);
+        }
+        wake.notify_one();
+    }
+
+    // Touched objects ki copies -> naya snapshot. Kaam touched entries
+    // jitna (har ek ~log32(n) nodes), map ke size se nahi
+    void publish() {
+        std::shared_ptr<const Snapshot> base = std::atomic_load(&current);
+        unsigned long version = base->version + 1;
+        auto copy = [&] {
+            for (size_t i = 0; i < state.touchedDonors.getSize(); ++i) {
+                Donor* d = state.touchedDonors[i];
+                donorViews.insert(d->id, DonorEntry(std::make_shared<const Donor>(*d), d, version));
+            }
+            for (size_t i = 0; i < state.touchedRecipients.getSize(); ++i) {
+                Recipient* r = state.touchedRecipients[i];
+                recipientViews.insert(r->id, RecipientEntry(std::make_shared<const Recipient>(*r), r, version));
+            }
+        };
+        if (copyGuard) copyGuard(copy);
+        else copy();
+        state.touchedDonors.clear();
+        state.touchedRecipients.clear();
+
+        std::shared_ptr<Snapshot> next = std::make_shared<Snapshot>();
+        next->donors = donorViews;
+        next->recipients = recipientViews;
+        next->transactions = state.transactions.getSize();
+        next->version = version;
+        std::atomic_store(&current, std::shared_ptr<const Snapshot>(next));
+        publishedVersion.store(next->version, std::memory_order_release);
+    }
+
+    // Abhi publish hua snapshot file mein - Copies se, engine ke lock ke bina
+    void persist(const Snapshot& snapshot) {
+        if (!state.donorsDirty && !state.recipientsDirty) return;
+        LatencyMetrics::Timer timer(metrics.load(std::memory_order_acquire), persistencePhase);
+        if (state.donorsDirty) CSVHandler::saveDonorViews(donorsPath, snapshot.donors);
+        if (state.recipientsDirty) CSVHandler::saveRecipientViews(recipientsPath, snapshot.recipients);
+    }
+
+    void writerLoop() {
+        while (true) {
+            CustomVector<Pending*> batch;
+            {
+                std::unique_lock<std::mutex> guard(queueLock);
+                wake.wait(guard, [&] { return stopping || !queue.empty(); });
+                if (queue.empty()) return; // stopping aur kuch baaki nahi
+                batch = queue;
+                queue = CustomVector<Pending*>();
+            }
+
+            auto started = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < batch.getSize(); ++i) {
+                try {
+                    batch[i]->apply(state);
+                } catch (...) {
+                    // execute() wale ka exception uske packaged_task mein pakda gaya -
+                    // post() ka yahan gum, writer zinda rahe
+                }
+            }
+            bool savedDonors = state.donorsDirty;
+            bool savedRecipients = state.recipientsDirty;
+            publish();
+            persist(*std::atomic_load(&current));
+            state.donorsDirty = state.recipientsDirty = false;
+            double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count();
+
+            {
+                std::lock_guard<std::mutex> guard(queueLock);
+                stats.commands += batch.getSize();
+                ++stats.batches;
+                if (batch.getSize() > stats.maxBatch) stats.maxBatch = batch.getSize();
+                if (savedDonors) ++stats.donorSaves;
+                if (savedRecipients) ++stats.recipientSaves;
+                stats.publishMicrosSum += micros;
+            }
+            for (size_t i = 0; i < batch.getSize(); ++i) {
+                if (batch[i]->published) batch[i]->published->set_value();
+                if (batch[i]->then) {
+                    try {
+                        batch[i]->then();
+                    } catch (...) {
+                        // then() ka kaam apne errors khud sambhalna - Writer zinda rahe
+                    }
+                }
+                delete batch[i];
+            }
+        }
+    }
+
+public:
+    // Saves: poori file in paths par. copyGuard = engine ka lock (nullptr = koi nahi)
+    StateStore(const std::string& donorsCsv, const std::string& recipientsCsv, const CopyGuard& guard = CopyGuard())
+        : donorsPath(donorsCsv), recipientsPath(recipientsCsv), copyGuard(guard), stopping(false),
+          current(std::make_shared<const Snapshot>()) {
+        writer = new std::thread(&StateStore::writerLoop, this);
+        writerId = writer->get_id();
+    }
+
+    ~StateStore() {
+        stop();
+    }
+
+    // METRICS: CSV saves ka waqt persistence phase mein
+    void attachMetrics(LatencyMetrics* m) {
+        persistencePhase = m->phase("persistence");
+        metrics.store(m, std::memory_order_release);
+    }
+
+    // Queue khaali karke writer band
+    void stop() {
+        {
+            std::lock_guard<std::mutex> guard(queueLock);
+            if (stopping) return;
+            stopping = true;
+        }
+        wake.notify_all();
+        writer->join();
+        delete writer;
+    }
+
+    // EXECUTE: f(State&) writer par chalao, publish tak ruko, f ka result wapas
+    // (f ka exception yahan dobara throw). Writer thread se hi call ho to
+    // seedha chalta hai. matchLock pakde hue call mat karo - Publish usi ko
+    // maangta hai (wahan post())
+    template<typename F>
+    typename std::result_of<F(State&)>::type execute(F f) {
+        typedef typename std::result_of<F(State&)>::type Result;
+        if (std::this_thread::get_id() == writerId) return f(state);
+        std::shared_ptr<std::packaged_task<Result(State&)>> task =
+            std::make_shared<std::packaged_task<Result(State&)>>(f);
+        std::future<Result> result = task->get_future();
+        std::promise<void> published;
+        std::future<void> done = published.get_future();
+        enqueue(new Pending([task](State& s) { (*task)(s); }, &published));
+        done.wait();
+        return result.get();
+    }
+
+    // EXECUTE THEN: execute jaisa, magar bulane wala ruka nahi rehta. f ka
+    // result (ya exception) future mein; batch publish + CSV save ke baad
+    // writer thread then(future&) chalata hai. then jaldi return kare -
+    // Agla batch uske peeche hai. Writer se bhi call ho sakta hai (agle batch mein)
+    template<typename F, typename Then>
+    void executeThen(F f, Then then) {
+        typedef typename std::result_of<F(State&)>::type Result;
+        std::shared_ptr<std::packaged_task<Result(State&)>> task =
+            std::make_shared<std::packaged_task<Result(State&)>>(f);
+        std::shared_ptr<std::future<Result>> result = std::make_shared<std::future<Result>>(task->get_future());
+        enqueue(new Pending([task](State& s) { (*task)(s); }, nullptr, [result, then] { then(*result); }));
+    }
+
+    // POST: Fire-and-forget - Agle batch mein
+    void post(const Command& command) {
+        if (std::this_thread::get_id() == writerId) {
+            command(state);
+            return;
+        }
+        enqueue(new Pending(command, nullptr));
+    }
+
+    // SNAPSHOT: Lock nahi - Version wahi hai to thread ka apna cached
+    // snapshot, warna ek atomic_load aur cache update
+    std::shared_ptr<const Snapshot> snapshot() const {
+        struct Cached {
+            const StateStore* owner;
+            unsigned long version;
+            std::shared_ptr<const Snapshot> snap;
+            Cached() : owner(nullptr), version(0) {}
+        };
+        thread_local Cached cache;
+        unsigned long version = publishedVersion.load(std::memory_order_acquire);
+        if (cache.owner != this || cache.version != version || !cache.snap) {
+            cache.snap = std::atomic_load(&current);
+            cache.owner = this;
+            cache.version = cache.snap->version;
+        }
+        return cache.snap;
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> guard(queueLock);
+        Stats s = stats;
+        s.version = publishedVersion.load();
+        return s;
+    }
+};
+
+#endif // STATE_STORE_HPP
@@ -0,0 +1,375 @@
+#ifndef STATIC_ASSET_CACHE_HPP
+#define STATIC_ASSET_CACHE_HPP
+
+#include "../dsa/CustomVector.hpp"
+#include "../dsa/PersistentHashMap.hpp"
+#include <zlib.h>
+#ifdef STATIC_ASSETS_BROTLI
+#include <brotli/encode.h>
+#endif
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// ==================== STATIC ASSET CACHE BASICS ====================
+// public/ ki files (HTML pages, CSS, JS, SVG) startup par ek dafa memory
+// mein. Har request par disk se padhna / mustache se render nahi.
+//
+// Har asset ke saath:
+//   - Body teen shaklon mein: asli, gzip, aur (STATIC_ASSETS_BROTLI ho to)
+//     brotli - Compression bhi startup par, request par nahi. Compressed
+//     choti na nikle to woh variant nahi rakhte
+//   - Har variant ka strong ETag: Content ka 64-bit hash ("<hash>",
+//     "<hash>-gz", "<hash>-br") - Bytes badlein to ETag badle
+//   - Browser ka If-None-Match us ETag se mile -> 304, body nahi
+//
+// WATCHER: Apna thread har `interval` par folder dekhta hai (mtime + size).
+// Badli file dobara load, nayi shamil, mitaai hui nikal. Phir poori table
+// ki nayi copy atomic publish - PersistentHashMap ki copy O(1), aur
+// readers (Crow ke I/O threads) bina lock ke purani ya nayi table dekhte hain
+// ====================================================================
+
+class StaticAssetCache {
+public:
+    enum Encoding { IDENTITY = 0, GZIP = 1, BROTLI = 2 };
+
+    struct Variant {
+        bool present;
+        std::string body;
+        std::string etag;       // Quotes ke saath, header mein seedha
+        Variant() : present(false) {}
+    };
+
+    struct Asset {
+        std::string path;       // public/ ke andar, "/" wale separators
+        std::string contentType;
+        Variant variants[3];    // Encoding ke index par
+        long long modified;     // Watcher ke liye
+        uintmax_t fileSize;
+    };
+
+    // lookup() ka jawab - status 404 par asset khaali
+    struct Result {
+        int status;
+        std::shared_ptr<const Asset> asset;
+        Encoding encoding;
+        const Variant& variant() const { return asset->variants[encoding]; }
+    };
+
+    struct Stats {
+        size_t assets;
+        size_t bytes;               // Asli
+        size_t gzipBytes;
+        size_t brotliBytes;
+        unsigned long hits;         // 200
+        unsigned long notModified;  // 304
+        unsigned long misses;       // 404
+        unsigned long compressedHits;
+        unsigned long reloads;      // Watcher ne dobara padhi files
+        Stats() : assets(0), bytes(0), gzipBytes(0), brotliBytes(0), hits(0), notModified(0), misses(0),
+                  compressedHits(0), reloads(0) {}
+    };
+
+private:
+    typedef PersistentHashMap<std::string, std::shared_ptr<const Asset>> Table;
+
+    std::string root;
+    std::chrono::milliseconds interval;
+    Table assets;                           // Sirf watcher thread (aur start) badalta hai
+    std::shared_ptr<const Table> published; // std::atomic_load/store se
+    std::thread watcher;
+    std::mutex stopLock;
+    std::condition_variable stopSignal;
+    bool stopping;
+    std::atomic<unsigned long> hitCount{0};
+    std::atomic<unsigned long> notModifiedCount{0};
+    std::atomic<unsigned long> missCount{0};
+    std::atomic<unsigned long> compressedCount{0};
+    std::atomic<unsigned long> reloadCount{0};
+
+    static std::string contentTypeOf(const std::string& path) {
+        size_t dot = path.rfind('.');
+        std::string ext = dot == std::string::npos ? std::string() : path.substr(dot + 1);
+        if (ext == "html" || ext == "htm") return "text/html; charset=utf-8";
+        if (ext == "css") return "text/css; charset=utf-8";
+        if (ext == "js") return "application/javascript; charset=utf-8";
+        if (ext == "json") return "application/json";
+        if (ext == "svg") return "image/svg+xml";
+        if (ext == "png") return "image/png";
+        if (ext == "jpg" || ext == "jpeg") return "image/jpeg";
+        if (ext == "gif") return "image/gif";
+        if (ext == "ico") return "image/x-icon";
+        if (ext == "webp") return "image/webp";
+        if (ext == "woff2") return "font/woff2";
+        if (ext == "txt") return "text/plain; charset=utf-8";
+        return "application/octet-stream";
+    }
+
+    // Pehle se compressed formats - Dobara compress karna bekaar
+    static bool compressible(const std::string& contentType) {
+        return contentType.compare(0, 5, "text/") == 0 || contentType.compare(0, 22, "application/javascript") == 0 ||
+               contentType == "application/json" || contentType == "image/svg+xml";
+    }
+
+    // Content ka FNV-1a (64-bit) hex mein - ETag ka base
+    static std::string hashOf(const std::string& body) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (char c : body) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+        char buf[20];
+        std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(hash));
+        return buf;
+    }
+
+    static bool gzip(const std::string& in, std::string& out) {
+        z_stream zs = z_stream();
+        // windowBits 15 + 16 = gzip header/trailer (raw zlib nahi)
+        if (deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK) return false;
+        out.resize(deflateBound(&zs, in.size()) + 32);
+        zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+        zs.avail_in = static_cast<uInt>(in.size());
+        zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+        zs.avail_out = static_cast<uInt>(out.size());
+        int rc = deflate(&zs, Z_FINISH);
+        out.resize(zs.total_out);
+        deflateEnd(&zs);
+        return rc == Z_STREAM_END;
+    }
+
+    static bool brotli(const std::string& in, std::string& out) {
+#ifdef STATIC_ASSETS_BROTLI
+        size_t size = BrotliEncoderMaxCompressedSize(in.size());
+        if (size == 0) return false;
+        out.resize(size);
+        if (!BrotliEncoderCompress(BROTLI_MAX_QUALITY, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT, in.size(),
+                                   reinterpret_cast<const uint8_t*>(in.data()), &size,
+                                   reinterpret_cast<uint8_t*>(&out[0]))) {
+            return false;
+        }
+        out.resize(size);
+        return true;
+#else
+        (void)in;
+        (void)out;
+        return false;
+#endif
+    }
+
+    static long long modifiedOf(const std::filesystem::path& file, std::error_code& ec) {
+        return static_cast<long long>(std::filesystem::last_write_time(file, ec).time_since_epoch().count());
+    }
+
+    // File padh kar teeno variants - nullptr = padh nahi saki (watcher agli dafa phir try karega)
+    std::shared_ptr<const Asset> loadAsset(const std::filesystem::path& file, const std::string& path,
+                                           long long modified, uintmax_t fileSize) {
+        std::ifstream in(file, std::ios::binary);
+        if (!in) return nullptr;
+        std::ostringstream content;
+        content << in.rdbuf();
+        if (in.bad()) return nullptr;
+
+        std::shared_ptr<Asset> asset = std::make_shared<Asset>();
+        asset->path = path;
+        asset->contentType = contentTypeOf(path);
+        asset->modified = modified;
+        asset->fileSize = fileSize;
+        Variant& identity = asset->variants[IDENTITY];
+        identity.present = true;
+        identity.body = content.str();
+        std::string hash = hashOf(identity.body);
+        identity.etag = "\"" + hash + "\"";
+        if (compressible(asset->contentType)) {
+            // Har shakal ka apna ETag (suffix) - Strong ETag byte-for-byte ek jaisi body ka hota hai
+            Variant& gz = asset->variants[GZIP];
+            gz.present = gzip(identity.body, gz.body) && gz.body.size() < identity.body.size();
+            if (gz.present) gz.etag = "\"" + hash + "-gz\"";
+            else gz.body.clear();
+            Variant& br = asset->variants[BROTLI];
+            br.present = brotli(identity.body, br.body) && br.body.size() < identity.body.size();
+            if (br.present) br.etag = "\"" + hash + "-br\"";
+            else br.body.clear();
+        }
+        return asset;
+    }
+
+    // Folder ek dafa scan - Badli/nayi files load, gayi hui nikal. True = kuch badla
+    bool scan() {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        if (!fs::is_directory(root, ec)) return false;
+        bool changed = false;
+        CustomVector<std::string> seen;
+        std::error_code walkError;
+        for (fs::recursive_directory_iterator it(root, walkError), end; !walkError && it != end;
+             it.increment(walkError)) {
+            // Ek file ki galti (e.g. scan ke beech mitaai gayi) sirf us file ko chhodti hai
+            std::error_code fileError;
+            if (!it->is_regular_file(fileError)) continue;
+            std::string path = fs::relative(it->path(), root, fileError).generic_string();
+            if (fileError || path.empty()) continue;
+            seen.push_back(path);
+            long long modified = modifiedOf(it->path(), fileError);
+            uintmax_t fileSize = it->file_size(fileError);
+            if (fileError) continue;
+            std::shared_ptr<const Asset> current;
+            if (assets.get(path, current) && current->modified == modified && current->fileSize == fileSize) {
+                continue;
+            }
+            std::shared_ptr<const Asset> loaded = loadAsset(it->path(), path, modified, fileSize);
+            if (!loaded) continue;
+            if (current) ++reloadCount;
+            assets.insert(path, loaded);
+            changed = true;
+        }
+        if (walkError) return changed; // Adhoora scan - Kuch bhi mitana theek nahi
+
+        if (seen.getSize() != assets.getSize()) {
+            Table remaining;
+            for (size_t i = 0; i < seen.getSize(); ++i) {
+                std::shared_ptr<const Asset> asset;
+                if (assets.get(seen[i], asset)) remaining.insert(seen[i], asset);
+            }
+            assets = remaining;
+            changed = true;
+        }
+        return changed;
+    }
+
+    void publish() {
+        std::atomic_store(&published, std::shared_ptr<const Table>(new Table(assets)));
+    }
+
+    void watchLoop() {
+        std::unique_lock<std::mutex> guard(stopLock);
+        while (!stopSignal.wait_for(guard, interval, [&] { return stopping; })) {
+            guard.unlock();
+            if (scan()) publish();
+            guard.lock();
+        }
+    }
+
+    // Accept-Encoding mein token hai (aur q=0 nahi)?
+    static bool accepts(const std::string& header, const char* token) {
+        size_t n = std::strlen(token);
+        size_t pos = 0;
+        while (pos < header.size()) {
+            size_t comma = header.find(',', pos);
+            if (comma == std::string::npos) comma = header.size();
+            size_t start = header.find_first_not_of(' ', pos);
+            if (start < comma && header.compare(start, n, token) == 0) {
+                size_t after = start + n;
+                while (after < comma && header[after] == ' ') ++after;
+                if (after == comma) return true;
+                if (header[after] == ';') {
+                    size_t q = header.find("q=", after);
+                    if (q == std::string::npos || q > comma) return true;
+                    return std::strtod(header.c_str() + q + 2, nullptr) > 0;
+                }
+            }
+            pos = comma + 1;
+        }
+        return false;
+    }
+
+    // If-None-Match: "*" ya comma list - W/ wale bhi (304 ke liye weak comparison)
+    static bool matchesEtag(const std::string& header, const std::string& etag) {
+        if (header.empty()) return false;
+        if (header.find('*') != std::string::npos && header.find('"') == std::string::npos) return true;
+        size_t pos = 0;
+        while ((pos = header.find('"', pos)) != std::string::npos) {
+            size_t close = header.find('"', pos + 1);
+            if (close == std::string::npos) return false;
+            if (header.compare(pos, close - pos + 1, etag) == 0) return true;
+            pos = close + 1;
+        }
+        return false;
+    }
+
+public:
+    StaticAssetCache(const std::string& rootDir, std::chrono::milliseconds watchInterval)
+        : root(rootDir), interval(watchInterval), published(std::make_shared<const Table>()), stopping(false) {}
+
+    ~StaticAssetCache() {
+        stop();
+    }
+
+    // Pehla poora load (isi thread par), phir watcher. Return = kitne assets
+    size_t start() {
+        scan();
+        publish();
+        watcher = std::thread(&StaticAssetCache::watchLoop, this);
+        return assets.getSize();
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> guard(stopLock);
+            stopping = true;
+        }
+        stopSignal.notify_all();
+        if (watcher.joinable()) watcher.join();
+    }
+
+    // LOOKUP: "" ya "/" par khatam -> index.html. Client ke Accept-Encoding
+    // mein jo sab se chhota variant ho (br > gzip > asli)
+    Result lookup(const std::string& urlPath, const std::string& acceptEncoding, const std::string& ifNoneMatch) {
+        std::string path = urlPath;
+        if (!path.empty() && path[0] == '/') path.erase(0, 1);
+        if (path.empty() || path.back() == '/') path += "index.html";
+
+        Result result;
+        result.status = 404;
+        result.encoding = IDENTITY;
+        std::shared_ptr<const Table> table = std::atomic_load(&published);
+        if (!table->get(path, result.asset)) {
+            ++missCount;
+            return result;
+        }
+        const Asset& asset = *result.asset;
+        if (asset.variants[BROTLI].present && accepts(acceptEncoding, "br")) result.encoding = BROTLI;
+        else if (asset.variants[GZIP].present && accepts(acceptEncoding, "gzip")) result.encoding = GZIP;
+
+        if (matchesEtag(ifNoneMatch, asset.variants[result.encoding].etag)) {
+            result.status = 304;
+            ++notModifiedCount;
+        } else {
+            result.status = 200;
+            ++hitCount;
+            if (result.encoding != IDENTITY) ++compressedCount;
+        }
+        return result;
+    }
+
+    Stats getStats() const {
+        Stats s;
+        std::shared_ptr<const Table> table = std::atomic_load(&published);
+        s.assets = table->getSize();
+        table->forEach([&](const std::string&, const std::shared_ptr<const Asset>& asset) {
+            s.bytes += asset->variants[IDENTITY].body.size();
+            s.gzipBytes += asset->variants[GZIP].body.size();
+            s.brotliBytes += asset->variants[BROTLI].body.size();
+            return true;
+        });
+        s.hits = hitCount.load();
+        s.notModified = notModifiedCount.load();
+        s.misses = missCount.load();
+        s.compressedHits = compressedCount.load();
+        s.reloads = reloadCount.load();
+        return s;
+    }
+};
+
+#endif // STATIC_ASSET_CACHE_HPP
@@ -0,0 +1,163 @@
+#ifndef VERSIONED_RESPONSE_CACHE_HPP
+#define VERSIONED_RESPONSE_CACHE_HPP
+
+#include "../dsa/CustomHashMap.hpp"
+#include "../dsa/CustomVector.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// ==================== VERSIONED RESPONSE CACHE BASICS ====================
+// Dashboard har kuch second baad poll hota hai, aur har dafa wahi JSON
+// dobara banta tha - Halaanke donor ka data sirf uske record ke badalne
+// par badalta hai. Store har entity ko version deta hai (har tabdeeli par
+// naya), to:
+//
+//   (id, version, day) -> Bani hui body + ETag
+//
+//   - Wahi version -> Cached bytes, JSON dobara nahi banta (HIT)
+//   - Browser ka If-None-Match wahi ETag -> 304, body bhi nahi jati
+//   - Version badla -> Naya body ek dafa bana kar purane ki jagah (BUILD)
+//
+// `day` bhi key mein - Body mein "aaj" par tikka hisaab ho (eligible) to
+// record badle baghair bhi din badalne par naya banta hai.
+// ETag mein process ka epoch bhi - Restart par versions 0 se shuru hote
+// hain, purane browser ka ETag naye data se ghalti se na mile
+//
+// Shards (har ek ka apna chhota lock) - Sab I/O threads ek lock par nahi
+// ==========================================================================
+
+class VersionedResponseCache {
+public:
+    struct Entry {
+        unsigned long version;
+        int day;
+        std::string body;
+        std::string etag;       // Quotes ke saath
+    };
+    typedef std::shared_ptr<const Entry> EntryPtr;
+
+    struct Result {
+        EntryPtr entry;
+        bool notModified;       // true = 304 bhejo
+    };
+
+    struct Stats {
+        size_t entries;
+        unsigned long hits;         // Cached body bheji
+        unsigned long notModified;  // 304
+        unsigned long builds;       // Naya body banana pada
+        double buildMicrosSum;
+        Stats() : entries(0), hits(0), notModified(0), builds(0), buildMicrosSum(0) {}
+        unsigned long requests() const { return hits + notModified + builds; }
+        double hitRatio() const { return requests() ? static_cast<double>(hits + notModified) / requests() : 0.0; }
+        double avgBuildMicros() const { return builds ? buildMicrosSum / builds : 0.0; }
+        // Jo builds cache ne bachaye, average build cost par
+        double savedMicros() const { return (hits + notModified) * avgBuildMicros(); }
+    };
+
+private:
+    struct Shard {
+        std::mutex lock;
+        CustomHashMap<std::string, EntryPtr> entries;
+    };
+
+    CustomVector<Shard*> shards;
+    std::string epoch;
+    std::atomic<unsigned long> hitCount{0};
+    std::atomic<unsigned long> notModifiedCount{0};
+    std::atomic<unsigned long> buildCount{0};
+    std::atomic<unsigned long long> buildNanos{0};
+
+    // std::hash - CustomHashMap andar FNV use karta hai, dono ek hon to
+    // ek shard ke saare ids uske kuch hi buckets mein girte
+    Shard& shardFor(const std::string& id) {
+        return *shards[std::hash<std::string>()(id) % shards.getSize()];
+    }
+
+    // If-None-Match: "*" ya comma list (W/ wale bhi)
+    static bool matchesEtag(const std::string& header, const std::string& etag) {
+        if (header.empty()) return false;
+        if (header.find('*') != std::string::npos && header.find('"') == std::string::npos) return true;
+        size_t pos = 0;
+        while ((pos = header.find('"', pos)) != std::string::npos) {
+            size_t close = header.find('"', pos + 1);
+            if (close == std::string::npos) return false;
+            if (header.compare(pos, close - pos + 1, etag) == 0) return true;
+            pos = close + 1;
+        }
+        return false;
+    }
+
+public:
+    explicit VersionedResponseCache(size_t shardCount = 64) {
+        for (size_t i = 0; i < shardCount; ++i) shards.push_back(new Shard());
+        char buf[24];
+        std::snprintf(buf, sizeof(buf), "%llx", static_cast<unsigned long long>(
+            std::chrono::system_clock::now().time_since_epoch().count()));
+        epoch = buf;
+    }
+
+    ~VersionedResponseCache() {
+        for (size_t i = 0; i < shards.getSize(); ++i) delete shards[i];
+    }
+
+    // LOOKUP: (id, version, day) ki body - Na ho ya purani ho to build(out)
+    // se banao (lock ke bahar) aur rakh lo
+    Result lookup(const std::string& id, unsigned long version, int day, const std::string& ifNoneMatch,
+                  const std::function<void(std::string&)>& build) {
+        Shard& shard = shardFor(id);
+        Result result;
+        result.notModified = false;
+        {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            shard.entries.get(id, result.entry);
+        }
+        if (result.entry && result.entry->version == version && result.entry->day == day) {
+            result.notModified = matchesEtag(ifNoneMatch, result.entry->etag);
+            ++(result.notModified ? notModifiedCount : hitCount);
+            return result;
+        }
+
+        auto started = std::chrono::steady_clock::now();
+        std::shared_ptr<Entry> built = std::make_shared<Entry>();
+        built->version = version;
+        built->day = day;
+        build(built->body);
+        built->etag = "\"" + epoch + "-" + std::to_string(version) + "-" + std::to_string(day) + "\"";
+        buildNanos += static_cast<unsigned long long>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count());
+        ++buildCount;
+        {
+            // Do threads ne ek saath banaya ho to naya version hi rahe
+            std::lock_guard<std::mutex> guard(shard.lock);
+            EntryPtr existing;
+            if (!shard.entries.get(id, existing) || existing->version < version ||
+                (existing->version == version && existing->day < day)) {
+                shard.entries.insert(id, built);
+            }
+        }
+        result.entry = built;
+        result.notModified = matchesEtag(ifNoneMatch, built->etag);
+        return result;
+    }
+
+    Stats getStats() {
+        Stats s;
+        for (size_t i = 0; i < shards.getSize(); ++i) {
+            std::lock_guard<std::mutex> guard(shards[i]->lock);
+            s.entries += shards[i]->entries.getSize();
+        }
+        s.hits = hitCount.load();
+        s.notModified = notModifiedCount.load();
+        s.builds = buildCount.load();
+        s.buildMicrosSum = buildNanos.load() / 1000.0;
+        return s;
+    }
+};
+
+#endif // VERSIONED_RESPONSE_CACHE_HPP
@@ -0,0 +1,319 @@
+#ifndef WEBSOCKET_HUB_HPP
+#define WEBSOCKET_HUB_HPP
+
+#include "../dsa/CustomHashMap.hpp"
+#include "../dsa/CustomVector.hpp"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// ==================== WEBSOCKET HUB BASICS ====================
+// Connections topics subscribe karte hain:
+//   "group:O-|area:D1"  - Us blood group ke donors us area mein (alerts)
+//   "request:REC-001"   - Ek request ka status
+//   "donor:DON-001"     - Ek donor ke liye (dispatch, reminders)
+//
+// PUBLISH: Payload ek hi dafa string banta hai, shared_ptr mein - 10k
+// subscribers ko wahi buffer jata hai, har ek ki copy nahi. Kayi topics
+// par ek publish ho to jo connection do topics par hai usay ek hi frame.
+//
+// BACKPRESSURE: Crow ka send sirf io thread par post karta hai - Socket
+// flush hua ya nahi, pata nahi chalta. Is liye client ack karta hai:
+//   {"op":"ack","count":N}   (N = ab tak kitne frames mile)
+// Har connection ke zyada se zyada `window` frames bina ack ke "in flight".
+// Baaki bounded queue mein. Queue bhar jaye (client slow / ack nahi
+// karta) to policy:
+//   DROP_OLDEST - Sabse purana frame girao (status mein naya purane ko
+//                 replace karta hai)
+//   DISCONNECT  - Connection band, client reconnect karke state dobara le
+// Is tarah ek slow client ki wajah se server ki memory nahi badhti
+// =================================================================
+
+class WebSocketHub {
+public:
+    typedef std::shared_ptr<const std::string> Frame;
+    typedef unsigned long ConnectionId;
+
+    enum SlowConsumerPolicy { DROP_OLDEST, DISCONNECT };
+
+    // Transport - Crow connection (ya benchmark ka fake) ke callbacks
+    // Dono hub ke lock ke andar chalte hain: send non-blocking hona chahiye
+    struct Endpoint {
+        std::function<void(const Frame&)> send;
+        std::function<void(const std::string&)> close;
+    };
+
+    struct Stats {
+        size_t connections;
+        size_t topics;
+        unsigned long published;        // publish() calls
+        unsigned long deliveries;       // Transport ko diye gaye frames
+        unsigned long queued;           // Window bhara tha - Queue mein gaye
+        unsigned long dropped;          // DROP_OLDEST ne giraye
+        unsigned long disconnected;     // Slow consumers band kiye
+        Stats() : connections(0), topics(0), published(0), deliveries(0), queued(0), dropped(0), disconnected(0) {}
+    };
+
+private:
+    struct Subscriber {
+        ConnectionId id;
+        Endpoint endpoint;
+        CustomVector<std::string> topics;
+        CustomVector<Frame> ring;       // Bounded queue (circular)
+        size_t head;
+        size_t count;
+        unsigned long sent;             // Transport ko diye
+        unsigned long acked;            // Client ne confirm kiye
+        unsigned long lastPublish;      // Multi-topic publish mein duplicate na ho
+    };
+
+    struct Topic {
+        CustomVector<Subscriber*> members;
+    };
+
+    CustomHashMap<ConnectionId, Subscriber*> connections;
+    CustomHashMap<std::string, Topic*> topics;
+    size_t window;
+    size_t queueCapacity;
+    size_t maxTopicsPerConnection;
+    SlowConsumerPolicy policy;
+    ConnectionId nextId;
+    unsigned long publishCounter;
+    Stats stats;
+    std::mutex lock;
+
+    // Apne hi close() ke andar se aane wala disconnect (Crow close handler
+    // usi thread par chala sakta hai) - Lock dobara na lo
+    static bool& closingOnThisThread() {
+        thread_local bool closing = false;
+        return closing;
+    }
+
+    void sendNow(Subscriber* sub, const Frame& frame) {
+        sub->endpoint.send(frame);
+        ++sub->sent;
+        ++stats.deliveries;
+    }
+
+    // Window mein jagah ho to queue se bhejo
+    void flush(Subscriber* sub) {
+        while (sub->count > 0 && sub->sent - sub->acked < window) {
+            Frame frame = sub->ring[sub->head];
+            sub->ring[sub->head] = Frame();
+            sub->head = (sub->head + 1) % queueCapacity;
+            --sub->count;
+            sendNow(sub, frame);
+        }
+    }
+
+    // Ek subscriber ko frame - False agar slow consumer ko band karna hai
+    bool deliver(Subscriber* sub, const Frame& frame) {
+        if (sub->count == 0 && sub->sent - sub->acked < window) {
+            sendNow(sub, frame);
+            return true;
+        }
+        if (sub->count == queueCapacity) {
+            if (policy == DISCONNECT) return false;
+            sub->ring[sub->head] = Frame();            // Sabse purana girao
+            sub->head = (sub->head + 1) % queueCapacity;
+            --sub->count;
+            ++stats.dropped;
+        }
+        sub->ring[(sub->head + sub->count) % queueCapacity] = frame;
+        ++sub->count;
+        ++stats.queued;
+        return true;
+    }
+
+    void leaveTopic(Subscriber* sub, const std::string& name) {
+        Topic* topic = nullptr;
+        if (!topics.get(name, topic)) return;
+        CustomVector<Subscriber*>& members = topic->members;
+        for (size_t i = 0; i < members.getSize(); ++i) {
+            if (members[i] == sub) {
+                members[i] = members[members.getSize() - 1]; // Swap-remove - Order zaroori nahi
+                members.pop_back();
+                break;
+            }
+        }
+        if (members.empty()) {
+            topics.remove(name);
+            delete topic;
+        }
+    }
+
+    // Registry se nikalo aur free - Lock ke andar
+    void removeLocked(Subscriber* sub) {
+        for (size_t i = 0; i < sub->topics.getSize(); ++i) leaveTopic(sub, sub->topics[i]);
+        connections.remove(sub->id);
+        delete sub;
+    }
+
+    // Slow consumer - Registry se nikalo, phir transport close
+    void closeSlow(Subscriber* sub) {
+        std::function<void(const std::string&)> close = sub->endpoint.close;
+        removeLocked(sub);
+        ++stats.disconnected;
+        if (close) {
+            closingOnThisThread() = true;
+            close("slow consumer");
+            closingOnThisThread() = false;
+        }
+    }
+
+public:
+    // window = bina ack ke kitne frames, queueCapacity = us ke baad kitne ruk sakte hain
+    explicit WebSocketHub(size_t windowFrames = 32, size_t queueFrames = 256,
+                          SlowConsumerPolicy slowPolicy = DROP_OLDEST, size_t topicsPerConnection = 32)
+        : window(windowFrames ? windowFrames : 1), queueCapacity(queueFrames ? queueFrames : 1),
+          maxTopicsPerConnection(topicsPerConnection), policy(slowPolicy), nextId(1), publishCounter(0) {}
+
+    ~WebSocketHub() {
+        CustomVector<ConnectionId> ids = connections.getKeys();
+        for (size_t i = 0; i < ids.getSize(); ++i) {
+            Subscriber* sub = nullptr;
+            if (connections.get(ids[i], sub)) removeLocked(sub);
+        }
+    }
+
+    // Topic names - Sab jagah ek hi format
+    static std::string groupAreaTopic(const std::string& bloodGroup, const std::string& nodeId) {
+        return "group:" + bloodGroup + "|area:" + nodeId;
+    }
+    static std::string requestTopic(const std::string& requestId) {
+        return "request:" + requestId;
+    }
+    static std::string donorTopic(const std::string& donorId) {
+        return "donor:" + donorId;
+    }
+
+    // CONNECT: Naya connection - Id Crow ke userdata mein rakho
+    ConnectionId connect(const Endpoint& endpoint) {
+        Subscriber* sub = new Subscriber();
+        sub->endpoint = endpoint;
+        sub->ring = CustomVector<Frame>(queueCapacity);
+        for (size_t i = 0; i < queueCapacity; ++i) sub->ring.push_back(Frame());
+        sub->head = 0;
+        sub->count = 0;
+        sub->sent = 0;
+        sub->acked = 0;
+        sub->lastPublish = 0;
+        std::lock_guard<std::mutex> guard(lock);
+        sub->id = nextId++;
+        connections.insert(sub->id, sub);
+        return sub->id;
+    }
+
+    // DISCONNECT: Close handler se - Pehle se nikal chuka ho to kuch nahi
+    void disconnect(ConnectionId id) {
+        if (closingOnThisThread()) return; // Hamare closeSlow ke andar se
+        std::lock_guard<std::mutex> guard(lock);
+        Subscriber* sub = nullptr;
+        if (connections.get(id, sub)) removeLocked(sub);
+    }
+
+    // SUBSCRIBE - False agar connection nahi ya topics ki limit poori
+    bool subscribe(ConnectionId id, const std::string& name) {
+        std::lock_guard<std::mutex> guard(lock);
+        Subscriber* sub = nullptr;
+        if (!connections.get(id, sub)) return false;
+        for (size_t i = 0; i < sub->topics.getSize(); ++i) {
+            if (sub->topics[i] == name) return true; // Pehle se
+        }
+        if (sub->topics.getSize() >= maxTopicsPerConnection) return false;
+        Topic* topic = nullptr;
+        if (!topics.get(name, topic)) {
+            topic = new Topic();
+            topics.insert(name, topic);
+        }
+        topic->members.push_back(sub);
+        sub->topics.push_back(name);
+        return true;
+    }
+
+    bool unsubscribe(ConnectionId id, const std::string& name) {
+        std::lock_guard<std::mutex> guard(lock);
+        Subscriber* sub = nullptr;
+        if (!connections.get(id, sub)) return false;
+        for (size_t i = 0; i < sub->topics.getSize(); ++i) {
+            if (sub->topics[i] == name) {
+                sub->topics[i] = sub->topics[sub->topics.getSize() - 1];
+                sub->topics.pop_back();
+                leaveTopic(sub, name);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ACK: Client ne count frames le liye - Window khuli, queue se bhejo
+    void acknowledge(ConnectionId id, unsigned long count) {
+        std::lock_guard<std::mutex> guard(lock);
+        Subscriber* sub = nullptr;
+        if (!connections.get(id, sub)) return;
+        if (count > sub->sent) count = sub->sent; // Jo bheja hi nahi uska ack nahi
+        if (count > sub->acked) sub->acked = count;
+        flush(sub);
+    }
+
+    // SEND TO: Ek connection ko (e.g. subscribe ka jawab) - Wahi window/queue
+    bool sendTo(ConnectionId id, const std::string& payload) {
+        Frame frame = std::make_shared<const std::string>(payload);
+        std::lock_guard<std::mutex> guard(lock);
+        Subscriber* sub = nullptr;
+        if (!connections.get(id, sub)) return false;
+        if (!deliver(sub, frame)) {
+            closeSlow(sub);
+            return false;
+        }
+        return true;
+    }
+
+    // PUBLISH: Kayi topics par ek hi frame - Return = kitne connections tak gaya
+    size_t publish(const CustomVector<std::string>& names, const std::string& payload) {
+        Frame frame = std::make_shared<const std::string>(payload); // Ek hi dafa
+        std::lock_guard<std::mutex> guard(lock);
+        ++stats.published;
+        unsigned long stamp = ++publishCounter;
+        CustomVector<Subscriber*> slow;
+        size_t reached = 0;
+        for (size_t t = 0; t < names.getSize(); ++t) {
+            Topic* topic = nullptr;
+            if (!topics.get(names[t], topic)) continue;
+            CustomVector<Subscriber*>& members = topic->members;
+            for (size_t i = 0; i < members.getSize(); ++i) {
+                Subscriber* sub = members[i];
+                if (sub->lastPublish == stamp) continue; // Doosre topic se mil chuka
+                sub->lastPublish = stamp;
+                if (deliver(sub, frame)) ++reached;
+                else slow.push_back(sub);
+            }
+        }
+        // Topic lists par loop khatam - Ab nikalna safe hai
+        for (size_t i = 0; i < slow.getSize(); ++i) closeSlow(slow[i]);
+        return reached;
+    }
+
+    size_t publish(const std::string& name, const std::string& payload) {
+        CustomVector<std::string> names;
+        names.push_back(name);
+        return publish(names, payload);
+    }
+
+    // Koi sun raha hai? - Publish se pehle payload banana bach sakta hai
+    bool hasSubscribers(const std::string& name) {
+        std::lock_guard<std::mutex> guard(lock);
+        return topics.contains(name);
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> guard(lock);
+        Stats s = stats;
+        s.connections = connections.getSize();
+        s.topics = topics.getSize();
+        return s;
+    }
+};
+
+#endif // WEBSOCKET_HUB_HPP
@@ -4,25 +4,60 @@
 #include "dsa/CustomHashMap.hpp"
 #include "dsa/CustomLinkedList.hpp"
 #include "dsa/CustomGraph.hpp"
+#include "dsa/DeltaStepping.hpp"
+#include "dsa/TimerWheel.hpp"
+#include "dsa/WorkStealingPool.hpp"
 #include "models/Models.hpp"
 #include "logic/BloodCompatibility.hpp"
 #include "logic/MatchingEngine.hpp"
+#include "logic/MatchBatcher.hpp"
 #include "logic/CSVHandler.hpp"
+#include "logic/WebSocketHub.hpp"
+#include "logic/LiveRequestFeed.hpp"
+#include "logic/DispatchBoard.hpp"
+#include "logic/NotificationOutbox.hpp"
+#include "logic/HttpGateway.hpp"
+#include "logic/StateStore.hpp"
+#include "logic/JsonCodec.hpp"
+#include "logic/StaticAssetCache.hpp"
+#include "logic/VersionedResponseCache.hpp"
+#include "logic/LatencyMetrics.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <ctime>
 #include <iomanip>
+#include <random>
 
-CustomHashMap<std::string, Donor*> donorDatabase;
-CustomHashMap<std::string, Recipient*> recipientDatabase;
-CustomLinkedList<Transaction*> transactionHistory;
+// Donors, recipients, transactions and id counters - changed only by the store's writer thread
+StateStore* store;
 CustomGraph cityGraph;
 MatchingEngine* matchingEngine;
+MatchBatcher* matchBatcher;
+TimerWheel* timerWheel;
+WebSocketHub* wsHub;
+LiveRequestFeed* liveFeed;
+DispatchBoard* dispatchBoard;
+HttpGateway* smsGateway;
+NotificationOutbox* outbox;
+WorkStealingPool* workPool;
+StaticAssetCache* staticAssets;
+VersionedResponseCache* dashboardCache;
+// Coverage reports - one CSR snapshot and thread team, refreshed when the graph epoch changes
+DeltaStepping* coverageSolver;
+std::mutex coverageLock;
+// Latency histograms and counters for /metrics - series are registered at startup
+LatencyMetrics* metrics;
+LatencyMetrics::Series httpPhase;
+LatencyMetrics::Series jsonEncodePhase;
+LatencyMetrics::Series persistencePhase;
+CustomHashMap<std::string, LatencyMetrics::Series>* routeSeries; // Route template -> series, read-only once serving
 
-int donorCounter = 1;
-int recipientCounter = 1;
-int transactionCounter = 1;
+// Local gateway stand-in (/api/gateway-stub/messages) - injected failures and latency for testing retries
+std::atomic<int> gatewayStubFailPercent{0};
+std::atomic<int> gatewayStubDelayMs{0};
+std::atomic<unsigned long> gatewayStubBatches{0};
+std::atomic<unsigned long> gatewayStubMessages{0};
 
 std::string getCurrentTimestamp() {
     time_t now = time(0);
@@ -31,22 +66,366 @@ std::string getCurrentTimestamp() {
     return std::string(buf);
 }
 
-std::string generateDonorId() {
-    std::stringstream ss;
-    ss << "DON-" << std::setfill('0') << std::setw(3) << donorCounter++;
-    return ss.str();
-}
-
-std::string generateRecipientId() {
-    std::stringstream ss;
-    ss << "REC-" << std::setfill('0') << std::setw(3) << recipientCounter++;
-    return ss.str();
+// Minute of day in Islamabad (PKT = UTC+5) - traffic profiles are local time
+double currentMinuteOfDay() {
+    time_t now = time(0);
+    tm utc = *gmtime(&now);
+    int minutes = utc.tm_hour * 60 + utc.tm_min + 5 * 60;
+    return minutes % 1440;
 }
 
 const std::string DONORS_CSV = "c:\\Users\\hp\\Desktop\\for vscode\\data\\donors.csv";
 const std::string RECIPIENTS_CSV = "c:\\Users\\hp\\Desktop\\for vscode\\data\\recipients.csv";
 const std::string TRANSACTIONS_CSV = "c:\\Users\\hp\\Desktop\\for vscode\\data\\transactions.csv";
 
+// Burst requests arriving within this window share one search per hospital
+const long MATCH_BATCH_WINDOW_MICROS = 2000;
+
+// Reserved donors are released if they don't accept in time; unmatched requests expire
+const long RESERVATION_TIMEOUT_MINUTES = 30;
+const long REQUEST_EXPIRY_HOURS = 24;
+
+// WebSocket flow control: frames in flight without an ack, then frames queued per connection
+const size_t WS_ACK_WINDOW = 32;
+const size_t WS_QUEUE_FRAMES = 256;
+
+// Broadcast-and-claim: how many nearest donors get the offer, and how long it stays open
+const size_t BROADCAST_DONORS = 5;
+const long BROADCAST_OFFER_SECONDS = 120;
+
+// Outbound SMS/push: provider's batch endpoint (defaults to the local stub), undelivered messages journal
+const std::string NOTIFY_GATEWAY_URL = "http://127.0.0.1:18080/api/gateway-stub/messages";
+const std::string OUTBOX_JOURNAL = "data/outbox.csv";
+const size_t OUTBOX_WORKERS = 4;
+const size_t OUTBOX_BATCH = 100;
+const long OUTBOX_LINGER_MS = 5;
+
+// Routes with their own latency histogram - param routes by template, anything else
+// under /api/ is "other" and the rest "static" (keeps /metrics cardinality fixed)
+const char* const METRIC_ROUTES[] = {
+    "/", "/metrics", "/api/auth/register/donor", "/api/auth/register/recipient", "/api/auth/login",
+    "/api/donor/update", "/api/donor/status", "/api/donor/accept-request", "/api/donor/dashboard/<string>",
+    "/api/recipient/request", "/api/recipient/live/<string>", "/api/recipient/candidates/<string>",
+    "/api/matching/assign-pending", "/api/graph/road", "/api/reports/coverage/<string>",
+    "/api/emergency/broadcast", "/api/health", "/api/gateway-stub/messages", "/api/gateway-stub/config",
+    "/api/debug/donors", "/api/debug/recipients", "/api/debug/distance-cache", "/api/debug/prefilter",
+    "/api/debug/work-pool", "/api/debug/state", "/api/debug/match-batcher", "/api/debug/websocket",
+    "/api/debug/dispatch", "/api/debug/outbox", "/api/debug/dashboard-cache", "/api/debug/static-assets",
+    "/api/debug/match-deadlines", "other", "static"};
+
+// Matching, graph searches and full CSV saves run here instead of on Crow's I/O threads (0 = one per core)
+const size_t WORK_POOL_THREADS = 0;
+
+// Frontend pages, CSS and JS - held in memory (precompressed), re-read only when a file changes
+const std::string PUBLIC_DIR = "public";
+const long STATIC_WATCH_MS = 1000;
+
+// Runs a handler on the work pool and completes the response from there, so the
+// I/O thread goes straight back to its other sockets. Crow keeps the connection
+// (and req) alive until res.end().
+std::function<void(const crow::request&, crow::response&)>
+offload(std::function<crow::response(const crow::request&)> handler) {
+    return [handler](const crow::request& req, crow::response& res) {
+        workPool->submit([handler, &req, &res] {
+            try {
+                res = handler(req);
+            } catch (const std::exception& e) {
+                res = crow::response(500, e.what());
+            }
+            res.end();
+        });
+    };
+}
+
+// Same for routes with a path parameter
+std::function<void(const crow::request&, crow::response&, std::string)>
+offload(std::function<crow::response(const crow::request&, std::string)> handler) {
+    return [handler](const crow::request& req, crow::response& res, std::string param) {
+        workPool->submit([handler, &req, &res, param] {
+            try {
+                res = handler(req, param);
+            } catch (const std::exception& e) {
+                res = crow::response(500, e.what());
+            }
+            res.end();
+        });
+    };
+}
+
+// Completes a response exactly once, from whichever thread finishes the work
+typedef std::function<void(crow::response)> Responder;
+
+// For handlers that hand work to the store's writer or the match batcher: the handler
+// returns as soon as the work is queued, and the completion callback answers with
+// res.end() on its own thread - no pool thread sits on a future in the meantime
+std::function<void(const crow::request&, crow::response&)>
+offloadAsync(std::function<void(const crow::request&, const Responder&)> handler) {
+    return [handler](const crow::request& req, crow::response& res) {
+        std::shared_ptr<std::atomic<bool>> answered = std::make_shared<std::atomic<bool>>(false);
+        Responder respond = [&res, answered](crow::response out) {
+            if (answered->exchange(true)) return;
+            res = std::move(out);
+            res.end();
+        };
+        workPool->submit([handler, &req, respond] {
+            try {
+                handler(req, respond);
+            } catch (const std::exception& e) {
+                respond(crow::response(500, e.what()));
+            }
+        });
+    };
+}
+
+// Runs cmd (returning the response) on the writer; the writer answers once the batch
+// holding it is published and its CSV saves are done
+template<typename F>
+void commitThenRespond(F cmd, const Responder& respond) {
+    store->executeThen(cmd, [respond](std::future<crow::response>& result) {
+        try {
+            respond(result.get());
+        } catch (const std::exception& e) {
+            respond(crow::response(500, e.what()));
+        }
+    });
+}
+
+// Queue an SMS for a donor - returns immediately, delivery and retries run on the outbox threads
+void notifyDonor(const Donor* d, const std::string& kind, const std::string& text) {
+    if (d->phone.empty()) return;
+    outbox->enqueue(d->id, d->phone, "sms", kind, text);
+}
+
+// Broadcast offer closed with units still open - the request goes back to the queue and
+// the next global pass reserves whatever it is missing
+void reopenBroadcast(const std::string& requestId) {
+    store->post([requestId](StateStore::State& state) {
+        Recipient* r = state.recipient(requestId);
+        // Back in the queue - or Expired if its deadline passed while it was on broadcast
+        if (!r || !matchingEngine->reopenBroadcast(r)) return;
+        state.touch(r);
+        liveFeed->notify(r);
+    });
+}
+
+// Fields of POST /api/recipient/request that aren't part of the Recipient record
+// (unset: dispatch from urgency, default broadcast size, current minute, urgency budget)
+struct RequestOptions {
+    std::string dispatch;
+    int broadcastSize;
+    double departureMinute;
+    long deadlineMs;
+    RequestOptions() : broadcastSize(0), departureMinute(-1), deadlineMs(0) {}
+};
+
+struct RequestOptionsJson {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("dispatch", &RequestOptions::dispatch), jsonField("broadcastSize", &RequestOptions::broadcastSize),
+        jsonField("departureMinute", &RequestOptions::departureMinute),
+        jsonField("deadlineMs", &RequestOptions::deadlineMs));
+};
+
+// Bodies built by JsonWriter - crow only sets the JSON content type for wvalue
+crow::response jsonResponse(int code, const std::string& body) {
+    crow::response res(code, body);
+    res.set_header("Content-Type", "application/json");
+    return res;
+}
+
+// Reply to POST /api/recipient/request in reserve mode, once the batcher's match is saved
+crow::response matchedRequestResponse(Recipient* newRequest, const MatchingEngine::TimedMatch& match,
+                                      std::chrono::milliseconds budget) {
+    Donor* matchedDonor = match.donor;
+    JsonWriter response(JsonWriter::threadBuffer());
+    LatencyMetrics::Timer encodeTimer(metrics, jsonEncodePhase);
+    response.beginObject();
+    response.field("success", true);
+    response.field("requestId", newRequest->id);
+    response.field("unitsNeeded", newRequest->unitsNeeded);
+    response.field("unitsReserved", match.units.getSize());
+    response.field("deadlineMs", static_cast<int64_t>(budget.count()));
+    response.field("optimal", match.optimal); // false = best found before the deadline
+    
+    if (matchedDonor) {
+        // Route/ETA - Same pair was just asked by the matcher, so this is a cache hit
+        // (misses fall back to bidirectional Dijkstra)
+        double routeDistance = matchingEngine->distanceBetween(matchedDonor->locationNodeId, newRequest->locationNodeId);
+        
+        response.field("matched", true);
+        response.field("donorName", matchedDonor->name);
+        response.field("donorId", matchedDonor->id);
+        response.field("distance", routeDistance);
+        response.field("estimatedTime", static_cast<int>(match.travelMinutes + 0.5)); // Time-dependent ETA (minutes)
+        response.field("completionTime", static_cast<int>(match.completionMinutes() + 0.5)); // Last unit arrives
+        response.key("donors");
+        response.beginArray();
+        for (size_t i = 0; i < match.units.getSize(); ++i) {
+            Donor* d = match.units[i].donor;
+            response.beginObject();
+            response.field("donorId", d->id);
+            response.field("name", d->name);
+            response.field("bloodGroup", d->bloodGroup);
+            response.field("distance", matchingEngine->distanceBetween(d->locationNodeId, newRequest->locationNodeId));
+            response.field("estimatedTime", static_cast<int>(match.units[i].travelMinutes + 0.5));
+            response.endObject();
+        }
+        response.endArray();
+    } else {
+        response.field("matched", false);
+        response.field("message", "Searching for compatible donors...");
+    }
+    response.endObject();
+    return jsonResponse(200, response.str());
+}
+
+// Second half of POST /api/recipient/request, on the pool once the writer has given the
+// request its id. Broadcast offers answer right here; reserve mode queues on the batcher,
+// whose callback queues the status write, whose callback hands the reply back to the
+// pool - no thread waits on another along the way
+void dispatchRequest(Recipient* newRequest, const RequestOptions& options,
+                     const CustomVector<MatchingEngine::DonorCandidate>& offered, const Responder& respond) {
+    liveFeed->notify(newRequest);
+    
+    if (!offered.empty()) {
+        CustomVector<std::string> donorIds;
+        crow::json::wvalue offer;
+        offer["type"] = "dispatch";
+        offer["requestId"] = newRequest->id;
+        offer["bloodGroup"] = newRequest->bloodGroupNeeded;
+        offer["urgency"] = newRequest->urgency;
+        offer["unitsNeeded"] = newRequest->unitsNeeded;
+        offer["hospitalNode"] = newRequest->locationNodeId;
+        offer["hospitalName"] = newRequest->hospitalName;
+        offer["expiresInSeconds"] = BROADCAST_OFFER_SECONDS;
+        JsonWriter response(JsonWriter::threadBuffer());
+        response.beginObject();
+        response.field("success", true);
+        response.field("requestId", newRequest->id);
+        response.field("dispatch", "broadcast");
+        response.field("matched", false);
+        response.field("unitsNeeded", newRequest->unitsNeeded);
+        response.key("donorsNotified");
+        response.beginArray();
+        for (size_t i = 0; i < offered.getSize(); ++i) {
+            donorIds.push_back(offered[i].donor->id);
+            response.beginObject();
+            response.field("donorId", offered[i].donor->id);
+            response.field("name", offered[i].donor->name);
+            response.field("distance", offered[i].distance);
+            response.endObject();
+        }
+        response.endArray();
+        response.field("connectionsReached", dispatchBoard->open(newRequest->id, newRequest->unitsNeeded,
+                                                                 donorIds, offer.dump()));
+        // Donors without the app open get the offer by SMS
+        for (size_t i = 0; i < offered.getSize(); ++i) {
+            notifyDonor(offered[i].donor, "dispatch", "BloodConnect URGENT: " + newRequest->bloodGroupNeeded +
+                        " needed at " + newRequest->hospitalName + " (" + newRequest->id +
+                        "). First donors to accept in the app are assigned.");
+        }
+        response.field("message", "Offer sent - first donors to accept are assigned");
+        response.endObject();
+        return respond(jsonResponse(200, response.str()));
+    }
+    
+    // Try to find a match - ranked by arrival time under current traffic
+    double departureMinute = options.departureMinute >= 0 ? options.departureMinute : currentMinuteOfDay();
+    // Latency bound - client's deadlineMs, else derived from urgency (Immediate: 50 ms)
+    std::chrono::milliseconds budget = MatchingEngine::matchBudget(newRequest);
+    if (options.deadlineMs > 0) {
+        budget = std::chrono::milliseconds(std::min<int64_t>(options.deadlineMs, 10000));
+    }
+    MatchingEngine::Deadline deadline = std::chrono::steady_clock::now() + budget;
+    // Goes through the batcher: concurrent requests for the same hospital share one search
+    // Up to unitsNeeded donors (fastest first) are reserved together and recorded on the request
+    matchBatcher->submit(newRequest, departureMinute, deadline,
+        [newRequest, budget, respond](const MatchingEngine::TimedMatch& match) {
+            // Batcher thread - queue the write and get back to the next window
+            bool matched = match.donor != nullptr;
+            store->executeThen([newRequest, matched](StateStore::State& state) {
+                if (matched) {
+                    // All units reserved -> Matched; otherwise the next global pass tops up the rest
+                    // Reserved donors are already "Busy" - reserved by the batcher
+                    // Persist both databases to reflect match and donor status
+                    matchingEngine->synchronized([newRequest] {
+                        newRequest->status = MatchingEngine::unitsRemaining(newRequest) == 0 ? "Matched" : "Pending";
+                    });
+                    state.touch(newRequest);
+                    state.saveDonors();
+                    state.saveRecipients();
+                } else {
+                    // Stays in the queue - picked up by the next global assignment pass
+                    matchingEngine->synchronized([newRequest] { newRequest->status = "Pending"; });
+                    state.touch(newRequest);
+                }
+            }, [newRequest, match, budget, respond](std::future<void>& saved) {
+                try {
+                    saved.get();
+                } catch (const std::exception& e) {
+                    return respond(crow::response(500, e.what()));
+                }
+                // Writer thread - route lookups for the reply may run Dijkstra, so encode on the pool
+                workPool->submit([newRequest, match, budget, respond] {
+                    try {
+                        crow::response reply = matchedRequestResponse(newRequest, match, budget);
+                        liveFeed->notify(newRequest);
+                        respond(std::move(reply));
+                    } catch (const std::exception& e) {
+                        respond(crow::response(500, e.what()));
+                    }
+                });
+            });
+        });
+}
+
+// Histogram for a request path - exact route, then its "<string>" template, then other/static
+LatencyMetrics::Series routeSeriesFor(const std::string& url) {
+    LatencyMetrics::Series series = -1;
+    if (routeSeries->get(url, series)) return series;
+    size_t slash = url.rfind('/');
+    if (slash != std::string::npos && slash > 0 && routeSeries->get(url.substr(0, slash) + "/<string>", series)) {
+        return series;
+    }
+    routeSeries->get(url.compare(0, 5, "/api/") == 0 ? "other" : "static", series);
+    return series;
+}
+
+// Per-route latency for /metrics: request parsed -> response handed back to the I/O
+// thread. Offloaded handlers count until their res.end(), so pool queueing is included
+struct RequestMetrics {
+    struct context {
+        std::chrono::steady_clock::time_point started;
+    };
+    void before_handle(crow::request& /*req*/, crow::response& /*res*/, context& ctx) {
+        ctx.started = std::chrono::steady_clock::now();
+    }
+    void after_handle(crow::request& req, crow::response& /*res*/, context& ctx) {
+        uint64_t nanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - ctx.started).count());
+        metrics->observeNanos(routeSeriesFor(req.url), nanos);
+        metrics->observeNanos(httpPhase, nanos);
+    }
+};
+
+// Static file from the asset cache - 304 when the browser's copy is current
+crow::response staticResponse(const crow::request& req, const std::string& path) {
+    StaticAssetCache::Result hit = staticAssets->lookup(path, req.get_header_value("Accept-Encoding"),
+                                                        req.get_header_value("If-None-Match"));
+    if (hit.status == 404) return crow::response(404);
+    const StaticAssetCache::Variant& variant = hit.variant();
+    crow::response res(hit.status);
+    res.set_header("ETag", variant.etag);
+    res.set_header("Cache-Control", "no-cache"); // Revalidate every time - costs a 304, not the file
+    res.set_header("Vary", "Accept-Encoding");
+    if (hit.status == 200) {
+        res.set_header("Content-Type", hit.asset->contentType);
+        if (hit.encoding == StaticAssetCache::GZIP) res.set_header("Content-Encoding", "gzip");
+        if (hit.encoding == StaticAssetCache::BROTLI) res.set_header("Content-Encoding", "br");
+        res.body = variant.body;
+    }
+    return res;
+}
+
 void loadData() {
     std::cout << "Loading data from CSV files..." << std::endl;
     
@@ -66,77 +445,166 @@ void loadData() {
     cityGraph.addEdge("H3", "D3", 4.5);
     cityGraph.addEdge("D1", "D2", 2.1);
     
-    // Load donors from CSV
-    std::ifstream donorFile(DONORS_CSV);
-    std::string line;
-    if (donorFile.is_open()) {
-        std::getline(donorFile, line);
-        while (std::getline(donorFile, line)) {
-            if (line.empty()) continue;
-            Donor* d = CSVHandler::csvToDonor(line);
-            if (d) {
-                donorDatabase.insert(d->id, d);
-                matchingEngine->addDonor(d);
-                int idNum = std::stoi(d->id.substr(4));
-                if (idNum >= donorCounter) donorCounter = idNum + 1;
+    // Traffic profiles (minutes per km over the day, PKT)
+    // Arterial roads jam in the morning and evening rush
+    CustomVector<std::pair<int, double>> arterial;
+    arterial.push_back({0, 1.8});      // 00:00 empty roads
+    arterial.push_back({420, 2.2});    // 07:00
+    arterial.push_back({510, 5.5});    // 08:30 morning rush peak
+    arterial.push_back({630, 3.0});    // 10:30
+    arterial.push_back({1020, 3.2});   // 17:00
+    arterial.push_back({1110, 6.0});   // 18:30 evening rush peak
+    arterial.push_back({1230, 2.8});   // 20:30
+    unsigned short arterialProfile = cityGraph.addTravelProfile(arterial);
+    cityGraph.setEdgeProfile("H1", "D1", arterialProfile);
+    cityGraph.setEdgeProfile("H2", "D1", arterialProfile);
+    cityGraph.setEdgeProfile("H2", "D2", arterialProfile);
+    cityGraph.setEdgeProfile("H3", "D3", arterialProfile);
+    
+    // One command for the whole load - readers see the first snapshot with everything in it
+    store->execute([](StateStore::State& state) {
+        // Load donors from CSV
+        std::ifstream donorFile(DONORS_CSV);
+        std::string line;
+        if (donorFile.is_open()) {
+            std::getline(donorFile, line);
+            while (std::getline(donorFile, line)) {
+                if (line.empty()) continue;
+                Donor* d = CSVHandler::csvToDonor(line);
+                if (d) {
+                    state.addDonor(d); // Also moves the id counter past this id
+                    matchingEngine->addDonor(d);
+                }
             }
+            donorFile.close();
         }
-        donorFile.close();
-    }
-    
-    // Load recipients from CSV
-    std::ifstream recipientFile(RECIPIENTS_CSV);
-    if (recipientFile.is_open()) {
-        std::getline(recipientFile, line);
-        while (std::getline(recipientFile, line)) {
-            if (line.empty()) continue;
-            Recipient* r = CSVHandler::csvToRecipient(line);
-            if (r) {
-                recipientDatabase.insert(r->id, r);
-                int idNum = std::stoi(r->id.substr(4));
-                if (idNum >= recipientCounter) recipientCounter = idNum + 1;
+        
+        // Load recipients from CSV
+        std::ifstream recipientFile(RECIPIENTS_CSV);
+        if (recipientFile.is_open()) {
+            std::getline(recipientFile, line);
+            while (std::getline(recipientFile, line)) {
+                if (line.empty()) continue;
+                Recipient* r = CSVHandler::csvToRecipient(line);
+                if (r) {
+                    state.addRecipient(r);
+                    // Unmatched requests go back into the queue for the global assignment pass
+                    if (r->status == "Pending") matchingEngine->addRecipientRequest(r);
+                }
             }
+            recipientFile.close();
         }
-        recipientFile.close();
-    }
-    
-    // Load transactions (newest first - reverse chronological order)
-    std::ifstream transFile(TRANSACTIONS_CSV);
-    if (transFile.is_open()) {
-        std::getline(transFile, line);
-        while (std::getline(transFile, line)) {
-            if (line.empty()) continue;
-            Transaction* t = CSVHandler::csvToTransaction(line);
-            if (t) {
-                transactionHistory.push_front(t);
-                int idNum = std::stoi(t->id.substr(4));
-                if (idNum >= transactionCounter) transactionCounter = idNum + 1;
+        
+        // Load transactions (newest first - reverse chronological order)
+        std::ifstream transFile(TRANSACTIONS_CSV);
+        if (transFile.is_open()) {
+            std::getline(transFile, line);
+            while (std::getline(transFile, line)) {
+                if (line.empty()) continue;
+                Transaction* t = CSVHandler::csvToTransaction(line);
+                if (t) state.addTransaction(t);
             }
+            transFile.close();
         }
-        transFile.close();
-    }
-    
-    std::cout << "Data loaded: Donors=" << donorDatabase.getSize() 
-              << ", Recipients=" << recipientDatabase.getSize() << std::endl;
+        
+        std::cout << "Data loaded: Donors=" << state.donorCount()
+                  << ", Recipients=" << state.recipientCount() << std::endl;
+    });
 }
 
 int main() {
-    crow::SimpleApp app;
+    // Every request goes through RequestMetrics (route latency histograms)
+    crow::App<RequestMetrics> app;
+    
+    // Metrics first - the engine and store register their phases on attach
+    metrics = new LatencyMetrics();
+    httpPhase = metrics->phase("http");
+    jsonEncodePhase = metrics->phase("json_encode");
+    persistencePhase = metrics->phase("persistence");
+    routeSeries = new CustomHashMap<std::string, LatencyMetrics::Series>();
+    for (const char* route : METRIC_ROUTES) routeSeries->insert(route, metrics->route(route));
     
     // Initialize matching engine - matches donors and recipients
     // Uses Dijkstra algorithm to find nearest donors
     matchingEngine = new MatchingEngine(&cityGraph);
+    matchingEngine->attachMetrics(metrics);
+    
+    // Timing wheel (1 s ticks) - reservation timeouts, request expiry and
+    // eligibility reactivation; attached before loading so parked donors get timers
+    timerWheel = new TimerWheel();
+    matchingEngine->attachTimers(timerWheel, std::chrono::minutes(RESERVATION_TIMEOUT_MINUTES),
+                                 std::chrono::hours(REQUEST_EXPIRY_HOURS));
+    timerWheel->start();
+    
+    // Single writer for all shared state; snapshot copies are taken under the engine's lock
+    store = new StateStore("data/donors.csv", "data/recipients.csv",
+                           [](const std::function<void()>& copy) { matchingEngine->synchronized(copy); });
+    store->attachMetrics(metrics);
     
     // Load all data from CSV files
     loadData();
     
+    // Topic hub for /ws - slow clients lose their oldest queued frames, never server memory
+    wsHub = new WebSocketHub(WS_ACK_WINDOW, WS_QUEUE_FRAMES, WebSocketHub::DROP_OLDEST);
+    // Request status deltas on request:<id> - the engine reports its own background changes
+    liveFeed = new LiveRequestFeed(wsHub);
+    // (called under the engine's lock - the store only gets a posted touch, never a blocking execute)
+    matchingEngine->setRequestListener([](const Recipient* r) {
+        liveFeed->notify(r);
+        std::string id = r->id;
+        store->post([id](StateStore::State& state) { state.touchRecipient(id); });
+    });
+    // Unclaimed broadcast units fall back to the reservation path (next global pass)
+    dispatchBoard = new DispatchBoard(wsHub, timerWheel, std::chrono::seconds(BROADCAST_OFFER_SECONDS),
+        [](const std::string& requestId, int) { reopenBroadcast(requestId); });
+    
+    // Notification outbox - undelivered messages from the last run are replayed from the journal
+    smsGateway = new HttpGateway(NOTIFY_GATEWAY_URL);
+    outbox = new NotificationOutbox(smsGateway->asGateway(), OUTBOX_JOURNAL, OUTBOX_WORKERS, OUTBOX_BATCH,
+                                   std::chrono::milliseconds(OUTBOX_LINGER_MS));
+    matchingEngine->setDonorListener([](MatchingEngine::DonorEvent event, const Donor* d, const Recipient* r) {
+        if (event == MatchingEngine::DONOR_RESERVED) {
+            notifyDonor(d, "match", "BloodConnect: You have been matched to a " + r->bloodGroupNeeded +
+                        " request at " + r->hospitalName + " (" + r->id + "). Please accept in the app.");
+        } else if (event == MatchingEngine::DONOR_ELIGIBLE) {
+            notifyDonor(d, "reminder", "BloodConnect: You are eligible to donate again. Thank you for saving lives!");
+        }
+        std::string donorId = d->id;
+        std::string recipientId = r ? r->id : std::string();
+        store->post([donorId, recipientId](StateStore::State& state) {
+            state.touchDonor(donorId);
+            if (!recipientId.empty()) state.touchRecipient(recipientId);
+        });
+    });
+    outbox->start();
+    
+    // Serialized dashboard bodies, keyed by donor id + entry version
+    dashboardCache = new VersionedResponseCache();
+    
+    // Heavy route handlers run here; the I/O threads only parse and write
+    workPool = new WorkStealingPool(WORK_POOL_THREADS);
+    
+    // Batching front-end - all matching runs on its thread, so no donor is double-booked
+    matchBatcher = new MatchBatcher(matchingEngine, MATCH_BATCH_WINDOW_MICROS);
+    
+    // Small city graph - precompute all-pairs distances once
+    // (cache falls back to per-pair/per-hospital entries on large graphs)
+    matchingEngine->getDistanceCache().buildAllPairs();
+    coverageSolver = new DeltaStepping(cityGraph);
+    
     // Enable CORS - accept requests from web frontend
     app.loglevel(crow::LogLevel::Info);
     
-    // Serve static files (HTML/CSS/JS)
-    CROW_ROUTE(app, "/")([](){
-        auto page = crow::mustache::load("index.html");
-        return page.render();
+    // Serve static files (HTML/CSS/JS) from memory - no disk read or template render per hit
+    staticAssets = new StaticAssetCache(PUBLIC_DIR, std::chrono::milliseconds(STATIC_WATCH_MS));
+    std::cout << "Cached " << staticAssets->start() << " static assets from " << PUBLIC_DIR << "/" << std::endl;
+    CROW_ROUTE(app, "/")([](const crow::request& req){
+        return staticResponse(req, "");
+    });
+    // Any path no route matched (e.g. /login.html, /css/style.css) - API routes always win
+    CROW_CATCHALL_ROUTE(app)([](const crow::request& req){
+        if (req.method != "GET"_method) return crow::response(404);
+        return staticResponse(req, req.url);
     });
     
     // API: Register Donor
@@ -152,63 +620,100 @@ int main() {
     //   - But CSV is simple and sufficient for this project
     //   - CSV data is escaped/unescaped by CSVHandler
     CROW_ROUTE(app, "/api/auth/register/donor").methods("POST"_method)
-    ([](const crow::request& req){
-        auto body = crow::json::load(req.body);
-        if (!body) {
-            return crow::response(400, "Invalid JSON");
-        }
-        
+    (offloadAsync([](const crow::request& req, const Responder& respond){
+        // Parsed straight into the Donor - fields left out keep the defaults set here
         Donor* newDonor = new Donor();
-        newDonor->id = generateDonorId();
-        newDonor->name = body["name"].s();
-        newDonor->cnic = body["cnic"].s();
-        newDonor->age = body["age"].i();
-        newDonor->gender = body["gender"].s();
-        newDonor->email = body["email"].s();
-        newDonor->phone = body["phone"].s();
-        newDonor->address = body["address"].s();
-        newDonor->bloodGroup = body["bloodGroup"].s();
-        newDonor->city = body["city"].s();
-        newDonor->area = body["area"].s();
-        newDonor->locationNodeId = body.has("locationNodeId") ? body["locationNodeId"].s() : std::string("D1");
+        newDonor->locationNodeId = "D1";
+        if (!JsonReader(req.body).parse<DonorRegistrationJson>(*newDonor)) {
+            delete newDonor;
+            return respond(crow::response(400, "Invalid JSON"));
+        }
         newDonor->status = "Available";
         newDonor->totalDonations = 0;
         newDonor->badgeLevel = "Bronze";
         newDonor->isVerified = false;
-        newDonor->passwordHash = body["password"].s();
-        
-        // Add to HashMap - for fast lookup
-        donorDatabase.insert(newDonor->id, newDonor);
-        matchingEngine->addDonor(newDonor);
-        
-        // Persist to CSV file permanently
-        std::ofstream donorFile(DONORS_CSV, std::ios::app);
-        donorFile << CSVHandler::donorToCSV(*newDonor) << std::endl;
-        donorFile.close();
-        
-        crow::json::wvalue response;
-        response["success"] = true;
-        response["message"] = "Donor registered successfully";
-        response["donorId"] = newDonor->id;
-        response["role"] = "donor";
+        if (!newDonor->lastDonationDate.empty()) {
+            // Recent donors wait out the donation interval before they can be matched
+            newDonor->lastDonationDay = EpochDays::parse(newDonor->lastDonationDate);
+            if (newDonor->lastDonationDay != EpochDays::NONE) {
+                newDonor->nextEligibleDay = newDonor->lastDonationDay + MatchingEngine::DONATION_INTERVAL_DAYS;
+                newDonor->nextEligibleDate = EpochDays::format(newDonor->nextEligibleDay);
+            }
+        }
         
-        return crow::response(200, response);
-    });
+        // Id, HashMap insert and CSV append happen on the store's writer - ids never collide
+        commitThenRespond([newDonor](StateStore::State& state) {
+            newDonor->id = state.nextDonorId();
+            state.addDonor(newDonor);
+            matchingEngine->addDonor(newDonor);
+            
+            // Persist to CSV file permanently
+            {
+                LatencyMetrics::Timer persistTimer(metrics, persistencePhase);
+                std::ofstream donorFile(DONORS_CSV, std::ios::app);
+                donorFile << CSVHandler::donorToCSV(*newDonor) << std::endl;
+                donorFile.close();
+            }
+            
+            JsonWriter response(JsonWriter::threadBuffer());
+            LatencyMetrics::Timer encodeTimer(metrics, jsonEncodePhase);
+            response.beginObject();
+            response.field("success", true);
+            response.field("message", "Donor registered successfully");
+            response.field("donorId", newDonor->id);
+            response.field("role", "donor");
+            response.endObject();
+            return jsonResponse(200, response.str());
+        }, respond);
+    }));
 
     // WebSocket: Real-time updates
     // This is direct server-client communication via persistent connection
     // Instead of HTTP request-response - connection stays open
-    // Can send instant notifications about new matches
+    // Clients subscribe to topics and get pushed notifications:
+    //   {"op":"subscribe","topic":"donor:DON-001"}       -> {"type":"subscribed",...}
+    //   {"op":"unsubscribe","topic":"request:REC-001"}
+    //   {"op":"ack","count":N}   N = frames received so far (keeps the window open)
+    // Topics: group:<bloodGroup>|area:<nodeId>, request:<id>, donor:<id>
     CROW_WEBSOCKET_ROUTE(app, "/ws")
     .onopen([&](crow::websocket::connection& conn) {
-        std::cout << "WebSocket opened" << std::endl;
+        WebSocketHub::Endpoint endpoint;
+        endpoint.send = [&conn](const WebSocketHub::Frame& frame) { conn.send_text(*frame); };
+        endpoint.close = [&conn](const std::string& reason) { conn.close(reason); };
+        WebSocketHub::ConnectionId id = wsHub->connect(endpoint);
+        conn.userdata(reinterpret_cast<void*>(id));
     })
     .onclose([&](crow::websocket::connection& conn, const std::string& reason, unsigned short code) {
         std::cout << "WebSocket closed: " << reason << " (code: " << code << ")" << std::endl;
+        wsHub->disconnect(reinterpret_cast<WebSocketHub::ConnectionId>(conn.userdata()));
+    })
+    .onerror([&](crow::websocket::connection& conn, const std::string& error) {
+        std::cout << "WebSocket error: " << error << std::endl;
+        wsHub->disconnect(reinterpret_cast<WebSocketHub::ConnectionId>(conn.userdata()));
     })
     .onmessage([&](crow::websocket::connection& conn, const std::string& data, bool is_binary) {
-        // Send direct messages (e.g., new match notifications)
-        conn.send_text("Message received: " + data);
+        WebSocketHub::ConnectionId id = reinterpret_cast<WebSocketHub::ConnectionId>(conn.userdata());
+        auto message = crow::json::load(data);
+        if (!message || !message.has("op")) {
+            wsHub->sendTo(id, "{\"type\":\"error\",\"error\":\"invalid message\"}");
+            return;
+        }
+        std::string op = message["op"].s();
+        if (op == "ack" && message.has("count")) {
+            wsHub->acknowledge(id, static_cast<unsigned long>(message["count"].i()));
+        } else if (op == "latency" && message.has("ms")) {
+            liveFeed->recordLatency(message["ms"].d()); // Client-measured transition -> receive time
+        } else if ((op == "subscribe" || op == "unsubscribe") && message.has("topic")) {
+            std::string topic = message["topic"].s();
+            bool ok = op == "subscribe" ? wsHub->subscribe(id, topic) : wsHub->unsubscribe(id, topic);
+            crow::json::wvalue reply;
+            reply["type"] = op == "subscribe" ? "subscribed" : "unsubscribed";
+            reply["topic"] = topic;
+            reply["ok"] = ok;
+            wsHub->sendTo(id, reply.dump());
+        } else {
+            wsHub->sendTo(id, "{\"type\":\"error\",\"error\":\"unknown op\"}");
+        }
     });
     
     // API: ریسیپینٹ کو رجسٹر کریں
@@ -221,40 +726,41 @@ int main() {
     //   4. CSV فائل میں محفوظ کریں
     // اہم: اس کے بعد میچنگ انجن نزدیک ترین ڈونرز تلاش کرے گا
     CROW_ROUTE(app, "/api/auth/register/recipient").methods("POST"_method)
-    ([](const crow::request& req){
-        auto body = crow::json::load(req.body);
-        if (!body) {
-            return crow::response(400, "Invalid JSON");
-        }
-        
+    (offloadAsync([](const crow::request& req, const Responder& respond){
         Recipient* newRecipient = new Recipient();
-        newRecipient->id = generateRecipientId();
-        newRecipient->patientName = body["patientName"].s();
-        newRecipient->age = body.has("age") ? body["age"].i() : 0;
-        newRecipient->bloodGroupNeeded = body["bloodGroupNeeded"].s();
-        newRecipient->urgency = body["urgency"].s();
-        newRecipient->hospitalName = body.has("hospitalName") ? body["hospitalName"].s() : std::string("");
-        newRecipient->locationNodeId = body.has("locationNodeId") ? body["locationNodeId"].s() : std::string("H1");
-        newRecipient->contactPerson = body["contactPerson"].s();
-        newRecipient->contactPhone = body["contactPhone"].s();
+        newRecipient->locationNodeId = "H1";
+        if (!JsonReader(req.body).parse<RecipientFormJson>(*newRecipient)) {
+            delete newRecipient;
+            return respond(crow::response(400, "Invalid JSON"));
+        }
+        newRecipient->unitsNeeded = std::max(1, std::min(newRecipient->unitsNeeded, 10));
         newRecipient->status = "Pending";
         newRecipient->timestamp = getCurrentTimestamp();
         
-        recipientDatabase.insert(newRecipient->id, newRecipient);
-        
-        // Persist to CSV
-        std::ofstream recipFile(RECIPIENTS_CSV, std::ios::app);
-        recipFile << CSVHandler::recipientToCSV(*newRecipient) << std::endl;
-        recipFile.close();
-        
-        crow::json::wvalue response;
-        response["success"] = true;
-        response["message"] = "Recipient registered successfully";
-        response["recipientId"] = newRecipient->id;
-        response["role"] = "recipient";
-        
-        return crow::response(200, response);
-    });
+        commitThenRespond([newRecipient](StateStore::State& state) {
+            newRecipient->id = state.nextRecipientId();
+            state.addRecipient(newRecipient);
+            matchingEngine->addRecipientRequest(newRecipient);
+            
+            // Persist to CSV
+            {
+                LatencyMetrics::Timer persistTimer(metrics, persistencePhase);
+                std::ofstream recipFile(RECIPIENTS_CSV, std::ios::app);
+                recipFile << CSVHandler::recipientToCSV(*newRecipient) << std::endl;
+                recipFile.close();
+            }
+            
+            JsonWriter response(JsonWriter::threadBuffer());
+            LatencyMetrics::Timer encodeTimer(metrics, jsonEncodePhase);
+            response.beginObject();
+            response.field("success", true);
+            response.field("message", "Recipient registered successfully");
+            response.field("recipientId", newRecipient->id);
+            response.field("role", "recipient");
+            response.endObject();
+            return jsonResponse(200, response.str());
+        }, respond);
+    }));
     
     // API: Login
     CROW_ROUTE(app, "/api/auth/login").methods("POST"_method)
@@ -267,42 +773,42 @@ int main() {
         std::string email = body["email"].s();
         std::string password = body["password"].s();
         
+        // Read-only scan of the published snapshot - no lock, writers keep going
+        std::shared_ptr<const StateStore::Snapshot> snapshot = store->snapshot();
+        crow::json::wvalue response;
+        bool found = false;
+        
         // Check donors
-        CustomVector<std::string> donorIds = donorDatabase.getKeys();
-        for (size_t i = 0; i < donorIds.getSize(); ++i) {
-            Donor* donor;
-            if (donorDatabase.get(donorIds[i], donor)) {
-                if (donor->email == email && donor->passwordHash == password) {
-                    crow::json::wvalue response;
-                    response["success"] = true;
-                    response["role"] = "donor";
-                    response["userId"] = donor->id;
-                    response["name"] = donor->name;
-                    return crow::response(200, response);
-                }
+        snapshot->donors.forEach([&](const std::string&, const StateStore::DonorEntry& entry) {
+            const Donor* donor = entry.view.get();
+            if (donor->email == email && donor->passwordHash == password) {
+                response["success"] = true;
+                response["role"] = "donor";
+                response["userId"] = donor->id;
+                response["name"] = donor->name;
+                found = true;
             }
-        }
+            return !found;
+        });
+        if (found) return crow::response(200, response);
 
         // Check recipients
-        CustomVector<std::string> recipientIds = recipientDatabase.getKeys();
-        for (size_t i = 0; i < recipientIds.getSize(); ++i) {
-            Recipient* rec;
-            if (recipientDatabase.get(recipientIds[i], rec)) {
-                // For recipients, we'll check against patientName as name for now
-                // REAL APP would have email/pass fields in Recipient struct too
-                // For this project, let's assume contactPhone as pass or simulate match
-                if (rec->patientName + "@blood.com" == email) { 
-                    crow::json::wvalue response;
-                    response["success"] = true;
-                    response["role"] = "recipient";
-                    response["userId"] = rec->id;
-                    response["name"] = rec->patientName;
-                    return crow::response(200, response);
-                }
+        snapshot->recipients.forEach([&](const std::string&, const StateStore::RecipientEntry& entry) {
+            const Recipient* rec = entry.view.get();
+            // For recipients, we'll check against patientName as name for now
+            // REAL APP would have email/pass fields in Recipient struct too
+            // For this project, let's assume contactPhone as pass or simulate match
+            if (rec->patientName + "@blood.com" == email) { 
+                response["success"] = true;
+                response["role"] = "recipient";
+                response["userId"] = rec->id;
+                response["name"] = rec->patientName;
+                found = true;
             }
-        }
+            return !found;
+        });
+        if (found) return crow::response(200, response);
         
-        crow::json::wvalue response;
         response["success"] = false;
         response["message"] = "Invalid credentials";
         return crow::response(401, response);
@@ -310,152 +816,459 @@ int main() {
 
     // API: Update Donor Info
     CROW_ROUTE(app, "/api/donor/update").methods("POST"_method)
-    ([](const crow::request& req){
+    (offloadAsync([](const crow::request& req, const Responder& respond){
         auto body = crow::json::load(req.body);
-        if (!body || !body.has("donorId")) return crow::response(400);
+        if (!body || !body.has("donorId")) return respond(crow::response(400));
 
         std::string donorId = body["donorId"].s();
-        Donor* d;
-        if (donorDatabase.get(donorId, d)) {
-            if (body.has("name")) d->name = body["name"].s();
-            if (body.has("age")) d->age = body["age"].i();
-            if (body.has("phone")) d->phone = body["phone"].s();
-            if (body.has("city")) d->city = body["city"].s();
-            if (body.has("area")) d->area = body["area"].s();
-            if (body.has("address")) d->address = body["address"].s();
-
-            CSVHandler::saveAllDonors("data/donors.csv", donorDatabase);
+        commitThenRespond([body, donorId](StateStore::State& state) {
+            Donor* d = state.donor(donorId);
+            if (!d) return crow::response(404, "Donor not found");
+            matchingEngine->synchronized([&] {
+                if (body.has("name")) d->name = body["name"].s();
+                if (body.has("age")) d->age = body["age"].i();
+                if (body.has("phone")) d->phone = body["phone"].s();
+                if (body.has("city")) d->city = body["city"].s();
+                if (body.has("area")) d->area = body["area"].s();
+                if (body.has("address")) d->address = body["address"].s();
+            });
+            state.touch(d);
+            state.saveDonors(); // One save per writer batch, however many updates it holds
             return crow::response(200, "Update successful");
-        }
-        return crow::response(404, "Donor not found");
-    });
+        }, respond);
+    }));
     CROW_ROUTE(app, "/api/donor/status").methods("POST"_method)
-    ([](const crow::request& req){
+    (offloadAsync([](const crow::request& req, const Responder& respond){
         auto body = crow::json::load(req.body);
-        if (!body || !body.has("donorId") || !body.has("status")) return crow::response(400);
+        if (!body || !body.has("donorId") || !body.has("status")) return respond(crow::response(400));
 
         std::string donorId = body["donorId"].s();
         std::string status = body["status"].s();
 
-        Donor* d;
-        if (donorDatabase.get(donorId, d)) {
-            d->status = status;
-            CSVHandler::saveAllDonors("data/donors.csv", donorDatabase);
+        commitThenRespond([donorId, status](StateStore::State& state) {
+            Donor* d = state.donor(donorId);
+            if (!d) return crow::response(404, "Donor not found");
+            matchingEngine->synchronized([&] { d->status = status; });
+            state.touch(d);
+            state.saveDonors();
             return crow::response(200, "Status updated");
-        }
-        return crow::response(404, "Donor not found");
-    });
+        }, respond);
+    }));
     
     // API: Accept Blood Request
     CROW_ROUTE(app, "/api/donor/accept-request").methods("POST"_method)
-    ([](const crow::request& req){
+    (offloadAsync([](const crow::request& req, const Responder& respond){
         auto body = crow::json::load(req.body);
-        if (!body || !body.has("donorId") || !body.has("requestId")) return crow::response(400);
+        if (!body || !body.has("donorId") || !body.has("requestId")) return respond(crow::response(400));
 
         std::string donorId = body["donorId"].s();
         std::string requestId = body["requestId"].s();
 
-        Donor* d;
-        Recipient* r;
-        if (donorDatabase.get(donorId, d) && recipientDatabase.get(requestId, r)) {
-            r->status = "Completed";
-            r->matchedDonorId = donorId;
-            d->status = "Available";
-            d->totalDonations++;
+        std::shared_ptr<const StateStore::Snapshot> snapshot = store->snapshot();
+        StateStore::DonorEntry donorEntry;
+        StateStore::RecipientEntry recipientEntry;
+        if (snapshot->donors.get(donorId, donorEntry) && snapshot->recipients.get(requestId, recipientEntry)) {
+            Donor* d = donorEntry.live;
+            Recipient* r = recipientEntry.live;
+            // Broadcast offers: the claim is one atomic step; losers are turned away here,
+            // before the writer queue, any state or CSV file is touched
+            int unitsLeft = 0;
+            DispatchBoard::ClaimResult claim = dispatchBoard->claim(requestId, donorId, &unitsLeft);
+            if (claim == DispatchBoard::FILLED) return respond(crow::response(409, "Request already filled"));
+            if (claim == DispatchBoard::NOT_OFFERED) return respond(crow::response(409, "Request was not offered to this donor"));
+            if (claim == DispatchBoard::ALREADY_CLAIMED) return respond(crow::response(409, "Already accepted"));
+            if (claim == DispatchBoard::WON && !matchingEngine->claimDonor(d)) {
+                // Won a slot but the donor is no longer Available (reserved elsewhere or parked):
+                // hand the slot back. If the offer expired meanwhile, expiry already counted this
+                // slot as taken, so the request is reopened here instead
+                if (!dispatchBoard->release(requestId, donorId)) reopenBroadcast(requestId);
+                return respond(crow::response(409, "Donor is not available"));
+            }
+            // More units still open on the broadcast - this donor's unit is recorded, request stays open
+            bool partial = claim == DispatchBoard::WON && unitsLeft > 0;
             
-            // Create a transaction record
-            Transaction* t = new Transaction();
-            t->id = "TRN-" + std::to_string(transactionCounter++);
-            t->donorId = donorId;
-            t->recipientId = requestId;
-            t->bloodGroup = d->bloodGroup;
-            t->status = "Success";
-            t->timestamp = getCurrentTimestamp();
-            transactionHistory.push_front(t);
-
-            // Persist all changes
-            CSVHandler::saveAllDonors("data/donors.csv", donorDatabase);
-            CSVHandler::saveAllRecipients("data/recipients.csv", recipientDatabase);
-            std::ofstream transFile("data/transactions.csv", std::ios::app);
-            transFile << CSVHandler::transactionToCSV(*t) << std::endl;
-            transFile.close();
+            // Winners of one multi-unit broadcast (and plain accepts) are applied one at a time by the writer
+            return commitThenRespond([=](StateStore::State& state) {
+                bool completed = false;
+                if (claim == DispatchBoard::NO_OFFER) {
+                    // Reserved units: only a donor holding one of this request's reservations
+                    // may accept, and the request completes once every unit has been donated
+                    MatchingEngine::AcceptResult accepted = matchingEngine->acceptReservedUnit(r, d);
+                    if (accepted == MatchingEngine::REQUEST_CLOSED) return crow::response(409, "Request already filled");
+                    if (accepted == MatchingEngine::NOT_RESERVED) return crow::response(409, "Donor is not reserved for this request");
+                    if (accepted == MatchingEngine::ALREADY_ACCEPTED) return crow::response(409, "Already accepted");
+                    completed = accepted == MatchingEngine::REQUEST_COMPLETED;
+                    liveFeed->accepted(r, donorId);
+                } else {
+                    liveFeed->accepted(r, donorId);
+                    // Every winner keeps its unit on record; the last one also completes the request
+                    matchingEngine->acceptBroadcastUnit(r, d, !partial);
+                    completed = !partial;
+                }
+                // Both accepts also set last/next eligibility dates and park the donor until the
+                // interval passes, in the same engine lock as the accept
+                liveFeed->notify(r);
+                state.touch(d);
+                state.touch(r);
+                
+                // Create a transaction record
+                Transaction* t = new Transaction();
+                t->id = state.nextTransactionId();
+                t->donorId = donorId;
+                t->recipientId = requestId;
+                t->bloodGroup = d->bloodGroup;
+                t->status = "Success";
+                t->timestamp = getCurrentTimestamp();
+                state.addTransaction(t);
+
+                // Persist all changes (full saves run once at the end of the writer batch)
+                state.saveDonors();
+                state.saveRecipients();
+                {
+                    LatencyMetrics::Timer persistTimer(metrics, persistencePhase);
+                    std::ofstream transFile("data/transactions.csv", std::ios::app);
+                    transFile << CSVHandler::transactionToCSV(*t) << std::endl;
+                    transFile.close();
+                }
 
-            return crow::response(200, "Request Accepted & Completed");
+                return crow::response(200, completed ? "Request Accepted & Completed" : "Request Accepted");
+            }, respond);
         }
-        return crow::response(404, "Not found");
-    });
+        respond(crow::response(404, "Not found"));
+    }));
     CROW_ROUTE(app, "/api/recipient/request").methods("POST"_method)
-    ([](const crow::request& req){
-        auto body = crow::json::load(req.body);
-        if (!body) {
-            return crow::response(400, "Invalid JSON");
-        }
-        
+    (offloadAsync([](const crow::request& req, const Responder& respond){
+        // Recipient fields go straight into the request, the rest into RequestOptions
         Recipient* newRequest = new Recipient();
-        newRequest->id = generateRecipientId();
-        newRequest->patientName = body["patientName"].s();
-        newRequest->bloodGroupNeeded = body["bloodGroupNeeded"].s();
-        newRequest->urgency = body["urgency"].s();
-        newRequest->hospitalName = body.has("hospitalName") ? body["hospitalName"].s() : std::string("");
-        newRequest->locationNodeId = body.has("locationNodeId") ? body["locationNodeId"].s() : std::string("H1");
-        newRequest->contactPerson = body["contactPerson"].s();
-        newRequest->contactPhone = body["contactPhone"].s();
+        newRequest->locationNodeId = "H1";
+        RequestOptions options;
+        if (!JsonReader(req.body).parse<RecipientFormJson>(*newRequest) ||
+            !JsonReader(req.body).parse<RequestOptionsJson>(options)) {
+            delete newRequest;
+            return respond(crow::response(400, "Invalid JSON"));
+        }
+        newRequest->unitsNeeded = std::max(1, std::min(newRequest->unitsNeeded, 10));
         newRequest->status = "Searching";
         newRequest->timestamp = getCurrentTimestamp();
         
-        recipientDatabase.insert(newRequest->id, newRequest);
-        matchingEngine->addRecipientRequest(newRequest);
-        
-        // Try to find a match
-        Donor* matchedDonor = matchingEngine->findBestDonorFor(newRequest);
+        // Immediate requests broadcast to the nearest donors at once; first accepts win
+        std::string dispatchMode = !options.dispatch.empty() ? options.dispatch
+                                 : std::string(newRequest->urgency == "Immediate" ? "broadcast" : "reserve");
+        CustomVector<MatchingEngine::DonorCandidate> offered;
+        if (dispatchMode == "broadcast") {
+            matchingEngine->refreshEligibility();
+            size_t broadcastSize = BROADCAST_DONORS;
+            if (options.broadcastSize > 0) {
+                broadcastSize = std::min<size_t>(options.broadcastSize, 50);
+            }
+            offered = matchingEngine->findTopKDonors(newRequest, broadcastSize);
+            // "Broadcast" before queueing - the global pass skips it while the offer is open
+            if (!offered.empty()) newRequest->status = "Broadcast";
+        }
         
+        // Each stage hands off to the next without waiting: the writer assigns the id, the
+        // pool dispatches it (broadcast or batcher), and the last callback answers
+        store->executeThen([newRequest](StateStore::State& state) {
+            newRequest->id = state.nextRecipientId();
+            state.addRecipient(newRequest);
+            matchingEngine->addRecipientRequest(newRequest);
+        }, [newRequest, options, offered, respond](std::future<void>& added) {
+            try {
+                added.get();
+            } catch (const std::exception& e) {
+                return respond(crow::response(500, e.what()));
+            }
+            workPool->submit([newRequest, options, offered, respond] {
+                try {
+                    dispatchRequest(newRequest, options, offered, respond);
+                } catch (const std::exception& e) {
+                    respond(crow::response(500, e.what()));
+                }
+            });
+        });
+    }));
+    
+    // API: Live status of a request (full state + version)
+    // Method: GET /api/recipient/live/<id>
+    // Called when: live-match page subscribes to request:<id>, or sees a version gap
+    // in the pushed deltas; deltas with a higher version are applied on top of this
+    CROW_ROUTE(app, "/api/recipient/live/<string>")
+    ([](std::string requestId){
+        StateStore::RecipientEntry entry;
+        if (!store->snapshot()->recipients.get(requestId, entry)) {
+            return crow::response(404, "Recipient not found");
+        }
+        crow::response res(200, liveFeed->snapshot(entry.view.get()));
+        res.set_header("Content-Type", "application/json");
+        return res;
+    });
+    
+    // API: Candidate donors for a request
+    // Method: GET /api/recipient/candidates/<id>?k=5
+    // Called when: live-match page wants the list of nearest donors
+    // What it does:
+    //   1. Grow a Dijkstra frontier outward from the recipient's node
+    //   2. Collect available compatible donors as their nodes settle
+    //   3. Stop as soon as k donors are found (no closer node remains)
+    CROW_ROUTE(app, "/api/recipient/candidates/<string>")
+    (offload([](const crow::request& req, std::string recipientId){
+        StateStore::RecipientEntry entry;
+        if (!store->snapshot()->recipients.get(recipientId, entry)) {
+            return crow::response(404, "Recipient not found");
+        }
+        Recipient* recipient = entry.live; // The engine searches from the live request
+
+        size_t k = 5;
+        if (req.url_params.get("k")) {
+            int requested = std::atoi(req.url_params.get("k"));
+            if (requested > 0) k = std::min(requested, 50);
+        }
+
+        matchingEngine->refreshEligibility();
+        auto candidates = matchingEngine->findTopKDonors(recipient, k);
+
+        crow::json::wvalue response;
+        response["requestId"] = recipient->id;
+        response["count"] = candidates.getSize();
+        response["donors"] = crow::json::wvalue::list();
+        for (size_t i = 0; i < candidates.getSize(); ++i) {
+            Donor* d = candidates[i].donor;
+            response["donors"][i]["donorId"] = d->id;
+            response["donors"][i]["name"] = d->name;
+            response["donors"][i]["bloodGroup"] = d->bloodGroup;
+            response["donors"][i]["area"] = d->area;
+            response["donors"][i]["locationNodeId"] = d->locationNodeId;
+            response["donors"][i]["distance"] = candidates[i].distance;
+        }
+
+        return crow::response(200, response);
+    }));
+
+    // API: Global assignment of all pending requests
+    // Method: POST /api/matching/assign-pending?k=16
+    // Called when: after a mass-casualty event, or periodically by the dispatch desk
+    // What it does:
+    //   1. Collect every "Pending" recipient from the request queue (and their missing units)
+    //   2. k nearest available compatible donors per unit (sparse candidate graph)
+    //   3. Min-cost assignment weighted by urgency and distance - no stranded patients
+    //      because an earlier request grabbed their only nearby donor
+    //   4. Reserve matched donors and persist both databases
+    CROW_ROUTE(app, "/api/matching/assign-pending").methods("POST"_method)
+    (offloadAsync([](const crow::request& req, const Responder& respond){
+        size_t k = 16;
+        if (req.url_params.get("k")) {
+            int requested = std::atoi(req.url_params.get("k"));
+            if (requested > 0) k = std::min(requested, 64);
+        }
+
+        MatchingEngine::AssignmentReport report = matchingEngine->assignPendingRecipients(k);
+
         crow::json::wvalue response;
         response["success"] = true;
-        response["requestId"] = newRequest->id;
-        
-        if (matchedDonor) {
-            newRequest->matchedDonorId = matchedDonor->id;
-            newRequest->status = "Matched";
-            matchedDonor->status = "Busy";
-            
-            auto route = cityGraph.dijkstra(matchedDonor->locationNodeId, newRequest->locationNodeId);
-            
-            response["matched"] = true;
-            response["donorName"] = matchedDonor->name;
-            response["donorId"] = matchedDonor->id;
-            response["distance"] = route.distance;
-            response["estimatedTime"] = static_cast<int>(route.distance * 3); // 3 min per km
-            
-            // Persist both databases to reflect match and donor status
-            CSVHandler::saveAllDonors("data/donors.csv", donorDatabase);
-            CSVHandler::saveAllRecipients("data/recipients.csv", recipientDatabase);
-        } else {
-            response["matched"] = false;
-            response["message"] = "Searching for compatible donors...";
+        response["pending"] = report.pending;
+        response["unitsRequested"] = report.unitsRequested;
+        response["unitsReserved"] = report.recipients.getSize();
+        response["unitsUnmatched"] = report.unitsRequested - report.recipients.getSize();
+        response["donorsConsidered"] = report.donorsConsidered;
+        response["candidateEdges"] = report.candidateEdges;
+        response["totalCost"] = report.totalCost;
+        response["candidateMicros"] = report.candidateMicros;
+        response["solveMicros"] = report.solveMicros;
+        response["reassignments"] = report.solverStats.reassignments;
+        response["assignments"] = crow::json::wvalue::list();
+        for (size_t i = 0; i < report.recipients.getSize(); ++i) {
+            response["assignments"][i]["requestId"] = report.recipients[i]->id;
+            response["assignments"][i]["urgency"] = report.recipients[i]->urgency;
+            response["assignments"][i]["donorId"] = report.donors[i].donor->id;
+            response["assignments"][i]["donorName"] = report.donors[i].donor->name;
+            response["assignments"][i]["distance"] = report.donors[i].distance;
         }
-        
+
+        if (report.recipients.empty()) return respond(crow::response(200, response));
+        // Reserved donors/requests were already touched through the engine listeners
+        std::string body = response.dump();
+        commitThenRespond([body](StateStore::State& state) {
+            state.saveDonors();
+            state.saveRecipients();
+            return jsonResponse(200, body);
+        }, respond);
+    }));
+
+    // API: Update road weight / close road
+    // Method: POST /api/graph/road  {"from":"H1","to":"D1","weight":6.5} or {"from":..,"to":..,"closed":true}
+    // Called when: Road closure or congestion changes travel cost
+    // What it does:
+    //   1. Update both directions of the edge in cityGraph
+    //   2. Repair cached hospital shortest-path trees incrementally
+    CROW_ROUTE(app, "/api/graph/road").methods("POST"_method)
+    (offload([](const crow::request& req){
+        auto body = crow::json::load(req.body);
+        if (!body || !body.has("from") || !body.has("to")) return crow::response(400);
+
+        std::string from = body["from"].s();
+        std::string to = body["to"].s();
+        bool closed = body.has("closed") && body["closed"].b();
+        if (!closed && (!body.has("weight") || body["weight"].d() < 0)) {
+            return crow::response(400, "Non-negative weight required");
+        }
+
+        bool ok = closed ? matchingEngine->closeRoad(from, to)
+                         : matchingEngine->updateRoad(from, to, body["weight"].d());
+        if (!ok) {
+            return crow::response(404, "Road not found");
+        }
+        return crow::response(200, closed ? "Road closed" : "Road updated");
+    }));
+
+    // API: Coverage report for a hospital
+    // Method: GET /api/reports/coverage/<nodeId>?threads=4&delta=5
+    // What it does:
+    //   1. Full distance vector from the hospital (parallel delta-stepping)
+    //   2. Count nodes reachable within 5 / 10 / 20 km
+    CROW_ROUTE(app, "/api/reports/coverage/<string>")
+    (offload([](const crow::request& req, std::string nodeId){
+        if (cityGraph.getNodeIndex(nodeId) < 0) {
+            return crow::response(404, "Node not found");
+        }
+
+        unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        unsigned threads = cores;
+        if (req.url_params.get("threads")) threads = std::atoi(req.url_params.get("threads"));
+        if (threads == 0) threads = 1;
+        if (threads > cores) threads = cores;
+
+        // Shared solver: CSR re-exported only when the graph epoch moved, thread team reused
+        std::lock_guard<std::mutex> guard(coverageLock);
+        coverageSolver->refresh();
+        double delta = req.url_params.get("delta") ? std::atof(req.url_params.get("delta")) : coverageSolver->suggestDelta();
+        CustomVector<double> dist = coverageSolver->distancesFrom(nodeId, delta, threads);
+        DeltaStepping::Stats stats = coverageSolver->getLastStats();
+
+        int reachable = 0, within5 = 0, within10 = 0, within20 = 0;
+        double farthest = 0;
+        for (size_t i = 0; i < dist.getSize(); ++i) {
+            if (dist[i] == std::numeric_limits<double>::infinity()) continue;
+            ++reachable;
+            if (dist[i] <= 5) ++within5;
+            if (dist[i] <= 10) ++within10;
+            if (dist[i] <= 20) ++within20;
+            if (dist[i] > farthest) farthest = dist[i];
+        }
+
+        crow::json::wvalue response;
+        response["nodeId"] = nodeId;
+        response["totalNodes"] = dist.getSize();
+        response["reachable"] = reachable;
+        response["within5km"] = within5;
+        response["within10km"] = within10;
+        response["within20km"] = within20;
+        response["farthestKm"] = farthest;
+        response["threads"] = threads;
+        response["delta"] = stats.delta; // After clamping to the solver's floor
+        response["buckets"] = stats.buckets;
         return crow::response(200, response);
-    });
-    
+    }));
+
+    // API: Emergency broadcast targeting
+    // Method: POST /api/emergency/broadcast
+    //   {"bloodGroup":"O-","hospitalNode":"H1","radiusKm":10}  or  {..., "radiusMinutes":20}
+    // Called when: emergency-broadcast page sends an alert
+    // What it does:
+    //   1. Bounded search from the hospital - stops at the radius (km or minutes)
+    //   2. Returns every available compatible donor inside that area
+    //   Cost scales with the area covered, not with the whole graph
+    CROW_ROUTE(app, "/api/emergency/broadcast").methods("POST"_method)
+    (offload([](const crow::request& req){
+        auto body = crow::json::load(req.body);
+        if (!body || !body.has("bloodGroup") || !body.has("hospitalNode")) return crow::response(400);
+        if (!body.has("radiusKm") && !body.has("radiusMinutes")) {
+            return crow::response(400, "radiusKm or radiusMinutes required");
+        }
+
+        std::string bloodGroup = body["bloodGroup"].s();
+        std::string hospitalNode = body["hospitalNode"].s();
+        if (cityGraph.getNodeIndex(hospitalNode) < 0) {
+            return crow::response(404, "Hospital node not found");
+        }
+
+        matchingEngine->refreshEligibility();
+        bool byTime = body.has("radiusMinutes");
+        CustomVector<MatchingEngine::DonorCandidate> donors = byTime
+            ? matchingEngine->findDonorsWithinTime(bloodGroup, hospitalNode, currentMinuteOfDay(), body["radiusMinutes"].d())
+            : matchingEngine->findDonorsWithinRadius(bloodGroup, hospitalNode, body["radiusKm"].d());
+
+        // Push the alert once: each donor's own topic plus their group/area topic
+        CustomVector<std::string> topics;
+        for (size_t i = 0; i < donors.getSize(); ++i) {
+            Donor* d = donors[i].donor;
+            topics.push_back(WebSocketHub::donorTopic(d->id));
+            topics.push_back(WebSocketHub::groupAreaTopic(d->bloodGroup, d->locationNodeId));
+        }
+        crow::json::wvalue alert;
+        alert["type"] = "emergency";
+        alert["bloodGroup"] = bloodGroup;
+        alert["hospitalNode"] = hospitalNode;
+        alert["hospitalName"] = cityGraph.getNodeName(hospitalNode);
+        alert["time"] = getCurrentTimestamp();
+        size_t notified = wsHub->publish(topics, alert.dump());
+        std::string smsText = "BloodConnect EMERGENCY: " + bloodGroup + " donors needed at " +
+                              cityGraph.getNodeName(hospitalNode) + ". Please respond in the app.";
+        for (size_t i = 0; i < donors.getSize(); ++i) notifyDonor(donors[i].donor, "emergency", smsText);
+
+        crow::json::wvalue response;
+        response["success"] = true;
+        response["bloodGroup"] = bloodGroup;
+        response["hospitalNode"] = hospitalNode;
+        response["notified"] = notified;
+        response["nodesSearched"] = cityGraph.lastSettledCount();
+        response["count"] = donors.getSize();
+        response["donors"] = crow::json::wvalue::list();
+        for (size_t i = 0; i < donors.getSize(); ++i) {
+            Donor* d = donors[i].donor;
+            response["donors"][i]["donorId"] = d->id;
+            response["donors"][i]["name"] = d->name;
+            response["donors"][i]["bloodGroup"] = d->bloodGroup;
+            response["donors"][i]["phone"] = d->phone;
+            response["donors"][i][byTime ? "minutes" : "distance"] = donors[i].distance;
+        }
+        return crow::response(200, response);
+    }));
+
     // API: Get Donor Dashboard
+    // Polled by the dashboard page - the body only changes when the donor's record does
+    // (entry version) or the day rolls over (eligible), so it is built once per (version, day)
     CROW_ROUTE(app, "/api/donor/dashboard/<string>")
-    ([](std::string donorId){
-        Donor* donor;
-        if (!donorDatabase.get(donorId, donor)) {
+    ([](const crow::request& req, std::string donorId){
+        StateStore::DonorEntry entry;
+        if (!store->snapshot()->donors.get(donorId, entry)) {
             return crow::response(404, "Donor not found");
         }
+        int today = EpochDays::today();
+        VersionedResponseCache::Result cached = dashboardCache->lookup(
+            donorId, entry.version, today, req.get_header_value("If-None-Match"), [&](std::string& body) {
+                LatencyMetrics::Timer encodeTimer(metrics, jsonEncodePhase);
+                const Donor* donor = entry.view.get();
+                JsonWriter response(JsonWriter::threadBuffer());
+                response.beginObject();
+                response.fields<DonorDashboardJson>(*donor);
+                response.field("eligible", donor->nextEligibleDay == EpochDays::NONE || donor->nextEligibleDay <= today);
+                response.endObject();
+                body = response.str();
+            });
         
-        crow::json::wvalue response;
-        response["id"] = donor->id;
-        response["name"] = donor->name;
-        response["bloodGroup"] = donor->bloodGroup;
-        response["status"] = donor->status;
-        response["totalDonations"] = donor->totalDonations;
-        response["badgeLevel"] = donor->badgeLevel;
-        response["city"] = donor->city;
-        response["area"] = donor->area;
-        
-        return crow::response(200, response);
+        crow::response res = cached.notModified ? crow::response(304) : jsonResponse(200, cached.entry->body);
+        res.set_header("ETag", cached.entry->etag);
+        res.set_header("Cache-Control", "no-cache");
+        return res;
+    });
+    
+    // Prometheus scrape: route and phase latency histograms, matching counters
+    // (per-thread shards summed here - the request path never takes a lock for them)
+    CROW_ROUTE(app, "/metrics")
+    ([](){
+        crow::response res(200, metrics->scrape());
+        res.set_header("Content-Type", "text/plain; version=0.0.4");
+        return res;
     });
     
     // API: Health check
@@ -464,8 +1277,11 @@ int main() {
         crow::json::wvalue response;
         response["status"] = "healthy";
         response["timestamp"] = getCurrentTimestamp();
-        response["donors"] = donorDatabase.getSize();
-        response["recipients"] = recipientDatabase.getSize();
+        std::shared_ptr<const StateStore::Snapshot> snapshot = store->snapshot();
+        response["donors"] = snapshot->donors.getSize();
+        response["recipients"] = snapshot->recipients.getSize();
+        response["donorsWaitingForEligibility"] = matchingEngine->waitingForEligibility();
+        response["activeTimers"] = timerWheel->getStats().active;
         return crow::response(200, response);
     });
 
@@ -473,9 +1289,8 @@ int main() {
     CROW_ROUTE(app, "/api/debug/donors")
     ([]{
         crow::json::wvalue response;
-        CustomVector<std::string> ids = donorDatabase.getKeys();
         // Return just the count - total donors in database
-        response["total"] = static_cast<int>(ids.getSize());
+        response["total"] = static_cast<int>(store->snapshot()->donors.getSize());
         response["message"] = "Total donors in database";
         return crow::response(200, response);
     });
@@ -484,16 +1299,230 @@ int main() {
     CROW_ROUTE(app, "/api/debug/recipients")
     ([]{
         crow::json::wvalue response;
-        CustomVector<std::string> ids = recipientDatabase.getKeys();
         // Return just the count - total recipients in database
-        response["total"] = static_cast<int>(ids.getSize());
+        response["total"] = static_cast<int>(store->snapshot()->recipients.getSize());
         response["message"] = "Total recipients in database";
         return crow::response(200, response);
     });
     
+    // DEBUG: Distance cache hit-rate metrics
+    CROW_ROUTE(app, "/api/debug/distance-cache")
+    ([]{
+        DistanceCache& cache = matchingEngine->getDistanceCache();
+        DistanceCache::Stats stats = cache.getStats();
+        crow::json::wvalue response;
+        response["lookups"] = stats.lookups();
+        response["hitRate"] = stats.hitRate();
+        response["pairHits"] = stats.pairHits;
+        response["vectorHits"] = stats.vectorHits;
+        response["matrixHits"] = stats.matrixHits;
+        response["misses"] = stats.misses;
+        response["staleEntries"] = stats.staleEntries;
+        response["promotions"] = stats.promotions;
+        response["repairs"] = stats.repairs;
+        response["repairedLabels"] = stats.repairedLabels;
+        response["allPairsValid"] = cache.hasValidMatrix();
+        response["graphEpoch"] = cityGraph.getEpoch();
+        return crow::response(200, response);
+    });
+    
+    // DEBUG: Coordinate prefilter - matchGroup route queries avoided by the straight-line bound
+    CROW_ROUTE(app, "/api/debug/prefilter")
+    ([]{
+        MatchingEngine::PrefilterStats stats = matchingEngine->getPrefilterStats();
+        crow::json::wvalue response;
+        response["searches"] = stats.searches;
+        response["candidates"] = stats.candidates;
+        response["graphQueries"] = stats.graphQueries;
+        response["pruned"] = stats.pruned();
+        response["prunedRate"] = stats.candidates ? static_cast<double>(stats.pruned()) / stats.candidates : 0.0;
+        response["lowerBoundScale"] = cityGraph.lowerBoundScale();
+        return crow::response(200, response);
+    });
+    
+    // DEBUG: Work pool - offloaded handlers, steals and current backlog
+    CROW_ROUTE(app, "/api/debug/work-pool")
+    ([]{
+        WorkStealingPool::Stats stats = workPool->getStats();
+        crow::json::wvalue response;
+        response["threads"] = stats.threads;
+        response["submitted"] = stats.submitted;
+        response["executed"] = stats.executed;
+        response["stolen"] = stats.stolen;
+        response["queued"] = stats.queued;
+        return crow::response(200, response);
+    });
+    
+    // DEBUG: State store writer - commands per batch (= full CSV saves avoided) and snapshot version
+    CROW_ROUTE(app, "/api/debug/state")
+    ([]{
+        StateStore::Stats stats = store->getStats();
+        crow::json::wvalue response;
+        response["version"] = stats.version;
+        response["commands"] = stats.commands;
+        response["batches"] = stats.batches;
+        response["avgBatch"] = stats.avgBatch();
+        response["maxBatch"] = stats.maxBatch;
+        response["donorSaves"] = stats.donorSaves;
+        response["recipientSaves"] = stats.recipientSaves;
+        response["avgBatchMicros"] = stats.avgPublishMicros();
+        response["transactions"] = store->snapshot()->transactions;
+        return crow::response(200, response);
+    });
+    
+    // DEBUG: Match batcher - how many searches the bursts actually needed
+    CROW_ROUTE(app, "/api/debug/match-batcher")
+    ([]{
+        MatchBatcher::Stats stats = matchBatcher->getStats();
+        crow::json::wvalue response;
+        response["requests"] = stats.requests;
+        response["batches"] = stats.batches;
+        response["searches"] = stats.searches;
+        response["windowMicros"] = MATCH_BATCH_WINDOW_MICROS;
+        return crow::response(200, response);
+    });
+    
+    // DEBUG: WebSocket hub - fan-out and slow-consumer counters
+    CROW_ROUTE(app, "/api/debug/websocket")
+    ([]{
+        WebSocketHub::Stats stats = wsHub->getStats();
+        crow::json::wvalue response;
+        response["connections"] = stats.connections;
+        response["topics"] = stats.topics;
+        response["published"] = stats.published;
+        response["deliveries"] = stats.deliveries;
+        response["queued"] = stats.queued;
+        response["dropped"] = stats.dropped;
+        response["disconnected"] = stats.disconnected;
+        response["ackWindow"] = WS_ACK_WINDOW;
+        response["queueFrames"] = WS_QUEUE_FRAMES;
+        LiveRequestFeed::Stats feed = liveFeed->getStats();
+        response["requestDeltas"] = feed.deltas;
+        response["unchangedNotifications"] = feed.unchanged;
+        response["latencyReports"] = feed.latencyReports;
+        response["latencyAvgMs"] = feed.latencyAvgMs();
+        response["latencyMaxMs"] = feed.latencyMaxMs;
+        return crow::response(200, response);
+    });
+    
+    // DEBUG: Broadcast-and-claim - time to first accept and claim contention
+    CROW_ROUTE(app, "/api/debug/dispatch")
+    ([]{
+        DispatchBoard::Stats stats = dispatchBoard->getStats();
+        crow::json::wvalue response;
+        response["offers"] = stats.offers;
+        response["donorsNotified"] = stats.notified;
+        response["claimsWon"] = stats.won;
+        response["claimsLost"] = stats.lost;
+        response["claimsRejected"] = stats.rejected;
+        response["filled"] = stats.filled;
+        response["expired"] = stats.expired;
+        response["firstAcceptAvgMs"] = stats.firstAcceptAvgMs();
+        response["firstAcceptMaxMs"] = stats.firstAcceptMaxMs;
+        return crow::response(200, response);
+    });
+    
+    // DEBUG: Outbound notifications - batching, retries and what is still undelivered
+    CROW_ROUTE(app, "/api/debug/outbox")
+    ([]{
+        NotificationOutbox::Stats stats = outbox->getStats();
+        crow::json::wvalue response;
+        response["enqueued"] = stats.enqueued;
+        response["delivered"] = stats.delivered;
+        response["pending"] = stats.pending;
+        response["retried"] = stats.retried;
+        response["dead"] = stats.dead;
+        response["recovered"] = stats.recovered;
+        response["gatewayCalls"] = stats.gatewayCalls;
+        response["avgBatch"] = stats.avgBatch();
+        response["avgGatewayMs"] = stats.avgGatewayMs();
+        response["stubBatches"] = gatewayStubBatches.load();
+        response["stubMessages"] = gatewayStubMessages.load();
+        return crow::response(200, response);
+    });
+    
+    // Local SMS/push gateway stand-in - accepts a batch, fails failPercent of it
+    // Method: POST /api/gateway-stub/messages  {"messages":[{"id":1,"to":"...","text":"..."}]}
+    CROW_ROUTE(app, "/api/gateway-stub/messages").methods("POST"_method)
+    ([](const crow::request& req){
+        auto body = crow::json::load(req.body);
+        if (!body || !body.has("messages")) return crow::response(400);
+        if (gatewayStubDelayMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(gatewayStubDelayMs.load()));
+        thread_local std::mt19937 rng(std::random_device{}());
+        std::uniform_int_distribution<int> percent(0, 99);
+        crow::json::wvalue response;
+        response["failed"] = crow::json::wvalue::list();
+        size_t failed = 0;
+        for (size_t i = 0; i < body["messages"].size(); ++i) {
+            if (percent(rng) < gatewayStubFailPercent) response["failed"][failed++] = body["messages"][i]["id"].u();
+        }
+        ++gatewayStubBatches;
+        gatewayStubMessages += body["messages"].size() - failed;
+        return crow::response(200, response);
+    });
+    
+    // Method: POST /api/gateway-stub/config  {"failPercent":20,"delayMs":50}
+    CROW_ROUTE(app, "/api/gateway-stub/config").methods("POST"_method)
+    ([](const crow::request& req){
+        auto body = crow::json::load(req.body);
+        if (!body) return crow::response(400);
+        if (body.has("failPercent")) gatewayStubFailPercent = static_cast<int>(body["failPercent"].i());
+        if (body.has("delayMs")) gatewayStubDelayMs = static_cast<int>(body["delayMs"].i());
+        crow::json::wvalue response;
+        response["failPercent"] = gatewayStubFailPercent.load();
+        response["delayMs"] = gatewayStubDelayMs.load();
+        return crow::response(200, response);
+    });
+    
+    // DEBUG: Dashboard response cache - hit ratio and build time saved
+    CROW_ROUTE(app, "/api/debug/dashboard-cache")
+    ([]{
+        VersionedResponseCache::Stats stats = dashboardCache->getStats();
+        crow::json::wvalue response;
+        response["entries"] = stats.entries;
+        response["requests"] = stats.requests();
+        response["hits"] = stats.hits;
+        response["notModified"] = stats.notModified;
+        response["builds"] = stats.builds;
+        response["hitRatio"] = stats.hitRatio();
+        response["avgBuildMicros"] = stats.avgBuildMicros();
+        response["savedMicros"] = stats.savedMicros();
+        return crow::response(200, response);
+    });
+    
+    // DEBUG: Static asset cache - sizes per encoding, 200/304/404 counts, watcher reloads
+    CROW_ROUTE(app, "/api/debug/static-assets")
+    ([]{
+        StaticAssetCache::Stats stats = staticAssets->getStats();
+        crow::json::wvalue response;
+        response["assets"] = stats.assets;
+        response["bytes"] = stats.bytes;
+        response["gzipBytes"] = stats.gzipBytes;
+        response["brotliBytes"] = stats.brotliBytes;
+        response["hits"] = stats.hits;
+        response["notModified"] = stats.notModified;
+        response["misses"] = stats.misses;
+        response["compressedHits"] = stats.compressedHits;
+        response["reloads"] = stats.reloads;
+        return crow::response(200, response);
+    });
+    
+    // DEBUG: Deadline-aware matching - how often the deadline cut a search short
+    CROW_ROUTE(app, "/api/debug/match-deadlines")
+    ([]{
+        MatchingEngine::DeadlineStats stats = matchingEngine->getDeadlineStats();
+        crow::json::wvalue response;
+        response["requests"] = stats.requests;
+        response["truncated"] = stats.truncated;
+        response["truncatedRate"] = stats.requests ? static_cast<double>(stats.truncated) / stats.requests : 0.0;
+        response["frontierCuts"] = stats.frontierCuts;
+        response["estimatedRoutes"] = stats.estimatedRoutes;
+        return crow::response(200, response);
+    });
+    
     std::cout << "🩸 Smart Blood Donation System Server Starting..." << std::endl;
     std::cout << "🌐 Server running on http://localhost:18080" << std::endl;
-    std::cout << "📊 Loaded " << donorDatabase.getSize() << " donors" << std::endl;
+    std::cout << "📊 Loaded " << store->snapshot()->donors.getSize() << " donors" << std::endl;
     
     // Start server on port 18080
     // multithreaded() = can handle multiple requests at once
@@ -502,5 +1531,10 @@ int main() {
        .multithreaded()
        .run();
     
+    // Let in-flight gateway calls finish; anything undelivered stays in the journal
+    outbox->stop();
+    // Queued state commands are applied and saved before exit
+    store->stop();
+    staticAssets->stop();
     return 0;
 }
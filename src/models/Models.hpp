@@ -25,8 +25,11 @@ struct Donor {
     std::string nextEligibleDate;
     std::string locationNodeId;
     std::string passwordHash;
+    // Parsed once from the date strings (days since 1970-01-01, -1 = none)
+    int lastDonationDay;
+    int nextEligibleDay;
     
-    Donor() : age(0), totalDonations(0), isVerified(false) {}
+    Donor() : age(0), totalDonations(0), isVerified(false), lastDonationDay(-1), nextEligibleDay(-1) {}
 };
 
 struct Recipient {
@@ -42,7 +45,8 @@ struct Recipient {
     std::string contactPhone;
     std::string status; // Pending/Matched/Completed/Cancelled
     std::string timestamp;
-    std::string matchedDonorId;
+    std::string matchedDonorId;    // Donors holding a unit (reserved or donated), ';' separated
+    std::string acceptedDonorIds;  // Of those, donors who donated, ';' separated
     std::string createdByUserId;
     int age;
     std::string medicalCondition;
@@ -0,0 +1,23 @@
+// Minimal check helpers for tests/ - no framework, plain exit codes for ctest.
+// CHECK logs the failing line and keeps going; main() returns checkResult().
+#ifndef TESTS_CHECK_HPP
+#define TESTS_CHECK_HPP
+
+#include <cstdio>
+
+static int checkFailures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            ++checkFailures;                                                          \
+        }                                                                             \
+    } while (0)
+
+inline int checkResult(const char* name) {
+    std::printf("%s: %s (%d failures)\n", name, checkFailures ? "FAILED" : "ok", checkFailures);
+    return checkFailures ? 1 : 0;
+}
+
+#endif // TESTS_CHECK_HPP
@@ -0,0 +1,85 @@
+// CustomGraph::bidirectionalDijkstra must agree with plain dijkstra on
+// distance (and return a path of that length) - random jittered grids with
+// shortcuts, a disconnected island, and start == end.
+#include "Check.hpp"
+#include "dsa/CustomGraph.hpp"
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+
+static std::string nodeId(int x, int y) {
+    return "N" + std::to_string(x) + "_" + std::to_string(y);
+}
+
+typedef std::map<std::pair<std::string, std::string>, double> EdgeWeights;
+
+// Undirected edge, cheapest of parallel roads kept
+static void addRoad(CustomGraph& graph, EdgeWeights& weights, const std::string& a, const std::string& b, double w) {
+    graph.addEdge(a, b, w);
+    for (int dir = 0; dir < 2; ++dir) {
+        std::pair<std::string, std::string> key = dir ? std::make_pair(b, a) : std::make_pair(a, b);
+        EdgeWeights::iterator it = weights.find(key);
+        if (it == weights.end() || w < it->second) weights[key] = w;
+    }
+}
+
+// Sum of edge weights along path - must equal the reported distance
+static double pathLength(const EdgeWeights& weights, const CustomVector<std::string>& path) {
+    double total = 0;
+    for (size_t i = 1; i < path.getSize(); ++i) {
+        EdgeWeights::const_iterator it = weights.find(std::make_pair(path[i - 1], path[i]));
+        if (it == weights.end()) return -1;
+        total += it->second;
+    }
+    return total;
+}
+
+int main() {
+    std::mt19937 rng(7);
+    for (int round = 0; round < 4; ++round) {
+        int side = 12 + round * 6;
+        std::uniform_real_distribution<double> jitter(1.0, 3.0);
+        std::uniform_int_distribution<int> coord(0, side - 1);
+        CustomGraph graph;
+        EdgeWeights weights;
+        for (int x = 0; x < side; ++x) {
+            for (int y = 0; y < side; ++y) graph.addNode(nodeId(x, y), "", "area", x * 10, y * 10);
+        }
+        for (int x = 0; x < side; ++x) {
+            for (int y = 0; y < side; ++y) {
+                if (x + 1 < side) addRoad(graph, weights, nodeId(x, y), nodeId(x + 1, y), jitter(rng));
+                if (y + 1 < side) addRoad(graph, weights, nodeId(x, y), nodeId(x, y + 1), jitter(rng));
+            }
+        }
+        for (int s = 0; s < side; ++s) {
+            addRoad(graph, weights, nodeId(coord(rng), coord(rng)), nodeId(coord(rng), coord(rng)), 2.0 + jitter(rng) * 4);
+        }
+        graph.addNode("ISLAND_A", "", "area", -50, -50);
+        graph.addNode("ISLAND_B", "", "area", -60, -50);
+        addRoad(graph, weights, "ISLAND_A", "ISLAND_B", 1.5);
+
+        for (int q = 0; q < 150; ++q) {
+            std::string from = nodeId(coord(rng), coord(rng));
+            std::string to = nodeId(coord(rng), coord(rng));
+            CustomGraph::ShortestPathResult plain = graph.dijkstra(from, to);
+            CustomGraph::ShortestPathResult bidi = graph.bidirectionalDijkstra(from, to);
+            CHECK(std::fabs(plain.distance - bidi.distance) < 1e-9);
+            CHECK(bidi.path.getSize() > 0 && bidi.path[0] == from && bidi.path[bidi.path.getSize() - 1] == to);
+            CHECK(std::fabs(pathLength(weights, bidi.path) - bidi.distance) < 1e-9);
+        }
+
+        CustomGraph::ShortestPathResult same = graph.bidirectionalDijkstra(nodeId(1, 1), nodeId(1, 1));
+        CHECK(same.distance == 0);
+        CHECK(same.path.getSize() == 1);
+
+        CustomGraph::ShortestPathResult apart = graph.bidirectionalDijkstra(nodeId(0, 0), "ISLAND_A");
+        CHECK(std::isinf(apart.distance));
+        CHECK(apart.path.getSize() == 0);
+        CHECK(graph.dijkstra(nodeId(0, 0), "ISLAND_A").distance == apart.distance);
+
+        CustomGraph::ShortestPathResult island = graph.bidirectionalDijkstra("ISLAND_B", "ISLAND_A");
+        CHECK(std::fabs(island.distance - 1.5) < 1e-12);
+    }
+    return checkResult("test_bidirectional");
+}
@@ -0,0 +1,125 @@
+// DispatchBoard broadcast-and-claim under contention: when every notified
+// donor accepts at once, exactly unitsNeeded win (each with a distinct
+// unitsLeft) and a double-tap by one donor wins at most once. Also checks
+// the rejection results and that release() racing the offer timeout never
+// puts a slot back into a closed offer.
+#include "Check.hpp"
+#include "logic/DispatchBoard.hpp"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+static CustomVector<std::string> donorList(int count) {
+    CustomVector<std::string> ids;
+    for (int i = 0; i < count; ++i) ids.push_back("D" + std::to_string(i));
+    return ids;
+}
+
+static void testClaimRace(WebSocketHub& hub) {
+    const int donors = 12;
+    for (int trial = 0; trial < 300; ++trial) {
+        int units = 1 + trial % 5;
+        DispatchBoard board(&hub, nullptr, std::chrono::milliseconds(1000), DispatchBoard::ExpiryHandler());
+        board.open("R", units, donorList(donors), "{}");
+
+        // One thread per donor, plus a second tap from D0
+        const int threads = donors + 1;
+        std::vector<int> result(threads), left(threads, -1);
+        std::atomic<bool> go(false);
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t) {
+            pool.push_back(std::thread([&, t] {
+                while (!go.load()) std::this_thread::yield();
+                std::string donor = "D" + std::to_string(t == donors ? 0 : t);
+                result[t] = board.claim("R", donor, &left[t]);
+            }));
+        }
+        go = true;
+        for (size_t t = 0; t < pool.size(); ++t) pool[t].join();
+
+        int won = 0, filled = 0, already = 0;
+        std::vector<bool> seenLeft(units, false);
+        bool distinctLeft = true;
+        for (int t = 0; t < threads; ++t) {
+            if (result[t] == DispatchBoard::WON) {
+                ++won;
+                if (left[t] < 0 || left[t] >= units || seenLeft[left[t]]) distinctLeft = false;
+                else seenLeft[left[t]] = true;
+            } else if (result[t] == DispatchBoard::FILLED) {
+                ++filled;
+            } else if (result[t] == DispatchBoard::ALREADY_CLAIMED) {
+                ++already;
+            }
+        }
+        // D0's two taps: one decides, the other is ALREADY_CLAIMED - unless the
+        // first lost, which clears the flag so the second also sees FILLED
+        CHECK(won == units);
+        CHECK(distinctLeft);
+        CHECK(won + filled + already == threads);
+        CHECK(already <= 1);
+        CHECK(!(result[0] == DispatchBoard::WON && result[donors] == DispatchBoard::WON));
+
+        DispatchBoard::Stats stats = board.getStats();
+        CHECK(stats.won == static_cast<unsigned long>(units));
+        CHECK(stats.filled == 1);
+        CHECK(stats.lost == static_cast<unsigned long>(filled));
+    }
+}
+
+static void testRejections(WebSocketHub& hub) {
+    DispatchBoard board(&hub, nullptr, std::chrono::milliseconds(1000), DispatchBoard::ExpiryHandler());
+    board.open("R", 2, donorList(3), "{}");
+    int left = -1;
+    CHECK(board.claim("OTHER", "D0") == DispatchBoard::NO_OFFER);
+    CHECK(board.claim("R", "D9") == DispatchBoard::NOT_OFFERED);
+    CHECK(board.claim("R", "D0", &left) == DispatchBoard::WON);
+    CHECK(left == 1);
+    CHECK(board.claim("R", "D0") == DispatchBoard::ALREADY_CLAIMED);
+    CHECK(board.claim("R", "D1", &left) == DispatchBoard::WON);
+    CHECK(left == 0);
+    CHECK(board.claim("R", "D2") == DispatchBoard::FILLED);
+
+    // Only a real winner can hand its slot back, and only once
+    CHECK(!board.release("R", "D2"));
+    CHECK(!board.release("R", "D9"));
+    CHECK(board.release("R", "D1"));
+    CHECK(!board.release("R", "D1"));
+    CHECK(board.claim("R", "D2", &left) == DispatchBoard::WON);
+    CHECK(left == 0);
+    CHECK(board.getStats().rejected == 2);
+}
+
+// release() vs timeout: either the slot comes back before expiry (expiry
+// reports it open) or expiry wins and release() says false - never both
+static void testReleaseExpireRace(WebSocketHub& hub) {
+    int wrong = 0;
+    for (int trial = 0; trial < 1000; ++trial) {
+        TimerWheel wheel(std::chrono::milliseconds(1));
+        int expiredOpen = -1;
+        DispatchBoard board(&hub, &wheel, std::chrono::milliseconds(1),
+                            [&expiredOpen](const std::string&, int open) { expiredOpen = open; });
+        board.open("R", 1, donorList(4), "{}");
+        if (board.claim("R", "D0") != DispatchBoard::WON) ++wrong;
+
+        bool released = false;
+        std::thread releaser([&] { released = board.release("R", "D0"); });
+        std::thread ticker([&] { wheel.advance(5); });
+        releaser.join();
+        ticker.join();
+        if (released && expiredOpen != 1) ++wrong;
+        if (!released && expiredOpen != -1) ++wrong;
+        if (board.release("R", "D0")) ++wrong; // Closed offer
+        if (board.claim("R", "D1") != DispatchBoard::NO_OFFER) ++wrong;
+    }
+    CHECK(wrong == 0);
+}
+
+int main() {
+    WebSocketHub hub;
+    testClaimRace(hub);
+    testRejections(hub);
+    testReleaseExpireRace(hub);
+    return checkResult("test_dispatch_board");
+}
@@ -0,0 +1,107 @@
+// Incremental repair must match a fresh Dijkstra after every edge change:
+// CustomGraph::repairAfterEdgeChange vs shortestPathTree recomputed from
+// scratch, and DistanceCache (promoted hospital vectors repaired in place)
+// vs plain dijkstra. Changes mix increases, decreases and closures.
+#include "Check.hpp"
+#include "logic/DistanceCache.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+
+static std::string nodeId(int x, int y) {
+    return "N" + std::to_string(x) + "_" + std::to_string(y);
+}
+
+static bool sameDistance(double a, double b) {
+    if (std::isinf(a) || std::isinf(b)) return a == b;
+    return std::fabs(a - b) < 1e-9;
+}
+
+static void buildGrid(CustomGraph& graph, int side, std::mt19937& rng) {
+    std::uniform_real_distribution<double> weight(1.0, 5.0);
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) graph.addNode(nodeId(x, y), "", "area", x, y);
+    }
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) {
+            if (x + 1 < side) graph.addEdge(nodeId(x, y), nodeId(x + 1, y), weight(rng));
+            if (y + 1 < side) graph.addEdge(nodeId(x, y), nodeId(x, y + 1), weight(rng));
+        }
+    }
+}
+
+// Random grid edge gets a new weight - 1 in 6 is a closure, 1 in 6 reopens cheap
+static void randomChange(std::mt19937& rng, int side, std::string& from, std::string& to, double& weight) {
+    std::uniform_int_distribution<int> coord(0, side - 1);
+    std::uniform_int_distribution<int> edgeCoord(0, side - 2);
+    std::uniform_int_distribution<int> kind(0, 5);
+    std::uniform_real_distribution<double> fresh(0.5, 9.0);
+    int a = edgeCoord(rng), b = coord(rng);
+    bool horizontal = rng() % 2 == 0;
+    from = horizontal ? nodeId(a, b) : nodeId(b, a);
+    to = horizontal ? nodeId(a + 1, b) : nodeId(b, a + 1);
+    int k = kind(rng);
+    weight = k == 0 ? std::numeric_limits<double>::infinity() : (k == 1 ? 0.25 : fresh(rng));
+}
+
+static void testTreeRepair() {
+    const int side = 20;
+    std::mt19937 rng(11);
+    CustomGraph graph;
+    buildGrid(graph, side, rng);
+    const std::string source = nodeId(side / 2, side / 2);
+
+    CustomVector<double> dist;
+    CustomVector<int> parent;
+    graph.shortestPathTree(source, dist, parent);
+    for (int step = 0; step < 400; ++step) {
+        std::string from, to;
+        double weight, old = 0.0;
+        randomChange(rng, side, from, to, weight);
+        CHECK(graph.updateEdgeWeight(from, to, weight, &old));
+        graph.repairAfterEdgeChange(from, to, old, weight, dist, parent);
+
+        CustomVector<double> freshDist;
+        CustomVector<int> freshParent;
+        graph.shortestPathTree(source, freshDist, freshParent);
+        CHECK(dist.getSize() == freshDist.getSize());
+        bool allSame = true;
+        for (size_t i = 0; i < freshDist.getSize() && i < dist.getSize(); ++i) {
+            if (!sameDistance(dist[i], freshDist[i])) allSame = false;
+        }
+        CHECK(allSame);
+    }
+}
+
+static void testCacheRepair() {
+    const int side = 30;
+    std::mt19937 rng(1);
+    CustomGraph graph;
+    buildGrid(graph, side, rng);
+    DistanceCache cache(&graph, 65536, 4, 2);
+    const std::string hospital = nodeId(15, 15);
+    for (int i = 0; i < 10; ++i) cache.distance(nodeId(i, 0), hospital); // Promote hospital
+
+    std::uniform_int_distribution<int> coord(0, side - 1);
+    for (int step = 0; step < 300; ++step) {
+        std::string from, to;
+        double weight, old = 0.0;
+        randomChange(rng, side, from, to, weight);
+        CHECK(graph.updateEdgeWeight(from, to, weight, &old));
+        cache.edgeChanged(from, to, old, weight);
+
+        std::string donor = nodeId(coord(rng), coord(rng));
+        CHECK(sameDistance(cache.distance(donor, hospital), graph.dijkstra(donor, hospital).distance));
+    }
+    DistanceCache::Stats stats = cache.getStats();
+    CHECK(stats.promotions > 0);
+    CHECK(stats.repairs > 0);     // Repair path actually ran (not just invalidation)
+    CHECK(stats.vectorHits > 0);  // And answers came from the repaired vector
+}
+
+int main() {
+    testTreeRepair();
+    testCacheRepair();
+    return checkResult("test_distance_repair");
+}
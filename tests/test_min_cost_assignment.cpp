@@ -0,0 +1,109 @@
+// MinCostAssignment vs brute force: every small random instance (sparse
+// candidates, per-row unassigned cost) must reach the enumerated optimum,
+// and the returned assignment must be valid and cost exactly that total.
+// With no unassigned cost (infinity) a free row has no finite price, so
+// there the check is only that as many rows as possible get a donor.
+#include "Check.hpp"
+#include "dsa/MinCostAssignment.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+struct Instance {
+    size_t rows, cols;
+    std::vector<std::vector<double>> cost; // cost[r][c], infinity = no candidate
+    std::vector<double> unassigned;
+};
+
+// Best total over all assignments - each row takes a free candidate column or stays unassigned.
+// Also tracks the most rows any assignment can match
+static void enumerate(const Instance& inst, size_t row, std::vector<bool>& used, double sum, int matched,
+                      double& best, int& bestMatched) {
+    if (row == inst.rows) {
+        if (sum < best) best = sum;
+        if (matched > bestMatched) bestMatched = matched;
+        return;
+    }
+    double leaveOut = std::isinf(inst.unassigned[row]) ? 0.0 : inst.unassigned[row];
+    enumerate(inst, row + 1, used, sum + leaveOut, matched, best, bestMatched);
+    for (size_t c = 0; c < inst.cols; ++c) {
+        if (used[c] || std::isinf(inst.cost[row][c])) continue;
+        used[c] = true;
+        enumerate(inst, row + 1, used, sum + inst.cost[row][c], matched + 1, best, bestMatched);
+        used[c] = false;
+    }
+}
+
+static Instance randomInstance(std::mt19937& rng, bool finiteUnassigned) {
+    const double INF = std::numeric_limits<double>::infinity();
+    std::uniform_int_distribution<int> size(1, 6);
+    std::uniform_real_distribution<double> cost(0.0, 20.0);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    Instance inst;
+    inst.rows = size(rng);
+    inst.cols = size(rng);
+    inst.cost.assign(inst.rows, std::vector<double>(inst.cols, INF));
+    for (size_t r = 0; r < inst.rows; ++r) {
+        for (size_t c = 0; c < inst.cols; ++c) {
+            if (chance(rng) < 0.5) inst.cost[r][c] = cost(rng);
+        }
+        inst.unassigned.push_back(finiteUnassigned ? 5.0 + cost(rng) : INF);
+    }
+    return inst;
+}
+
+// Solver total == brute force; the assignment is valid and adds up to that total
+static void checkInstance(const Instance& inst, bool finiteUnassigned) {
+    MinCostAssignment solver(inst.rows, inst.cols);
+    for (size_t r = 0; r < inst.rows; ++r) {
+        for (size_t c = 0; c < inst.cols; ++c) {
+            if (!std::isinf(inst.cost[r][c])) solver.addCandidate(r, c, inst.cost[r][c]);
+        }
+        if (finiteUnassigned) solver.setUnassignedCost(r, inst.unassigned[r]);
+    }
+    double total = solver.solve();
+
+    std::vector<bool> used(inst.cols, false);
+    double best = std::numeric_limits<double>::infinity();
+    int bestMatched = -1;
+    enumerate(inst, 0, used, 0.0, 0, best, bestMatched);
+    if (finiteUnassigned) CHECK(std::fabs(total - best) < 1e-9);
+
+    std::vector<bool> taken(inst.cols, false);
+    double recomputed = 0;
+    int matched = 0;
+    for (size_t r = 0; r < inst.rows; ++r) {
+        int c = solver.assignedColumn(r);
+        if (c < 0) {
+            if (finiteUnassigned) recomputed += inst.unassigned[r];
+            continue;
+        }
+        CHECK(static_cast<size_t>(c) < inst.cols);
+        CHECK(!std::isinf(inst.cost[r][c]));  // Only candidate edges
+        CHECK(!taken[c]);                     // Each donor once
+        taken[c] = true;
+        recomputed += inst.cost[r][c];
+        ++matched;
+    }
+    CHECK(std::fabs(recomputed - total) < 1e-9);
+    if (!finiteUnassigned) CHECK(matched == bestMatched);
+}
+
+int main() {
+    // Greedy trap: row 0 prefers column 0, but it is row 1's only option
+    MinCostAssignment trap(2, 2);
+    trap.addCandidate(0, 0, 1.0);
+    trap.addCandidate(0, 1, 2.0);
+    trap.addCandidate(1, 0, 1.5);
+    trap.setUnassignedCost(0, 100);
+    trap.setUnassignedCost(1, 100);
+    CHECK(std::fabs(trap.solve() - 3.5) < 1e-12);
+    CHECK(trap.assignedColumn(0) == 1);
+    CHECK(trap.assignedColumn(1) == 0);
+
+    std::mt19937 rng(2024);
+    for (int i = 0; i < 2000; ++i) checkInstance(randomInstance(rng, true), true);
+    for (int i = 0; i < 1000; ++i) checkInstance(randomInstance(rng, false), false);
+    return checkResult("test_min_cost_assignment");
+}
@@ -0,0 +1,135 @@
+// PersistentHashMap (HAMT) vs std::map under random insert / overwrite /
+// remove: same contents and size after every batch, and every snapshot copy
+// still equals the reference taken with it, however much the live map has
+// changed since. Also covers long shared hash prefixes (deep tries) and
+// full 64-bit hash collisions (bucket chains).
+#include "Check.hpp"
+#include "dsa/PersistentHashMap.hpp"
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+// Key whose std::hash collides on purpose - 4 distinct hashes in total
+struct CollidingKey {
+    int id;
+    bool operator==(const CollidingKey& other) const { return id == other.id; }
+    bool operator<(const CollidingKey& other) const { return id < other.id; }
+};
+
+namespace std {
+template<> struct hash<CollidingKey> {
+    size_t operator()(const CollidingKey& key) const { return static_cast<size_t>(key.id % 4) * 0x9e3779b97f4a7c15ull; }
+};
+}
+
+// Same entries both ways: every reference key readable, forEach sees each key once
+template<typename K, typename V>
+static bool sameAs(const PersistentHashMap<K, V>& map, const std::map<K, V>& ref) {
+    if (map.getSize() != ref.size() || map.empty() != ref.empty()) return false;
+    for (typename std::map<K, V>::const_iterator it = ref.begin(); it != ref.end(); ++it) {
+        V value;
+        if (!map.get(it->first, value) || !(value == it->second)) return false;
+    }
+    size_t visited = 0;
+    bool match = true;
+    std::map<K, int> seen;
+    map.forEach([&](const K& key, const V& value) {
+        ++visited;
+        typename std::map<K, V>::const_iterator it = ref.find(key);
+        if (it == ref.end() || !(it->second == value) || seen[key]++) match = false;
+        return true;
+    });
+    return match && visited == ref.size() && map.getKeys().getSize() == ref.size();
+}
+
+// Random ops on keys from makeKey(0..keySpace); snapshot every snapshotEvery ops
+template<typename K, typename MakeKey>
+static void randomOps(MakeKey makeKey, int keySpace, int ops, int snapshotEvery, unsigned seed) {
+    std::mt19937 rng(seed);
+    PersistentHashMap<K, int> map;
+    std::map<K, int> ref;
+    std::vector<PersistentHashMap<K, int>> snapshots;
+    std::vector<std::map<K, int>> snapshotRefs;
+
+    bool agree = true;
+    for (int op = 0; op < ops; ++op) {
+        K key = makeKey(static_cast<int>(rng() % keySpace));
+        unsigned kind = rng() % 10;
+        if (kind < 5) {
+            int value = static_cast<int>(rng());
+            map.insert(key, value); // New key or overwrite
+            ref[key] = value;
+        } else if (kind < 9) {
+            bool expected = ref.erase(key) > 0;
+            if (map.remove(key) != expected) agree = false;
+        } else {
+            int value = 0;
+            typename std::map<K, int>::const_iterator it = ref.find(key);
+            bool found = map.get(key, value);
+            if (found != (it != ref.end()) || (found && value != it->second)) agree = false;
+            if (map.contains(key) != found) agree = false;
+        }
+        if ((op + 1) % snapshotEvery == 0) {
+            if (!sameAs(map, ref)) agree = false;
+            snapshots.push_back(map);
+            snapshotRefs.push_back(ref);
+        }
+    }
+    CHECK(agree);
+
+    bool snapshotsIntact = true;
+    for (size_t i = 0; i < snapshots.size(); ++i) {
+        if (!sameAs(snapshots[i], snapshotRefs[i])) snapshotsIntact = false;
+    }
+    CHECK(snapshotsIntact);
+
+    // Drain: remove everything in random order, map ends empty; snapshots still intact
+    std::vector<K> keys;
+    for (typename std::map<K, int>::const_iterator it = ref.begin(); it != ref.end(); ++it) keys.push_back(it->first);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    bool drained = true;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (!map.remove(keys[i]) || map.contains(keys[i])) drained = false;
+    }
+    CHECK(drained);
+    CHECK(map.empty() && map.getSize() == 0);
+    CHECK(!snapshots.empty() && sameAs(snapshots.back(), snapshotRefs.back()));
+}
+
+static std::string stringKey(int i) {
+    return "donor-" + std::to_string(i);
+}
+
+// Identity std::hash - Multiples of 2^40 share the low 40 bits, 8 trie levels deep
+static long long deepKey(int i) {
+    return static_cast<long long>(i) << 40;
+}
+
+static CollidingKey collidingKey(int i) {
+    CollidingKey key;
+    key.id = i;
+    return key;
+}
+
+int main() {
+    randomOps<std::string>(stringKey, 600, 40000, 2000, 1);
+    randomOps<long long>(deepKey, 200, 10000, 500, 2);
+    randomOps<CollidingKey>(collidingKey, 40, 5000, 250, 3);
+
+    // Copy is a snapshot: edits on either side stay on that side
+    PersistentHashMap<std::string, int> a;
+    a.insert("x", 1);
+    PersistentHashMap<std::string, int> b = a;
+    b.insert("x", 2);
+    b.insert("y", 3);
+    a.remove("x");
+    int value = 0;
+    CHECK(a.empty() && !a.contains("y"));
+    CHECK(b.get("x", value) && value == 2);
+    CHECK(b.getSize() == 2);
+    CHECK(!a.remove("x"));
+    return checkResult("test_persistent_hash_map");
+}
@@ -0,0 +1,111 @@
+// TimerWheel driven by advance() (no thread): every timer fires on exactly
+// its tick, including delays that cascade down from levels 1-3 and past the
+// wheel span; cancelled timers never fire, even after cascading; stale ids
+// cannot cancel a reused pool slot.
+#include "Check.hpp"
+#include "dsa/TimerWheel.hpp"
+#include <chrono>
+#include <random>
+#include <vector>
+
+typedef std::chrono::milliseconds ms; // 1 ms tick -> delay in ms == delay in ticks
+
+static void testExactFiring() {
+    TimerWheel wheel(ms(1));
+    std::mt19937 rng(3);
+    const int count = 3000;
+    const long long horizon = 300000; // Level 3 (> 64^3 ticks)
+    std::vector<long long> delay(count), firedAt(count, -1);
+    std::vector<TimerWheel::TimerId> ids(count);
+    long long step = 0;
+
+    for (int i = 0; i < count; ++i) {
+        // Mix of scales so every level gets timers
+        long long scale = 1LL << (6 * (i % 4));
+        delay[i] = 1 + static_cast<long long>(rng() % (scale * 64)) % horizon;
+        ids[i] = wheel.schedule(ms(delay[i]), [&firedAt, &step, i] { firedAt[i] = step; });
+    }
+    // Cancel every third timer now; every third + 1 later, after it has cascaded
+    std::vector<bool> cancelled(count, false);
+    for (int i = 0; i < count; i += 3) {
+        CHECK(wheel.cancel(ids[i]));
+        cancelled[i] = true;
+    }
+
+    for (step = 1; step <= horizon; ++step) {
+        wheel.advance(1);
+        if (step == 5000) {
+            for (int i = 1; i < count; i += 3) {
+                if (delay[i] > 5000) {
+                    CHECK(wheel.cancel(ids[i]));
+                    cancelled[i] = true;
+                }
+            }
+        }
+    }
+
+    bool exact = true, silent = true;
+    for (int i = 0; i < count; ++i) {
+        if (cancelled[i]) {
+            if (firedAt[i] != -1) silent = false;
+        } else if (firedAt[i] != delay[i]) {
+            exact = false;
+        }
+    }
+    CHECK(exact);
+    CHECK(silent);
+
+    TimerWheel::Stats stats = wheel.getStats();
+    CHECK(stats.active == 0);
+    CHECK(stats.cascaded > 0);
+    CHECK(stats.fired + stats.cancelled == static_cast<unsigned long long>(count));
+    CHECK(!wheel.cancel(ids[2])); // Already fired
+    CHECK(!wheel.cancel(ids[0])); // Already cancelled
+}
+
+// Beyond MAX_SPAN (64^4 ticks) the timer parks on the top level and re-cascades
+static void testBeyondSpan() {
+    TimerWheel wheel(ms(1));
+    const long long span = 1LL << 24;
+    const long long far = span + 12345;
+    int fired = 0;
+    wheel.advance(777); // Start off a slot boundary
+    wheel.schedule(ms(far), [&fired] { ++fired; });
+    wheel.advance(far - 1);
+    CHECK(fired == 0);
+    wheel.advance(1);
+    CHECK(fired == 1);
+}
+
+static void testStaleIds() {
+    TimerWheel wheel(ms(1));
+    int a = 0, b = 0;
+    TimerWheel::TimerId first = wheel.schedule(ms(2), [&a] { ++a; });
+    CHECK(wheel.advance(2) == 1);
+    CHECK(a == 1);
+    TimerWheel::TimerId second = wheel.schedule(ms(2), [&b] { ++b; }); // Reuses the pool slot
+    CHECK(first != second);
+    CHECK(!wheel.cancel(first));
+    CHECK(!wheel.cancel(TimerWheel::NO_TIMER));
+    wheel.advance(2);
+    CHECK(b == 1);
+
+    // Sub-tick delay rounds up to one tick; a callback may schedule again
+    TimerWheel coarse(ms(1000));
+    int chained = 0;
+    coarse.schedule(ms(1), [&] {
+        ++chained;
+        coarse.schedule(ms(1000), [&chained] { ++chained; });
+    });
+    CHECK(coarse.advance(1) == 1);
+    CHECK(chained == 1);
+    CHECK(coarse.advance(1) == 1);
+    CHECK(chained == 2);
+}
+
+int main() {
+    testExactFiring();
+    testBeyondSpan();
+    testStaleIds();
+    return checkResult("test_timer_wheel");
+}
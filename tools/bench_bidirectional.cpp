@@ -0,0 +1,76 @@
+// Settled-node comparison: CustomGraph::dijkstra vs bidirectionalDijkstra
+// on the same road-like graph (jittered grid with a few diagonal shortcuts).
+//
+// Usage: bench_bidirectional [gridSide=300] [queries=200] [seed=42]
+// Every query checks that both searches return the same distance.
+#include "dsa/CustomGraph.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+static std::string nodeId(int x, int y) {
+    return "N" + std::to_string(x) + "_" + std::to_string(y);
+}
+
+int main(int argc, char** argv) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 300;
+    int queries = argc > 2 ? std::atoi(argv[2]) : 200;
+    unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 42u;
+    if (side < 2 || queries < 1) {
+        std::fprintf(stderr, "usage: %s [gridSide>=2] [queries>=1] [seed]\n", argv[0]);
+        return 2;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> jitter(1.0, 1.6);
+    CustomGraph graph;
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) graph.addNode(nodeId(x, y), "", "area", x * 10, y * 10);
+    }
+    size_t edges = 0;
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) {
+            if (x + 1 < side) { graph.addEdge(nodeId(x, y), nodeId(x + 1, y), jitter(rng)); ++edges; }
+            if (y + 1 < side) { graph.addEdge(nodeId(x, y), nodeId(x, y + 1), jitter(rng)); ++edges; }
+            if (x + 1 < side && y + 1 < side && rng() % 8 == 0) {
+                graph.addEdge(nodeId(x, y), nodeId(x + 1, y + 1), std::sqrt(2.0) * jitter(rng));
+                ++edges;
+            }
+        }
+    }
+
+    std::uniform_int_distribution<int> coord(0, side - 1);
+    unsigned long long uniSettled = 0, biSettled = 0;
+    double uniMicros = 0, biMicros = 0;
+    int mismatches = 0;
+    for (int q = 0; q < queries; ++q) {
+        std::string from = nodeId(coord(rng), coord(rng));
+        std::string to = nodeId(coord(rng), coord(rng));
+
+        auto t0 = std::chrono::steady_clock::now();
+        CustomGraph::ShortestPathResult uni = graph.dijkstra(from, to);
+        auto t1 = std::chrono::steady_clock::now();
+        CustomGraph::ShortestPathResult bi = graph.bidirectionalDijkstra(from, to);
+        auto t2 = std::chrono::steady_clock::now();
+
+        uniMicros += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        biMicros += std::chrono::duration<double, std::micro>(t2 - t1).count();
+        uniSettled += uni.settledNodes;
+        biSettled += bi.settledNodes;
+        if (std::fabs(uni.distance - bi.distance) > 1e-9 * (1.0 + uni.distance)) ++mismatches;
+    }
+
+    std::printf("graph: %d nodes, %zu undirected edges, %d random queries (seed %u)\n",
+                side * side, edges, queries, seed);
+    std::printf("dijkstra:              %10.0f settled/query  %9.1f us/query\n",
+                static_cast<double>(uniSettled) / queries, uniMicros / queries);
+    std::printf("bidirectionalDijkstra: %10.0f settled/query  %9.1f us/query\n",
+                static_cast<double>(biSettled) / queries, biMicros / queries);
+    std::printf("settled-node reduction: %.1f%% (%.2fx fewer), distance mismatches: %d\n",
+                100.0 * (1.0 - static_cast<double>(biSettled) / uniSettled),
+                static_cast<double>(uniSettled) / biSettled, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+// Dashboard polling: VersionedResponseCache (body per entry version, 304 on
+// a matching ETag) against building the body on every poll. Donors live in
+// a StateStore; each client sends back the last ETag it saw. A share of the
+// polls is preceded by a status change to a random donor (not timed).
+// Per-poll time includes the snapshot lookup, as in the handler.
+//
+// Usage: bench_dashboard_cache [donors=10000] [polls=1000000] [seed=42] [csvDir=/tmp]
+// Runs mutation rates 0/1/5/20%. Fails if a cached body differs from a fresh build.
+#include "logic/Eligibility.hpp"
+#include "logic/JsonCodec.hpp"
+#include "logic/StateStore.hpp"
+#include "logic/VersionedResponseCache.hpp"
+#include "models/Models.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static void buildDashboard(const Donor& donor, int today, std::string& body) {
+    JsonWriter response(JsonWriter::threadBuffer());
+    response.beginObject();
+    response.fields<DonorDashboardJson>(donor);
+    response.field("eligible", donor.nextEligibleDay == EpochDays::NONE || donor.nextEligibleDay <= today);
+    response.endObject();
+    body = response.str();
+}
+
+int main(int argc, char** argv) {
+    int donorCount = argc > 1 ? std::atoi(argv[1]) : 10000;
+    long polls = argc > 2 ? std::atol(argv[2]) : 1000000;
+    unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 42u;
+    std::string dir = argc > 4 ? argv[4] : "/tmp";
+    if (donorCount < 1 || polls < 1) {
+        std::fprintf(stderr, "usage: %s [donors>=1] [polls>=1] [seed] [csvDir]\n", argv[0]);
+        return 2;
+    }
+    const std::string donorsCsv = dir + "/bench_dashboard_donors.csv";
+    const std::string recipientsCsv = dir + "/bench_dashboard_recipients.csv";
+
+    std::vector<Donor*> owned;
+    std::vector<std::string> ids;
+    for (int i = 0; i < donorCount; ++i) {
+        Donor* d = new Donor();
+        d->id = "DON-" + std::to_string(i + 1);
+        d->name = "Donor " + std::to_string(i + 1);
+        d->bloodGroup = "O+";
+        d->status = "Available";
+        d->totalDonations = i % 12;
+        d->badgeLevel = "Silver";
+        d->city = "Islamabad";
+        d->area = "F-7";
+        d->lastDonationDate = "2026-03-14";
+        d->nextEligibleDate = "2026-06-12";
+        owned.push_back(d);
+        ids.push_back(d->id);
+    }
+    const int today = EpochDays::today();
+
+    std::printf("%d donors, %ld polls per run (seed %u)\n", donorCount, polls, seed);
+    std::printf("%9s %12s %12s %10s %8s\n", "mutations", "rebuild ns", "cached ns", "hit ratio", "saved");
+    const double rates[] = {0.0, 0.01, 0.05, 0.20};
+    int mismatches = 0;
+    {
+        StateStore store(donorsCsv, recipientsCsv);
+        store.execute([&](StateStore::State& s) {
+            for (size_t i = 0; i < owned.size(); ++i) s.addDonor(owned[i]);
+            return 0;
+        });
+        for (double rate : rates) {
+            std::uniform_int_distribution<int> pick(0, donorCount - 1);
+            std::uniform_real_distribution<double> roll(0.0, 1.0);
+            VersionedResponseCache cache;
+            std::vector<std::string> lastEtag(donorCount);
+            double nanos[2] = {0, 0};
+            unsigned long served[2] = {0, 0};
+            for (int mode = 0; mode < 2; ++mode) {
+                std::mt19937 rng(seed); // Same polls and mutations for both modes
+                std::string body;
+                for (long p = 0; p < polls; ++p) {
+                    if (roll(rng) < rate) {
+                        int victim = pick(rng);
+                        const char* status = rng() % 2 ? "Available" : "Unavailable";
+                        store.execute([&](StateStore::State& s) {
+                            Donor* d = s.donor(ids[victim]);
+                            d->status = status;
+                            s.touch(d);
+                            return 0;
+                        });
+                    }
+                    int who = pick(rng);
+                    Clock::time_point t0 = Clock::now();
+                    std::shared_ptr<const StateStore::Snapshot> snapshot = store.snapshot();
+                    StateStore::DonorEntry entry;
+                    if (!snapshot->donors.get(ids[who], entry)) continue;
+                    if (mode == 0) {
+                        buildDashboard(*entry.view, today, body);
+                    } else {
+                        VersionedResponseCache::Result cached = cache.lookup(
+                            ids[who], entry.version, today, lastEtag[who],
+                            [&](std::string& out) { buildDashboard(*entry.view, today, out); });
+                        lastEtag[who] = cached.entry->etag;
+                        if (!cached.notModified) body = cached.entry->body;
+                    }
+                    nanos[mode] += std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+                    ++served[mode];
+                    if (mode == 1 && p % 1000 == 0) {
+                        std::string fresh;
+                        buildDashboard(*entry.view, today, fresh);
+                        VersionedResponseCache::Result check =
+                            cache.lookup(ids[who], entry.version, today, "", [](std::string&) {});
+                        if (check.entry->body != fresh) ++mismatches;
+                    }
+                }
+            }
+            VersionedResponseCache::Stats stats = cache.getStats();
+            double rebuild = nanos[0] / served[0], cached = nanos[1] / served[1];
+            std::printf("%8.0f%% %12.0f %12.0f %10.2f %7.0f%%\n", rate * 100, rebuild, cached, stats.hitRatio(),
+                        100.0 * (1.0 - cached / rebuild));
+        }
+    }
+    for (size_t i = 0; i < owned.size(); ++i) delete owned[i];
+    std::remove(donorsCsv.c_str());
+    std::remove(recipientsCsv.c_str());
+    if (mismatches) std::printf("cached body mismatches: %d\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
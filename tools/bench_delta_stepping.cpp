@@ -0,0 +1,82 @@
+// Parallel SSSP check and scaling table: DeltaStepping::distancesFrom for
+// several bucket widths and thread counts against the sequential
+// CustomGraph::distancesFrom, on a jittered grid with fractional weights
+// and one closed road.
+//
+// Usage: bench_delta_stepping [gridSide=300] [runs=3] [seed=42]
+// Every run checks that all distances are bit-identical to the sequential ones.
+// Thread counts above the core count only add scheduling overhead - run the
+// scaling table on a multi-core host.
+#include "dsa/CustomGraph.hpp"
+#include "dsa/DeltaStepping.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+
+static std::string nodeId(int x, int y) {
+    return "N" + std::to_string(x) + "_" + std::to_string(y);
+}
+
+int main(int argc, char** argv) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 300;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 3;
+    unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 42u;
+    if (side < 2 || runs < 1) {
+        std::fprintf(stderr, "usage: %s [gridSide>=2] [runs>=1] [seed]\n", argv[0]);
+        return 2;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> weight(1.0, 10.0);
+    CustomGraph graph;
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) graph.addNode(nodeId(x, y), "", "area", x * 10, y * 10);
+    }
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) {
+            if (x + 1 < side) graph.addEdge(nodeId(x, y), nodeId(x + 1, y), weight(rng));
+            if (y + 1 < side) graph.addEdge(nodeId(x, y), nodeId(x, y + 1), weight(rng));
+        }
+    }
+    graph.removeEdge(nodeId(side / 2, side / 2), nodeId(side / 2 + 1, side / 2));
+
+    const std::string source = nodeId(side / 4, side / 3);
+    auto t0 = std::chrono::steady_clock::now();
+    CustomVector<double> expected;
+    for (int r = 0; r < runs; ++r) expected = graph.distancesFrom(source);
+    double dijkstraMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() / runs;
+
+    std::printf("graph: %d nodes, source %s, %u hardware threads (seed %u)\n",
+                side * side, source.c_str(), std::thread::hardware_concurrency(), seed);
+    std::printf("CustomGraph::distancesFrom: %8.2f ms\n\n", dijkstraMs);
+    std::printf("%7s %7s %10s %8s %9s %12s %10s\n", "delta", "threads", "ms", "speedup", "buckets", "relaxations", "mismatch");
+
+    const double deltas[] = {1.0, 7.0, 30.0};
+    const unsigned threadCounts[] = {1, 2, 4, 8, 32};
+    DeltaStepping stepping(graph);
+    int mismatches = 0;
+    for (double delta : deltas) {
+        double oneThreadMs = 0;
+        for (unsigned threads : threadCounts) {
+            stepping.distancesFrom(source, delta, threads); // Keep thread-team start-up out of the timing
+            auto s0 = std::chrono::steady_clock::now();
+            CustomVector<double> got;
+            for (int r = 0; r < runs; ++r) got = stepping.distancesFrom(source, delta, threads);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - s0).count() / runs;
+            if (threads == 1) oneThreadMs = ms;
+
+            size_t wrong = 0;
+            for (size_t i = 0; i < expected.getSize(); ++i) {
+                if (got[i] != expected[i]) ++wrong;
+            }
+            mismatches += wrong != 0;
+            DeltaStepping::Stats stats = stepping.getLastStats();
+            std::printf("%7.1f %7u %10.2f %7.2fx %9zu %12zu %10zu\n", stats.delta, threads, ms,
+                        oneThreadMs / ms, stats.buckets, stats.relaxations, wrong);
+        }
+    }
+    return mismatches == 0 ? 0 : 1;
+}
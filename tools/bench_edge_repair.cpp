@@ -0,0 +1,90 @@
+// Incremental repair vs full recompute: CustomGraph::repairAfterEdgeChange
+// against a fresh shortestPathTree after each random single-edge update
+// (a third are closures, the rest reweights) on a jittered grid.
+//
+// Usage: bench_edge_repair [gridSide=100] [updates=500] [seed=42]
+// Every update checks that the repaired tree matches the full one.
+#include "dsa/CustomGraph.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+
+static std::string nodeId(int x, int y) {
+    return "N" + std::to_string(x) + "_" + std::to_string(y);
+}
+
+int main(int argc, char** argv) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 100;
+    int updates = argc > 2 ? std::atoi(argv[2]) : 500;
+    unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 42u;
+    if (side < 2 || updates < 1) {
+        std::fprintf(stderr, "usage: %s [gridSide>=2] [updates>=1] [seed]\n", argv[0]);
+        return 2;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> jitter(1.0, 1.6);
+    CustomGraph graph;
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) graph.addNode(nodeId(x, y), "", "area", x * 10, y * 10);
+    }
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) {
+            if (x + 1 < side) graph.addEdge(nodeId(x, y), nodeId(x + 1, y), jitter(rng));
+            if (y + 1 < side) graph.addEdge(nodeId(x, y), nodeId(x, y + 1), jitter(rng));
+        }
+    }
+
+    const std::string source = nodeId(side / 2, side / 2);
+    CustomVector<double> dist;
+    CustomVector<int> parent;
+    graph.shortestPathTree(source, dist, parent);
+
+    std::uniform_int_distribution<int> coord(0, side - 1);
+    std::uniform_int_distribution<int> edgeCoord(0, side - 2);
+    std::uniform_real_distribution<double> weight(0.5, 3.0);
+    double repairMicros = 0, fullMicros = 0;
+    unsigned long long touched = 0;
+    int mismatches = 0, closures = 0;
+    for (int u = 0; u < updates; ++u) {
+        int a = edgeCoord(rng), b = coord(rng);
+        bool horizontal = rng() % 2 == 0;
+        std::string from = horizontal ? nodeId(a, b) : nodeId(b, a);
+        std::string to = horizontal ? nodeId(a + 1, b) : nodeId(b, a + 1);
+        bool close = rng() % 3 == 0;
+        double w = close ? std::numeric_limits<double>::infinity() : weight(rng);
+        double old = 0;
+        graph.updateEdgeWeight(from, to, w, &old);
+        if (close) ++closures;
+
+        auto t0 = std::chrono::steady_clock::now();
+        touched += graph.repairAfterEdgeChange(from, to, old, w, dist, parent);
+        auto t1 = std::chrono::steady_clock::now();
+        CustomVector<double> fullDist;
+        CustomVector<int> fullParent;
+        graph.shortestPathTree(source, fullDist, fullParent);
+        auto t2 = std::chrono::steady_clock::now();
+
+        repairMicros += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        fullMicros += std::chrono::duration<double, std::micro>(t2 - t1).count();
+        for (size_t i = 0; i < fullDist.getSize(); ++i) {
+            bool same = std::isinf(fullDist[i]) ? std::isinf(dist[i])
+                                                 : std::fabs(fullDist[i] - dist[i]) <= 1e-9 * (1.0 + fullDist[i]);
+            if (!same) {
+                ++mismatches;
+                break;
+            }
+        }
+    }
+
+    std::printf("graph: %d nodes, %d updates (%d closures, seed %u)\n", side * side, updates, closures, seed);
+    std::printf("repairAfterEdgeChange: %10.1f us/update  %8.0f labels rewritten/update\n",
+                repairMicros / updates, static_cast<double>(touched) / updates);
+    std::printf("full shortestPathTree: %10.1f us/update\n", fullMicros / updates);
+    std::printf("speedup: %.0fx, tree mismatches: %d\n", fullMicros / (repairMicros > 0 ? repairMicros : 1), mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
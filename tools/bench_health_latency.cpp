@@ -0,0 +1,122 @@
+// Health-check latency under load, against a running bloodconnect server:
+// /api/health is polled every few ms, first idle, then while `hammer`
+// clients POST /api/donor/status in a loop (every call saves the whole
+// donors CSV). If heavy handlers ran on the I/O threads, health polls
+// would queue behind the saves.
+//
+// Usage: bench_health_latency [host=127.0.0.1] [port=18080] [seconds=8] [hammer=4] [donorId=DON-001]
+// Start the server first (with a large donors.csv to make saves slow).
+#ifndef ASIO_STANDALONE
+#define ASIO_STANDALONE
+#endif
+#include <asio.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+// One request on a fresh connection - Returns the HTTP status (0 = failed)
+static int httpCall(const std::string& host, const std::string& port, const std::string& method,
+                    const std::string& path, const std::string& body) {
+    try {
+        asio::io_context io;
+        asio::ip::tcp::resolver resolver(io);
+        asio::ip::tcp::socket socket(io);
+        asio::connect(socket, resolver.resolve(host, port));
+        std::string request = method + " " + path + " HTTP/1.1\r\nHost: " + host +
+                              "\r\nConnection: close\r\nContent-Type: application/json\r\nContent-Length: " +
+                              std::to_string(body.size()) + "\r\n\r\n" + body;
+        asio::write(socket, asio::buffer(request));
+        std::string response;
+        asio::error_code ec;
+        char chunk[4096];
+        while (true) {
+            size_t n = socket.read_some(asio::buffer(chunk), ec);
+            response.append(chunk, n);
+            if (ec) break;
+        }
+        if (response.compare(0, 9, "HTTP/1.1 ") != 0 || response.size() < 12) return 0;
+        return std::atoi(response.c_str() + 9);
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+struct PollResult {
+    std::vector<double> millis;
+    int failures;
+    unsigned long hammerCalls;
+};
+
+static PollResult poll(const std::string& host, const std::string& port, double seconds, int hammer,
+                       const std::string& donorId) {
+    std::atomic<bool> running(true);
+    std::atomic<unsigned long> hammerCalls(0);
+    std::vector<std::thread> hammers;
+    for (int h = 0; h < hammer; ++h) {
+        hammers.emplace_back([&, h]() {
+            const char* statuses[] = {"Available", "Unavailable"};
+            for (int i = 0; running; ++i) {
+                std::string body = "{\"donorId\":\"" + donorId + "\",\"status\":\"" + statuses[(i + h) % 2] + "\"}";
+                httpCall(host, port, "POST", "/api/donor/status", body);
+                ++hammerCalls;
+            }
+        });
+    }
+
+    PollResult result;
+    result.failures = 0;
+    auto end = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                      std::chrono::duration<double>(seconds));
+    while (std::chrono::steady_clock::now() < end) {
+        auto t0 = std::chrono::steady_clock::now();
+        int status = httpCall(host, port, "GET", "/api/health", "");
+        result.millis.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+        if (status != 200) ++result.failures;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    running = false;
+    for (size_t h = 0; h < hammers.size(); ++h) hammers[h].join();
+    result.hammerCalls = hammerCalls.load();
+    std::sort(result.millis.begin(), result.millis.end());
+    return result;
+}
+
+static void report(const char* label, const PollResult& r) {
+    if (r.millis.empty()) {
+        std::printf("%-8s no polls\n", label);
+        return;
+    }
+    double p50 = r.millis[r.millis.size() / 2];
+    double p99 = r.millis[std::min(r.millis.size() - 1, r.millis.size() * 99 / 100)];
+    std::printf("%-8s %6zu polls  p50 %8.2f ms  p99 %8.2f ms  max %8.2f ms  failed %d  status calls %lu\n", label,
+                r.millis.size(), p50, p99, r.millis.back(), r.failures, r.hammerCalls);
+}
+
+int main(int argc, char** argv) {
+    std::string host = argc > 1 ? argv[1] : "127.0.0.1";
+    std::string port = argc > 2 ? argv[2] : "18080";
+    double seconds = argc > 3 ? std::atof(argv[3]) : 8;
+    int hammer = argc > 4 ? std::atoi(argv[4]) : 4;
+    std::string donorId = argc > 5 ? argv[5] : "DON-001";
+    if (seconds <= 0 || hammer < 0) {
+        std::fprintf(stderr, "usage: %s [host] [port] [seconds>0] [hammer>=0] [donorId]\n", argv[0]);
+        return 2;
+    }
+    if (httpCall(host, port, "GET", "/api/health", "") != 200) {
+        std::fprintf(stderr, "no healthy server at %s:%s\n", host.c_str(), port.c_str());
+        return 1;
+    }
+
+    std::printf("server %s:%s, %.1f s per phase, %d status hammer clients on %s\n", host.c_str(), port.c_str(),
+                seconds, hammer, donorId.c_str());
+    PollResult idle = poll(host, port, seconds, 0, donorId);
+    report("idle", idle);
+    PollResult loaded = poll(host, port, seconds, hammer, donorId);
+    report("loaded", loaded);
+    return idle.failures == 0 && loaded.failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+// JSON throughput: JsonCodec (schema-driven reader/writer) against crow's
+// json::load + .s() and wvalue dump() on the bodies the handlers actually
+// see - a donor registration, a donor dashboard and a transaction.
+//
+// Usage: bench_json_codec [iterations=200000]
+// Fails if the two sides disagree on any parsed or encoded field.
+#include "crow_all.h"
+#include "logic/JsonCodec.hpp"
+#include "models/Models.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+typedef std::chrono::steady_clock Clock;
+
+static const std::string REGISTRATION_BODY =
+    "{\"name\":\"Arham Ali\",\"cnic\":\"42101-1234567-1\",\"age\":28,\"gender\":\"Male\","
+    "\"email\":\"arham@example.com\",\"phone\":\"0300-1112223\",\"address\":\"House 12, Street 4, F-7/2\","
+    "\"bloodGroup\":\"O+\",\"city\":\"Islamabad\",\"area\":\"F-7\",\"locationNodeId\":\"D1\","
+    "\"password\":\"s3cret-pass\",\"lastDonationDate\":\"2026-03-14\"}";
+
+static Donor sampleDonor() {
+    Donor d;
+    d.id = "DON-001";
+    d.name = "Arham Ali";
+    d.bloodGroup = "O+";
+    d.status = "Available";
+    d.totalDonations = 7;
+    d.badgeLevel = "Gold";
+    d.city = "Islamabad";
+    d.area = "F-7";
+    d.lastDonationDate = "2026-03-14";
+    d.nextEligibleDate = "2026-06-12";
+    return d;
+}
+
+static Transaction sampleTransaction() {
+    Transaction t;
+    t.id = "TRN-42";
+    t.donorId = "DON-001";
+    t.recipientId = "REC-017";
+    t.bloodGroup = "O+";
+    t.units = 1;
+    t.hospitalId = "H1";
+    t.distance = 4.75;
+    t.matchTime = "2026-10-19 08:42:10";
+    t.travelTime = "18 min";
+    t.status = "Completed";
+    t.timestamp = "2026-10-19 09:15:02";
+    return t;
+}
+
+template<typename F>
+static double nanosPerOp(long iterations, F f) {
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i) f();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+}
+
+static void report(const char* label, double crowNs, double codecNs) {
+    std::printf("%-20s %10.0f %10.0f %7.1fx\n", label, crowNs, codecNs, crowNs / codecNs);
+}
+
+int main(int argc, char** argv) {
+    long iterations = argc > 1 ? std::atol(argv[1]) : 200000;
+    if (iterations < 1) {
+        std::fprintf(stderr, "usage: %s [iterations>=1]\n", argv[0]);
+        return 2;
+    }
+    int mismatches = 0;
+    std::printf("%ld iterations per operation\n", iterations);
+    std::printf("%-20s %10s %10s %8s\n", "ns/op", "crow", "codec", "speedup");
+
+    // Parse a registration body into a Donor
+    Donor viaCrow, viaCodec;
+    double crowParse = nanosPerOp(iterations, [&]() {
+        auto body = crow::json::load(REGISTRATION_BODY);
+        viaCrow.name = body["name"].s();
+        viaCrow.cnic = body["cnic"].s();
+        viaCrow.age = static_cast<int>(body["age"].i());
+        viaCrow.gender = body["gender"].s();
+        viaCrow.email = body["email"].s();
+        viaCrow.phone = body["phone"].s();
+        viaCrow.address = body["address"].s();
+        viaCrow.bloodGroup = body["bloodGroup"].s();
+        viaCrow.city = body["city"].s();
+        viaCrow.area = body["area"].s();
+        viaCrow.locationNodeId = body["locationNodeId"].s();
+        viaCrow.passwordHash = body["password"].s();
+        viaCrow.lastDonationDate = body["lastDonationDate"].s();
+    });
+    bool parsed = true;
+    double codecParse = nanosPerOp(iterations, [&]() {
+        parsed &= JsonReader(REGISTRATION_BODY).parse<DonorRegistrationJson>(viaCodec);
+    });
+    if (!parsed || viaCrow.name != viaCodec.name || viaCrow.age != viaCodec.age || viaCrow.address != viaCodec.address ||
+        viaCrow.passwordHash != viaCodec.passwordHash || viaCrow.lastDonationDate != viaCodec.lastDonationDate) {
+        ++mismatches;
+    }
+    report("parse registration", crowParse, codecParse);
+
+    // Encode a dashboard body
+    Donor donor = sampleDonor();
+    std::string crowOut, codecOut;
+    double crowDashboard = nanosPerOp(iterations, [&]() {
+        crow::json::wvalue response;
+        response["success"] = true;
+        response["id"] = donor.id;
+        response["name"] = donor.name;
+        response["bloodGroup"] = donor.bloodGroup;
+        response["status"] = donor.status;
+        response["totalDonations"] = donor.totalDonations;
+        response["badgeLevel"] = donor.badgeLevel;
+        response["city"] = donor.city;
+        response["area"] = donor.area;
+        response["lastDonationDate"] = donor.lastDonationDate;
+        response["nextEligibleDate"] = donor.nextEligibleDate;
+        response["eligible"] = false;
+        crowOut = response.dump();
+    });
+    double codecDashboard = nanosPerOp(iterations, [&]() {
+        JsonWriter response(JsonWriter::threadBuffer());
+        response.beginObject();
+        response.field("success", true);
+        response.fields<DonorDashboardJson>(donor);
+        response.field("eligible", false);
+        response.endObject();
+        codecOut = response.str();
+    });
+    auto a = crow::json::load(crowOut), b = crow::json::load(codecOut);
+    if (!a || !b || a["name"].s() != b["name"].s() || a["totalDonations"].i() != b["totalDonations"].i() ||
+        a["nextEligibleDate"].s() != b["nextEligibleDate"].s() || a.size() != b.size()) {
+        ++mismatches;
+    }
+    report("encode dashboard", crowDashboard, codecDashboard);
+
+    // Encode a transaction
+    Transaction t = sampleTransaction();
+    double crowTransaction = nanosPerOp(iterations, [&]() {
+        crow::json::wvalue txn;
+        txn["id"] = t.id;
+        txn["donorId"] = t.donorId;
+        txn["recipientId"] = t.recipientId;
+        txn["bloodGroup"] = t.bloodGroup;
+        txn["units"] = t.units;
+        txn["hospitalId"] = t.hospitalId;
+        txn["distance"] = t.distance;
+        txn["matchTime"] = t.matchTime;
+        txn["travelTime"] = t.travelTime;
+        txn["status"] = t.status;
+        txn["timestamp"] = t.timestamp;
+        crowOut = txn.dump();
+    });
+    double codecTransaction = nanosPerOp(iterations, [&]() {
+        JsonWriter txn(JsonWriter::threadBuffer());
+        txn.beginObject();
+        txn.fields<TransactionJson>(t);
+        txn.endObject();
+        codecOut = txn.str();
+    });
+    a = crow::json::load(crowOut);
+    b = crow::json::load(codecOut);
+    if (!a || !b || a["recipientId"].s() != b["recipientId"].s() || a["distance"].d() != b["distance"].d() ||
+        a["travelTime"].s() != b["travelTime"].s() || a.size() != b.size()) {
+        ++mismatches;
+    }
+    report("encode transaction", crowTransaction, codecTransaction);
+
+    if (mismatches) std::printf("mismatches: %d\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
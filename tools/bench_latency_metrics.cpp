@@ -0,0 +1,106 @@
+// Instrumentation overhead: LatencyMetrics per-thread shards (observe,
+// counter add, scoped Timer) against a shared histogram updated with
+// atomic fetch_add, plus the cost of one steady_clock read. Every thread
+// runs the same loop; the table is ns per call as seen by one thread.
+//
+// Usage: bench_latency_metrics [iterations=10000000] [threads=1]
+// Use threads > 1 on a multi-core host to see the contention sharding avoids.
+// Fails if /metrics does not report exactly the observations made.
+#include "logic/LatencyMetrics.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+// The obvious alternative: one histogram shared by all threads
+struct SharedHistogram {
+    std::atomic<uint64_t> buckets[LatencyMetrics::BUCKETS];
+    std::atomic<uint64_t> sumNanos;
+    SharedHistogram() : sumNanos(0) {
+        for (size_t b = 0; b < LatencyMetrics::BUCKETS; ++b) buckets[b].store(0);
+    }
+    void observe(uint64_t nanos) {
+        static const uint64_t bounds[LatencyMetrics::BUCKETS - 1] = {
+            10000ULL, 25000ULL, 50000ULL, 100000ULL, 250000ULL, 500000ULL,
+            1000000ULL, 2500000ULL, 5000000ULL, 10000000ULL, 25000000ULL, 50000000ULL,
+            100000000ULL, 250000000ULL, 500000000ULL, 1000000000ULL, 2500000000ULL, 5000000000ULL,
+            10000000000ULL};
+        size_t bucket = 0;
+        while (bucket < LatencyMetrics::BUCKETS - 1 && nanos > bounds[bucket]) ++bucket;
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        sumNanos.fetch_add(nanos, std::memory_order_relaxed);
+    }
+};
+
+// threads x iterations calls of op(i); returns ns per call per thread
+template<typename Op>
+static double perCall(int threads, long iterations, Op op) {
+    std::vector<double> nanos(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            Clock::time_point start = Clock::now();
+            for (long i = 0; i < iterations; ++i) op(i);
+            nanos[t] = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        });
+    }
+    double total = 0;
+    for (int t = 0; t < threads; ++t) {
+        workers[t].join();
+        total += nanos[t];
+    }
+    return total / threads / iterations;
+}
+
+// Value of the sample line "<series> <value>" in the scrape text, -1 if missing
+static long long scraped(const std::string& text, const std::string& series) {
+    size_t at = text.find("\n" + series + " ");
+    return at == std::string::npos ? -1 : std::atoll(text.c_str() + at + series.size() + 2);
+}
+
+int main(int argc, char** argv) {
+    long iterations = argc > 1 ? std::atol(argv[1]) : 10000000;
+    int threads = argc > 2 ? std::atoi(argv[2]) : 1;
+    if (iterations < 1 || threads < 1) {
+        std::fprintf(stderr, "usage: %s [iterations>=1] [threads>=1]\n", argv[0]);
+        return 2;
+    }
+
+    LatencyMetrics metrics;
+    LatencyMetrics::Series observed = metrics.phase("bench_observe");
+    LatencyMetrics::Series timed = metrics.phase("bench_timer");
+    LatencyMetrics::Series counted = metrics.counter("bench_ops_total", "Counter adds made by the benchmark");
+    SharedHistogram shared;
+    std::atomic<uint64_t> sink(0);
+
+    std::printf("%ld iterations x %d threads (%u hardware threads)\n", iterations, threads,
+                std::thread::hardware_concurrency());
+    std::printf("%-28s %8.1f ns\n", "sharded observe",
+                perCall(threads, iterations, [&](long i) { metrics.observeNanos(observed, 1000 + (i & 0xffff) * 64); }));
+    std::printf("%-28s %8.1f ns\n", "shared fetch_add histogram",
+                perCall(threads, iterations, [&](long i) { shared.observe(1000 + (i & 0xffff) * 64); }));
+    std::printf("%-28s %8.1f ns\n", "counter add",
+                perCall(threads, iterations, [&](long) { metrics.add(counted); }));
+    std::printf("%-28s %8.1f ns\n", "steady_clock::now",
+                perCall(threads, iterations, [&](long) {
+                    sink.store(static_cast<uint64_t>(Clock::now().time_since_epoch().count()), std::memory_order_relaxed);
+                }));
+    std::printf("%-28s %8.1f ns\n", "scoped Timer",
+                perCall(threads, iterations, [&](long) { LatencyMetrics::Timer timer(&metrics, timed); }));
+    std::printf("%-28s %8.1f ns\n", "scoped Timer, metrics unset",
+                perCall(threads, iterations, [&](long) { LatencyMetrics::Timer timer(nullptr, timed); }));
+
+    const long long expected = static_cast<long long>(iterations) * threads;
+    std::string text = metrics.scrape();
+    bool ok = scraped(text, "bloodconnect_phase_duration_seconds_count{phase=\"bench_observe\"}") == expected &&
+              scraped(text, "bloodconnect_phase_duration_seconds_count{phase=\"bench_timer\"}") == expected &&
+              scraped(text, "bench_ops_total") == expected;
+    if (!ok) std::printf("scrape does not match the %lld observations per series\n", expected);
+    return ok ? 0 : 1;
+}
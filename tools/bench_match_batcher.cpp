@@ -0,0 +1,160 @@
+// Burst matching: MatchBatcher (one shared search per hospital per window)
+// against one-at-a-time matching (a single-recipient matchGroup per request
+// behind a global mutex). Donors sit on random nodes of a jittered grid,
+// requests go to a few hospitals and are submitted from several threads.
+//
+// Usage: bench_match_batcher [gridSide=200] [donors=4000] [hospitals=3] [threads=8] [seed=42]
+// Runs bursts of 1200, 60 and 8 requests with a fresh donor pool each.
+// Fails if any donor is handed to two requests.
+#include "dsa/CustomGraph.hpp"
+#include "logic/MatchBatcher.hpp"
+#include "logic/MatchingEngine.hpp"
+#include "models/Models.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <utility>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::string nodeId(int x, int y) {
+    return "N" + std::to_string(x) + "_" + std::to_string(y);
+}
+
+static const char* const BLOOD_GROUPS[] = {"O+", "O-", "A+", "A-", "B+", "B-", "AB+", "AB-"};
+
+struct Burst {
+    std::vector<std::unique_ptr<Donor>> donors;
+    std::vector<std::unique_ptr<Recipient>> recipients;
+};
+
+// Same seed -> same donors and requests for both modes
+static Burst makeBurst(int side, int donorCount, int hospitals, int requests, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> coord(0, side - 1);
+    Burst burst;
+    for (int i = 0; i < donorCount; ++i) {
+        std::unique_ptr<Donor> d(new Donor());
+        d->id = "DON-" + std::to_string(i);
+        d->bloodGroup = BLOOD_GROUPS[rng() % 8];
+        d->status = "Available";
+        d->locationNodeId = nodeId(coord(rng), coord(rng));
+        burst.donors.push_back(std::move(d));
+    }
+    for (int i = 0; i < requests; ++i) {
+        std::unique_ptr<Recipient> r(new Recipient());
+        r->id = "REC-" + std::to_string(i);
+        r->bloodGroupNeeded = BLOOD_GROUPS[rng() % 8];
+        r->urgency = (rng() % 4 == 0) ? "Immediate" : "High";
+        r->status = "Pending";
+        int h = static_cast<int>(rng() % hospitals);
+        r->locationNodeId = nodeId(side / 4 + h * side / (2 * hospitals), side / 2);
+        burst.recipients.push_back(std::move(r));
+    }
+    return burst;
+}
+
+struct Outcome {
+    double seconds;
+    int matched;
+    int duplicates;
+};
+
+// threads submitters, each takes the next request until the burst is done
+// and only then waits for its answers - The whole burst is in flight at once
+template<typename Submit>
+static Outcome runBurst(Burst& burst, int threads, Submit submit) {
+    std::vector<Donor*> chosen(burst.recipients.size(), nullptr);
+    std::atomic<size_t> next(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < threads; ++t) {
+        submitters.emplace_back([&]() {
+            std::vector<std::pair<size_t, std::future<MatchingEngine::TimedMatch>>> pending;
+            for (size_t i = next++; i < burst.recipients.size(); i = next++) {
+                pending.emplace_back(i, submit(burst.recipients[i].get()));
+            }
+            for (size_t p = 0; p < pending.size(); ++p) chosen[pending[p].first] = pending[p].second.get().donor;
+        });
+    }
+    for (size_t t = 0; t < submitters.size(); ++t) submitters[t].join();
+    Outcome out;
+    out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    out.matched = 0;
+    out.duplicates = 0;
+    std::set<Donor*> seen;
+    for (size_t i = 0; i < chosen.size(); ++i) {
+        if (!chosen[i]) continue;
+        ++out.matched;
+        if (!seen.insert(chosen[i]).second) ++out.duplicates;
+    }
+    return out;
+}
+
+int main(int argc, char** argv) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 200;
+    int donorCount = argc > 2 ? std::atoi(argv[2]) : 4000;
+    int hospitals = argc > 3 ? std::atoi(argv[3]) : 3;
+    int threads = argc > 4 ? std::atoi(argv[4]) : 8;
+    unsigned seed = argc > 5 ? static_cast<unsigned>(std::atoi(argv[5])) : 42u;
+    if (side < 2 || donorCount < 1 || hospitals < 1 || threads < 1) {
+        std::fprintf(stderr, "usage: %s [gridSide>=2] [donors>=1] [hospitals>=1] [threads>=1] [seed]\n", argv[0]);
+        return 2;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> jitter(1.0, 1.6);
+    CustomGraph graph;
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) graph.addNode(nodeId(x, y), "", "area", x * 10, y * 10);
+    }
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) {
+            if (x + 1 < side) graph.addEdge(nodeId(x, y), nodeId(x + 1, y), jitter(rng));
+            if (y + 1 < side) graph.addEdge(nodeId(x, y), nodeId(x, y + 1), jitter(rng));
+        }
+    }
+
+    std::printf("graph: %d nodes, %d donors, %d hospitals, %d submitting threads (seed %u)\n",
+                side * side, donorCount, hospitals, threads, seed);
+    std::printf("%8s %-14s %10s %12s %11s\n", "requests", "mode", "req/s", "matched", "duplicates");
+    const double departure = 9 * 60;
+    const int bursts[] = {1200, 60, 8};
+    int duplicates = 0;
+    for (int requests : bursts) {
+        for (int mode = 0; mode < 2; ++mode) {
+            Burst burst = makeBurst(side, donorCount, hospitals, requests, seed);
+            MatchingEngine engine(&graph);
+            for (size_t i = 0; i < burst.donors.size(); ++i) engine.addDonor(burst.donors[i].get());
+
+            Outcome out;
+            if (mode == 0) {
+                std::mutex serial;
+                out = runBurst(burst, threads, [&](Recipient* r) {
+                    std::promise<MatchingEngine::TimedMatch> done;
+                    CustomVector<Recipient*> one;
+                    one.push_back(r);
+                    {
+                        std::lock_guard<std::mutex> guard(serial);
+                        done.set_value(engine.matchGroup(one, departure)[0]);
+                    }
+                    return done.get_future();
+                });
+            } else {
+                MatchBatcher batcher(&engine);
+                out = runBurst(burst, threads, [&](Recipient* r) { return batcher.submit(r, departure); });
+            }
+            duplicates += out.duplicates;
+            std::printf("%8d %-14s %10.0f %7d/%-4d %11d\n", requests, mode == 0 ? "one-at-a-time" : "MatchBatcher",
+                        requests / out.seconds, out.matched, requests, out.duplicates);
+        }
+    }
+    return duplicates == 0 ? 0 : 1;
+}
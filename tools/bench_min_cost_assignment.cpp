@@ -0,0 +1,155 @@
+// Greedy vs global assignment after a burst: first-come greedy (each request
+// in arrival order takes its nearest free compatible donor) against
+// MatchingEngine::assignPendingRecipients on the same donors and requests.
+// Cost = urgency-weighted km plus UNASSIGNED_PENALTY_KM x weight per
+// unmatched request, the same objective the global pass minimises.
+//
+// Usage: bench_min_cost_assignment [gridSide=200] [k=16] [seed=42]
+// Runs the donors/pending/hospitals table from the user-034 commit.
+// Fails if the global pass costs more than greedy.
+#include "dsa/CustomGraph.hpp"
+#include "logic/BloodCompatibility.hpp"
+#include "logic/MatchingEngine.hpp"
+#include "models/Models.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+static std::string nodeId(int x, int y) {
+    return "N" + std::to_string(x) + "_" + std::to_string(y);
+}
+
+static const char* const BLOOD_GROUPS[] = {"O+", "O-", "A+", "A-", "B+", "B-", "AB+", "AB-"};
+static const char* const URGENCIES[] = {"Immediate", "High", "Medium", "Low"};
+
+struct Scenario {
+    std::vector<std::unique_ptr<Donor>> donors;
+    std::vector<std::unique_ptr<Recipient>> recipients;  // Arrival order
+};
+
+static Scenario makeScenario(int side, int donorCount, int pendingCount, int hospitals, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> coord(0, side - 1);
+    std::vector<std::string> hospitalNodes;
+    for (int h = 0; h < hospitals; ++h) hospitalNodes.push_back(nodeId(coord(rng), coord(rng)));
+    Scenario s;
+    for (int i = 0; i < donorCount; ++i) {
+        std::unique_ptr<Donor> d(new Donor());
+        d->id = "DON-" + std::to_string(i);
+        d->bloodGroup = BLOOD_GROUPS[rng() % 8];
+        d->status = "Available";
+        d->locationNodeId = nodeId(coord(rng), coord(rng));
+        s.donors.push_back(std::move(d));
+    }
+    for (int i = 0; i < pendingCount; ++i) {
+        std::unique_ptr<Recipient> r(new Recipient());
+        r->id = "REC-" + std::to_string(i);
+        r->bloodGroupNeeded = BLOOD_GROUPS[rng() % 8];
+        r->urgency = URGENCIES[rng() % 4];
+        r->status = "Pending";
+        r->locationNodeId = hospitalNodes[rng() % hospitals];
+        s.recipients.push_back(std::move(r));
+    }
+    return s;
+}
+
+struct GreedyResult {
+    double cost;
+    int unmatchedImmediate;
+};
+
+static GreedyResult runGreedy(const CustomGraph& graph, Scenario& s) {
+    BloodCompatibility compatibility;
+    std::map<std::string, std::vector<Donor*>> donorsAt;
+    for (size_t i = 0; i < s.donors.size(); ++i) donorsAt[s.donors[i]->locationNodeId].push_back(s.donors[i].get());
+    std::set<Donor*> taken;
+    GreedyResult out;
+    out.cost = 0;
+    out.unmatchedImmediate = 0;
+    for (size_t i = 0; i < s.recipients.size(); ++i) {
+        const Recipient* r = s.recipients[i].get();
+        Donor* chosen = nullptr;
+        double km = 0;
+        graph.expandFrom(r->locationNodeId, [&](const std::string& node, double distance) {
+            std::map<std::string, std::vector<Donor*>>::iterator at = donorsAt.find(node);
+            if (at == donorsAt.end()) return true;
+            for (size_t d = 0; d < at->second.size(); ++d) {
+                Donor* donor = at->second[d];
+                if (!taken.count(donor) && compatibility.canDonateTo(donor->bloodGroup, r->bloodGroupNeeded)) {
+                    chosen = donor;
+                    km = distance;
+                    return false;
+                }
+            }
+            return true;
+        });
+        double weight = MatchingEngine::urgencyWeight(r);
+        if (chosen) {
+            taken.insert(chosen);
+            out.cost += km * weight;
+        } else {
+            out.cost += MatchingEngine::UNASSIGNED_PENALTY_KM * weight;
+            if (r->urgency == "Immediate") ++out.unmatchedImmediate;
+        }
+    }
+    return out;
+}
+
+int main(int argc, char** argv) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 200;
+    int k = argc > 2 ? std::atoi(argv[2]) : 16;
+    unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 42u;
+    if (side < 2 || k < 1) {
+        std::fprintf(stderr, "usage: %s [gridSide>=2] [k>=1] [seed]\n", argv[0]);
+        return 2;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> jitter(1.0, 1.6);
+    CustomGraph graph;
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) graph.addNode(nodeId(x, y), "", "area", x * 10, y * 10);
+    }
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) {
+            if (x + 1 < side) graph.addEdge(nodeId(x, y), nodeId(x + 1, y), jitter(rng));
+            if (y + 1 < side) graph.addEdge(nodeId(x, y), nodeId(x, y + 1), jitter(rng));
+        }
+    }
+
+    std::printf("graph: %d nodes, k = %d (seed %u)\n", side * side, k, seed);
+    std::printf("%24s %12s %12s %10s %10s %18s\n", "donors/pending/hospitals", "greedy cost", "global cost",
+                "solve ms", "total ms", "Immediate unmatched");
+    const int table[][3] = {{4000, 1000, 10}, {4000, 3000, 20}, {1200, 1000, 10}, {1000, 1000, 10}};
+    int worse = 0;
+    for (const int* row : table) {
+        Scenario greedy = makeScenario(side, row[0], row[1], row[2], seed);
+        GreedyResult g = runGreedy(graph, greedy);
+
+        Scenario global = makeScenario(side, row[0], row[1], row[2], seed);
+        MatchingEngine engine(&graph);
+        for (size_t i = 0; i < global.donors.size(); ++i) engine.addDonor(global.donors[i].get());
+        for (size_t i = 0; i < global.recipients.size(); ++i) engine.addRecipientRequest(global.recipients[i].get());
+        auto t0 = std::chrono::steady_clock::now();
+        MatchingEngine::AssignmentReport report = engine.assignPendingRecipients(static_cast<size_t>(k));
+        double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        int unmatchedImmediate = 0;
+        for (size_t i = 0; i < global.recipients.size(); ++i) {
+            const Recipient* r = global.recipients[i].get();
+            if (r->urgency == "Immediate" && r->status == "Pending") ++unmatchedImmediate;
+        }
+
+        if (report.totalCost > g.cost * (1 + 1e-9)) ++worse;
+        char label[32];
+        std::snprintf(label, sizeof(label), "%d / %d / %d", row[0], row[1], row[2]);
+        std::printf("%24s %12.0f %12.0f %10.1f %10.1f %8d -> %-8d\n", label, g.cost, report.totalCost,
+                    report.solveMicros / 1000.0, totalMs, g.unmatchedImmediate, unmatchedImmediate);
+    }
+    return worse == 0 ? 0 : 1;
+}
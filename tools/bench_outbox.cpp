@@ -0,0 +1,101 @@
+// NotificationOutbox throughput and enqueue latency against an in-process
+// gateway (no HTTP - the journal, batching and retry paths are the same).
+// Three runs, each with a fresh journal:
+//   1. paced: rate msg/s offered for a few seconds - delivered rate,
+//      average batch, enqueue p50/p99
+//   2. unthrottled: messages enqueued back to back
+//   3. failures: the gateway fails 20% of messages and takes 20 ms per
+//      call - everything must still be delivered through retries. The last
+//      few messages wait out the full backoff ladder, so this run takes
+//      tens of seconds
+//
+// Usage: bench_outbox [rate=10000] [seconds=2] [messages=50000] [workers=4] [journalDir=/tmp]
+#include "logic/NotificationOutbox.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct GatewayModel {
+    double failRate;
+    std::chrono::milliseconds latency;
+};
+
+static NotificationOutbox::Gateway makeGateway(const GatewayModel& model) {
+    return [model](const CustomVector<Notification*>& batch, CustomVector<bool>& delivered) {
+        thread_local std::mt19937 rng(std::random_device{}());
+        std::uniform_real_distribution<double> roll(0.0, 1.0);
+        if (model.latency.count() > 0) std::this_thread::sleep_for(model.latency);
+        for (size_t i = 0; i < batch.getSize(); ++i) delivered[i] = roll(rng) >= model.failRate;
+    };
+}
+
+// Enqueue `messages` at `rate` msg/s (0 = as fast as possible), wait for the
+// outbox to drain, print one report line
+static bool run(const char* label, const GatewayModel& model, const std::string& journal, size_t workers,
+                long messages, double rate) {
+    std::remove(journal.c_str());
+    NotificationOutbox outbox(makeGateway(model), journal, workers);
+    outbox.start();
+    std::vector<double> enqueueMicros;
+    enqueueMicros.reserve(static_cast<size_t>(messages));
+
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < messages; ++i) {
+        if (rate > 0) {
+            auto slot = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                    std::chrono::duration<double>(i / rate));
+            std::this_thread::sleep_until(slot);
+        }
+        auto t0 = std::chrono::steady_clock::now();
+        outbox.enqueue("DON-" + std::to_string(i % 4000), "+92300" + std::to_string(1000000 + i % 4000), "sms",
+                       "match", "Blood request REC-" + std::to_string(i) + " needs you at PIMS. Reply YES to accept.");
+        enqueueMicros.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+    }
+
+    NotificationOutbox::Stats stats = outbox.getStats();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::minutes(2);
+    while (stats.pending > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        stats = outbox.getStats();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    outbox.stop();
+    std::remove(journal.c_str());
+
+    std::sort(enqueueMicros.begin(), enqueueMicros.end());
+    double p50 = enqueueMicros[enqueueMicros.size() / 2];
+    double p99 = enqueueMicros[std::min(enqueueMicros.size() - 1, enqueueMicros.size() * 99 / 100)];
+    std::printf("%-12s %8ld %11.0f %9.1f %8.2f %8.2f %8lu %6lu %7lu\n", label, messages, stats.delivered / seconds,
+                stats.avgBatch(), p50, p99, stats.retried, stats.dead, stats.gatewayCalls);
+    return stats.pending == 0 && stats.delivered == static_cast<unsigned long>(messages);
+}
+
+int main(int argc, char** argv) {
+    double rate = argc > 1 ? std::atof(argv[1]) : 10000;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 2;
+    long messages = argc > 3 ? std::atol(argv[3]) : 50000;
+    size_t workers = argc > 4 ? static_cast<size_t>(std::atoi(argv[4])) : 4;
+    std::string dir = argc > 5 ? argv[5] : "/tmp";
+    if (rate <= 0 || seconds <= 0 || messages < 1 || workers < 1) {
+        std::fprintf(stderr, "usage: %s [rate>0] [seconds>0] [messages>=1] [workers>=1] [journalDir]\n", argv[0]);
+        return 2;
+    }
+    const std::string journal = dir + "/bench_outbox.csv";
+
+    std::printf("%u hardware threads, %zu workers, journal %s\n", std::thread::hardware_concurrency(), workers,
+                journal.c_str());
+    std::printf("%-12s %8s %11s %9s %8s %8s %8s %6s %7s\n", "run", "messages", "delivered/s", "avg batch",
+                "p50 us", "p99 us", "retried", "dead", "calls");
+    bool ok = true;
+    GatewayModel clean = {0.0, std::chrono::milliseconds(0)};
+    GatewayModel flaky = {0.2, std::chrono::milliseconds(20)};
+    ok &= run("paced", clean, journal, workers, static_cast<long>(rate * seconds), rate);
+    ok &= run("unthrottled", clean, journal, workers, messages, 0);
+    ok &= run("failures", flaky, journal, workers, messages, 0);
+    return ok ? 0 : 1;
+}
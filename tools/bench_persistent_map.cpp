@@ -0,0 +1,95 @@
+// Map microbenchmark: PersistentHashMap (HAMT) vs CustomHashMap with
+// "DON-n" string keys - insert, random get, and taking a snapshot.
+// CustomHashMap has no cheap copy, so its snapshot is a full rebuild
+// (what StateStore did before); the HAMT snapshot is a root copy.
+//
+// Usage: bench_persistent_map [maxN=1000000] [probes=1000000] [seed=42]
+// Runs N = 1k, 10k, ... up to maxN. Fails if the two maps disagree on a probe.
+#include "dsa/CustomHashMap.hpp"
+#include "dsa/PersistentHashMap.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static double nanosSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    long maxN = argc > 1 ? std::atol(argv[1]) : 1000000;
+    long probes = argc > 2 ? std::atol(argv[2]) : 1000000;
+    unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 42u;
+    if (maxN < 1000 || probes < 1) {
+        std::fprintf(stderr, "usage: %s [maxN>=1000] [probes>=1] [seed]\n", argv[0]);
+        return 2;
+    }
+
+    std::printf("%8s | %10s %10s | %8s %8s | %16s %14s\n", "N", "insert ns", "", "get ns", "",
+                "snapshot", "");
+    std::printf("%8s | %10s %10s | %8s %8s | %16s %14s\n", "", "custom", "hamt", "custom", "hamt",
+                "custom (rebuild)", "hamt (copy)");
+    int mismatches = 0;
+    for (long n = 1000; n <= maxN; n *= 10) {
+        std::vector<std::string> keys;
+        for (long i = 0; i < n; ++i) keys.push_back("DON-" + std::to_string(i + 1));
+
+        CustomHashMap<std::string, long> custom;
+        Clock::time_point t0 = Clock::now();
+        for (long i = 0; i < n; ++i) custom.insert(keys[i], i);
+        double customInsert = nanosSince(t0) / n;
+
+        PersistentHashMap<std::string, long> hamt;
+        t0 = Clock::now();
+        for (long i = 0; i < n; ++i) hamt.insert(keys[i], i);
+        double hamtInsert = nanosSince(t0) / n;
+
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<long> pick(0, n - 1);
+        std::vector<long> order;
+        for (long p = 0; p < probes; ++p) order.push_back(pick(rng));
+        long customSum = 0, hamtSum = 0;
+        t0 = Clock::now();
+        for (long p = 0; p < probes; ++p) {
+            long v = -1;
+            custom.get(keys[order[p]], v);
+            customSum += v;
+        }
+        double customGet = nanosSince(t0) / probes;
+        t0 = Clock::now();
+        for (long p = 0; p < probes; ++p) {
+            long v = -1;
+            hamt.get(keys[order[p]], v);
+            hamtSum += v;
+        }
+        double hamtGet = nanosSince(t0) / probes;
+        if (customSum != hamtSum) ++mismatches;
+
+        t0 = Clock::now();
+        {
+            CustomHashMap<std::string, long> rebuilt(custom.getSize() * 2 + 16);
+            CustomVector<std::string> all = custom.getKeys();
+            for (size_t i = 0; i < all.getSize(); ++i) {
+                long v = 0;
+                custom.get(all[i], v);
+                rebuilt.insert(all[i], v);
+            }
+        }
+        double customSnapshot = nanosSince(t0);
+
+        const int copies = 1000;
+        std::vector<PersistentHashMap<std::string, long>> held(copies);
+        t0 = Clock::now();
+        for (int c = 0; c < copies; ++c) held[c] = hamt;
+        double hamtSnapshot = nanosSince(t0) / copies;
+
+        std::printf("%8ld | %10.0f %10.0f | %8.0f %8.0f | %13.2f ms %11.1f ns\n", n, customInsert, hamtInsert,
+                    customGet, hamtGet, customSnapshot / 1e6, hamtSnapshot);
+    }
+    if (mismatches) std::printf("probe mismatches: %d\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
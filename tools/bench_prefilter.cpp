@@ -0,0 +1,118 @@
+// Nearest compatible donor by road distance: a full scan (one dijkstra per
+// compatible donor) against the CoordinatePrefilter loop, which visits
+// donors in ascending lower-bound order (lowerBoundScale x straight-line
+// distance) and stops once the next bound can't beat the best route.
+//
+// Usage: bench_prefilter [gridSide=200] [donors=1000] [queries=3] [seed=42]
+// Every query checks that both pick a donor at the same road distance.
+// The full scan is slow by design - keep queries small for 4000 donors.
+#include "dsa/CoordinatePrefilter.hpp"
+#include "dsa/CustomGraph.hpp"
+#include "logic/BloodCompatibility.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::string nodeId(int x, int y) {
+    return "N" + std::to_string(x) + "_" + std::to_string(y);
+}
+
+static const char* const BLOOD_GROUPS[] = {"O+", "O-", "A+", "A-", "B+", "B-", "AB+", "AB-"};
+
+struct Candidate {
+    std::string node;
+    std::string bloodGroup;
+};
+
+int main(int argc, char** argv) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 200;
+    int donorCount = argc > 2 ? std::atoi(argv[2]) : 1000;
+    int queries = argc > 3 ? std::atoi(argv[3]) : 3;
+    unsigned seed = argc > 4 ? static_cast<unsigned>(std::atoi(argv[4])) : 42u;
+    if (side < 2 || donorCount < 1 || queries < 1) {
+        std::fprintf(stderr, "usage: %s [gridSide>=2] [donors>=1] [queries>=1] [seed]\n", argv[0]);
+        return 2;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> jitter(1.0, 1.6);
+    CustomGraph graph;
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) graph.addNode(nodeId(x, y), "", "area", x * 10, y * 10);
+    }
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) {
+            if (x + 1 < side) graph.addEdge(nodeId(x, y), nodeId(x + 1, y), jitter(rng));
+            if (y + 1 < side) graph.addEdge(nodeId(x, y), nodeId(x, y + 1), jitter(rng));
+        }
+    }
+
+    std::uniform_int_distribution<int> coord(0, side - 1);
+    std::vector<Candidate> donors;
+    for (int i = 0; i < donorCount; ++i) {
+        Candidate c;
+        c.node = nodeId(coord(rng), coord(rng));
+        c.bloodGroup = BLOOD_GROUPS[rng() % 8];
+        donors.push_back(c);
+    }
+
+    BloodCompatibility compatibility;
+    const double scale = graph.lowerBoundScale();
+    double fullMicros = 0, prefilterMicros = 0;
+    unsigned long long compatibleTotal = 0, prefilterQueries = 0;
+    int mismatches = 0;
+    for (int q = 0; q < queries; ++q) {
+        std::string hospital = nodeId(coord(rng), coord(rng));
+        std::string needed = BLOOD_GROUPS[rng() % 8];
+        std::vector<const Candidate*> compatible;
+        for (size_t i = 0; i < donors.size(); ++i) {
+            if (compatibility.canDonateTo(donors[i].bloodGroup, needed)) compatible.push_back(&donors[i]);
+        }
+        compatibleTotal += compatible.size();
+
+        auto t0 = std::chrono::steady_clock::now();
+        double fullBest = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < compatible.size(); ++i) {
+            double d = graph.dijkstra(compatible[i]->node, hospital).distance;
+            if (d < fullBest) fullBest = d;
+        }
+        auto t1 = std::chrono::steady_clock::now();
+
+        int hx = 0, hy = 0;
+        graph.getCoordinates(hospital, hx, hy);
+        CoordinatePrefilter prefilter;
+        for (size_t i = 0; i < compatible.size(); ++i) {
+            int x = 0, y = 0;
+            graph.getCoordinates(compatible[i]->node, x, y);
+            prefilter.add(x, y);
+        }
+        prefilter.computeBounds(hx, hy, scale);
+        double best = std::numeric_limits<double>::infinity();
+        size_t index;
+        while (prefilter.next(best, index)) {
+            ++prefilterQueries;
+            double d = graph.dijkstra(compatible[index]->node, hospital).distance;
+            if (d < best) best = d;
+        }
+        auto t2 = std::chrono::steady_clock::now();
+
+        fullMicros += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        prefilterMicros += std::chrono::duration<double, std::micro>(t2 - t1).count();
+        if (std::fabs(best - fullBest) > 1e-9 * (1.0 + fullBest)) ++mismatches;
+    }
+
+    std::printf("graph: %d nodes, %d donors, %d queries, lowerBoundScale %.4f (seed %u)\n",
+                side * side, donorCount, queries, scale, seed);
+    std::printf("full scan:  %8.1f graph queries/search  %12.1f ms/search\n",
+                static_cast<double>(compatibleTotal) / queries, fullMicros / queries / 1000.0);
+    std::printf("prefilter:  %8.1f graph queries/search  %12.2f ms/search\n",
+                static_cast<double>(prefilterQueries) / queries, prefilterMicros / queries / 1000.0);
+    std::printf("graph queries avoided: %.1f%%, distance mismatches: %d\n",
+                100.0 * (1.0 - static_cast<double>(prefilterQueries) / (compatibleTotal ? compatibleTotal : 1)), mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
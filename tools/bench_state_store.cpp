@@ -0,0 +1,169 @@
+// Shared-state throughput: StateStore (single writer, lock-free snapshot
+// reads) against a global mutex over a CustomHashMap of live donors.
+// Readers look up a random donor and copy its status; writers flip a
+// random donor's status, optionally followed by a full donors CSV save
+// (as the HTTP handlers do).
+//
+// Usage: bench_state_store [donors=30000] [seconds=2] [csvDir=/tmp]
+// Runs the readers/writers/save table from the user-045 commit.
+#include "logic/CSVHandler.hpp"
+#include "logic/StateStore.hpp"
+#include "models/Models.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static Donor* makeDonor(int i) {
+    Donor* d = new Donor();
+    d->id = "DON-" + std::to_string(i + 1);
+    d->name = "Donor " + std::to_string(i + 1);
+    d->bloodGroup = "O+";
+    d->status = "Available";
+    d->city = "Islamabad";
+    d->locationNodeId = "H1";
+    return d;
+}
+
+struct Counts {
+    double readsPerSecond;
+    double writesPerSecond;
+};
+
+// readers + writers threads for `seconds`; read(rng) and write(rng) do one op each
+template<typename Read, typename Write>
+static Counts hammer(int readers, int writers, double seconds, Read read, Write write) {
+    std::atomic<bool> running(true);
+    std::atomic<unsigned long> reads(0), writes(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < readers + writers; ++t) {
+        bool isReader = t < readers;
+        threads.emplace_back([&, t, isReader]() {
+            std::mt19937 rng(1000 + t);
+            unsigned long done = 0;
+            while (running) {
+                if (isReader) read(rng);
+                else write(rng);
+                ++done;
+            }
+            (isReader ? reads : writes) += done;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    running = false;
+    for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+    Counts c;
+    c.readsPerSecond = reads / seconds;
+    c.writesPerSecond = writes / seconds;
+    return c;
+}
+
+int main(int argc, char** argv) {
+    int donorCount = argc > 1 ? std::atoi(argv[1]) : 30000;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 2;
+    std::string dir = argc > 3 ? argv[3] : "/tmp";
+    if (donorCount < 1 || seconds <= 0) {
+        std::fprintf(stderr, "usage: %s [donors>=1] [seconds>0] [csvDir]\n", argv[0]);
+        return 2;
+    }
+    const std::string donorsCsv = dir + "/bench_state_donors.csv";
+    const std::string recipientsCsv = dir + "/bench_state_recipients.csv";
+    std::vector<std::string> ids;
+    for (int i = 0; i < donorCount; ++i) ids.push_back("DON-" + std::to_string(i + 1));
+    const char* const statuses[] = {"Available", "Unavailable"};
+
+    std::printf("%d donors, %.1f s per run, %u hardware threads\n", donorCount, seconds,
+                std::thread::hardware_concurrency());
+    std::printf("%4s %4s %5s | %14s %14s | %14s %14s | %9s\n", "R", "W", "save", "store reads/s", "store writes/s",
+                "mutex reads/s", "mutex writes/s", "avg batch");
+    const int table[][3] = {{4, 1, 0}, {2, 8, 0}, {4, 4, 1}, {2, 16, 1}};
+    for (const int* row : table) {
+        int readers = row[0], writers = row[1];
+        bool save = row[2] != 0;
+
+        // Single-writer store
+        Counts store;
+        double avgBatch;
+        std::vector<Donor*> owned;
+        for (int i = 0; i < donorCount; ++i) owned.push_back(makeDonor(i));
+        {
+            StateStore state(donorsCsv, recipientsCsv);
+            state.execute([&](StateStore::State& s) {
+                for (size_t i = 0; i < owned.size(); ++i) s.addDonor(owned[i]);
+                return 0;
+            });
+            StateStore::Stats before = state.getStats();
+            std::uniform_int_distribution<int> pick(0, donorCount - 1);
+            store = hammer(readers, writers, seconds,
+                [&](std::mt19937& rng) {
+                    std::shared_ptr<const StateStore::Snapshot> snap = state.snapshot();
+                    StateStore::DonorEntry entry;
+                    if (snap->donors.get(ids[pick(rng)], entry)) {
+                        std::string status = entry.view->status;
+                        (void)status;
+                    }
+                },
+                [&](std::mt19937& rng) {
+                    const std::string& id = ids[pick(rng)];
+                    const char* status = statuses[rng() % 2];
+                    state.execute([&](StateStore::State& s) {
+                        Donor* d = s.donor(id);
+                        if (d) {
+                            d->status = status;
+                            s.touch(d);
+                        }
+                        if (save) s.saveDonors();
+                        return 0;
+                    });
+                });
+            StateStore::Stats after = state.getStats();
+            unsigned long batches = after.batches - before.batches;
+            avgBatch = batches ? static_cast<double>(after.commands - before.commands) / batches : 0.0;
+        }
+        for (size_t i = 0; i < owned.size(); ++i) delete owned[i]; // Store never owns them
+
+        // Global mutex baseline
+        Counts locked;
+        {
+            CustomHashMap<std::string, Donor*> donors;
+            for (int i = 0; i < donorCount; ++i) {
+                Donor* d = makeDonor(i);
+                donors.insert(d->id, d);
+            }
+            std::mutex global;
+            std::uniform_int_distribution<int> pick(0, donorCount - 1);
+            locked = hammer(readers, writers, seconds,
+                [&](std::mt19937& rng) {
+                    std::lock_guard<std::mutex> guard(global);
+                    Donor* d = nullptr;
+                    if (donors.get(ids[pick(rng)], d)) {
+                        std::string status = d->status;
+                        (void)status;
+                    }
+                },
+                [&](std::mt19937& rng) {
+                    std::lock_guard<std::mutex> guard(global);
+                    Donor* d = nullptr;
+                    if (donors.get(ids[pick(rng)], d)) d->status = statuses[rng() % 2];
+                    if (save) CSVHandler::saveAllDonors(donorsCsv, donors);
+                });
+            CustomVector<std::string> keys = donors.getKeys();
+            for (size_t i = 0; i < keys.getSize(); ++i) {
+                Donor* d = nullptr;
+                if (donors.get(keys[i], d)) delete d;
+            }
+        }
+
+        std::printf("%4d %4d %5s | %14.0f %14.0f | %14.0f %14.0f | %9.1f\n", readers, writers, save ? "yes" : "no",
+                    store.readsPerSecond, store.writesPerSecond, locked.readsPerSecond, locked.writesPerSecond,
+                    avgBatch);
+    }
+    std::remove(donorsCsv.c_str());
+    std::remove(recipientsCsv.c_str());
+    return 0;
+}
@@ -0,0 +1,94 @@
+// Static vs time-dependent routing: CustomGraph::dijkstra against
+// timeDependentRoute on a jittered grid where half the edges carry a
+// rush-hour traffic profile. A second pass gives the same edges a flat
+// 3 min/km profile, where the travel time must be exactly 3 x distance.
+//
+// Usage: bench_time_dependent [gridSide=300] [queries=100] [seed=42]
+#include "dsa/CustomGraph.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+
+static std::string nodeId(int x, int y) {
+    return "N" + std::to_string(x) + "_" + std::to_string(y);
+}
+
+// Same seed -> same weights and same profiled edges
+static void buildGrid(CustomGraph& graph, int side, unsigned seed, const CustomVector<std::pair<int, double>>& points) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> jitter(1.0, 1.6);
+    unsigned short profile = graph.addTravelProfile(points);
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) graph.addNode(nodeId(x, y), "", "area", x * 10, y * 10);
+    }
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) {
+            for (int dir = 0; dir < 2; ++dir) {
+                int nx = dir == 0 ? x + 1 : x, ny = dir == 0 ? y : y + 1;
+                if (nx >= side || ny >= side) continue;
+                graph.addEdge(nodeId(x, y), nodeId(nx, ny), jitter(rng));
+                if (rng() % 2 == 0) graph.setEdgeProfile(nodeId(x, y), nodeId(nx, ny), profile);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 300;
+    int queries = argc > 2 ? std::atoi(argv[2]) : 100;
+    unsigned seed = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 42u;
+    if (side < 2 || queries < 1) {
+        std::fprintf(stderr, "usage: %s [gridSide>=2] [queries>=1] [seed]\n", argv[0]);
+        return 2;
+    }
+
+    CustomVector<std::pair<int, double>> rush;
+    rush.push_back({0, 2.5});
+    rush.push_back({450, 2.8});
+    rush.push_back({510, 5.5});   // 08:30 morning peak
+    rush.push_back({600, 3.2});
+    rush.push_back({1020, 3.4});
+    rush.push_back({1110, 6.0});  // 18:30 evening peak
+    rush.push_back({1230, 2.8});
+    CustomVector<std::pair<int, double>> flat;
+    flat.push_back({0, 3.0});
+
+    CustomGraph rushGraph, flatGraph;
+    buildGrid(rushGraph, side, seed, rush);
+    buildGrid(flatGraph, side, seed, flat);
+
+    std::mt19937 rng(seed + 1);
+    std::uniform_int_distribution<int> coord(0, side - 1);
+    std::uniform_int_distribution<int> minute(0, 1439);
+    double staticMicros = 0, timedMicros = 0;
+    int mismatches = 0;
+    for (int q = 0; q < queries; ++q) {
+        std::string from = nodeId(coord(rng), coord(rng));
+        std::string to = nodeId(coord(rng), coord(rng));
+        double departure = minute(rng);
+
+        auto t0 = std::chrono::steady_clock::now();
+        CustomGraph::ShortestPathResult plain = rushGraph.dijkstra(from, to);
+        auto t1 = std::chrono::steady_clock::now();
+        CustomGraph::TimedRouteResult timed = rushGraph.timeDependentRoute(from, to, departure);
+        auto t2 = std::chrono::steady_clock::now();
+        staticMicros += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        timedMicros += std::chrono::duration<double, std::micro>(t2 - t1).count();
+
+        CustomGraph::TimedRouteResult flatRoute = flatGraph.timeDependentRoute(from, to, departure);
+        double expected = 3.0 * plain.distance;
+        double travel = flatRoute.travelMinutes();
+        if (std::fabs(travel - expected) > 1e-6 * (1.0 + expected)) ++mismatches;
+        if (timed.arrivalMinute < departure) ++mismatches;
+    }
+
+    std::printf("graph: %d nodes, half the edges profiled, %d random queries (seed %u)\n", side * side, queries, seed);
+    std::printf("dijkstra:           %9.1f us/query\n", staticMicros / queries);
+    std::printf("timeDependentRoute: %9.1f us/query (%.2fx)\n", timedMicros / queries, timedMicros / staticMicros);
+    std::printf("flat-profile travel time != 3 x distance: %d\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
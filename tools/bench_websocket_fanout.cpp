@@ -0,0 +1,143 @@
+// WebSocket fan-out: WebSocketHub publish to many fake connections (one
+// shared frame per publish, ack window + bounded ring) against a baseline
+// that serializes and copies the payload for every connection.
+// All connections are on one topic, half also on a second; each publish
+// goes to both topics. A few clients never ack (slow consumers).
+//
+// Usage: bench_websocket_fanout [connections=10000] [publishes=1000] [slow=100]
+// Fails if an acking client misses a publish or gets one twice, or if one
+// publish reaches connections in more than one buffer.
+#include "logic/WebSocketHub.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct FakeClient {
+    WebSocketHub::ConnectionId id;
+    unsigned long received;
+    unsigned long unacked;
+    const std::string* lastBuffer;
+    bool closed;
+    bool slow;
+};
+
+static std::string makePayload(int sequence) {
+    std::ostringstream out;
+    out << "{\"type\":\"alert\",\"seq\":" << sequence
+        << ",\"requestId\":\"REC-104\",\"bloodGroup\":\"O-\",\"units\":2,\"urgency\":\"Immediate\","
+        << "\"hospital\":\"Pakistan Institute of Medical Sciences\",\"nodeId\":\"H1\","
+        << "\"message\":\"Emergency: O- blood needed urgently. Please respond if you are available to donate now.\","
+        << "\"contact\":\"+92-51-9261170\",\"radiusKm\":5,\"expiresInMinutes\":30}";
+    return out.str();
+}
+
+struct Outcome {
+    double microsPerPublish;
+    unsigned long ackingMin;
+    unsigned long slowMax;
+    int closed;
+    int errors;
+};
+
+static Outcome runHub(WebSocketHub::SlowConsumerPolicy policy, int connections, int publishes, int slowCount) {
+    WebSocketHub hub(32, 256, policy);
+    std::vector<FakeClient> clients(connections);
+    int errors = 0;
+    for (int i = 0; i < connections; ++i) {
+        FakeClient* c = &clients[i];
+        c->received = 0;
+        c->unacked = 0;
+        c->lastBuffer = nullptr;
+        c->closed = false;
+        c->slow = i < slowCount;
+        WebSocketHub::Endpoint endpoint;
+        endpoint.send = [c](const WebSocketHub::Frame& frame) {
+            c->lastBuffer = frame.get();
+            ++c->received;
+            ++c->unacked;
+        };
+        endpoint.close = [c](const std::string&) { c->closed = true; };
+        c->id = hub.connect(endpoint);
+        hub.subscribe(c->id, "group:O-|area:H1");
+        if (i % 2 == 0) hub.subscribe(c->id, "donor:area-H1");
+    }
+    CustomVector<std::string> names;
+    names.push_back("group:O-|area:H1");
+    names.push_back("donor:area-H1");
+
+    double micros = 0;
+    for (int p = 0; p < publishes; ++p) {
+        std::string payload = makePayload(p);
+        auto t0 = std::chrono::steady_clock::now();
+        hub.publish(names, payload);
+        micros += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        // Every acking client got this publish exactly once, all in one buffer
+        const std::string* shared = clients[slowCount].lastBuffer;
+        for (int i = slowCount; i < connections; ++i) {
+            if (clients[i].received != static_cast<unsigned long>(p + 1) || clients[i].lastBuffer != shared) {
+                ++errors;
+                break;
+            }
+        }
+        // Acking clients confirm everything they got since the last publish
+        for (int i = slowCount; i < connections; ++i) {
+            if (clients[i].unacked == 0) continue;
+            hub.acknowledge(clients[i].id, clients[i].received);
+            clients[i].unacked = 0;
+        }
+    }
+
+    Outcome out;
+    out.microsPerPublish = micros / publishes;
+    out.ackingMin = static_cast<unsigned long>(-1);
+    out.slowMax = 0;
+    out.closed = 0;
+    for (int i = 0; i < connections; ++i) {
+        if (clients[i].closed) ++out.closed;
+        if (clients[i].slow && clients[i].received > out.slowMax) out.slowMax = clients[i].received;
+        if (!clients[i].slow && clients[i].received < out.ackingMin) out.ackingMin = clients[i].received;
+    }
+    out.errors = errors;
+    std::printf("%-12s %9.0f us/publish  %6.1f ns/connection  acking got >= %lu  slow got <= %lu  closed %d  dropped %lu\n",
+                policy == WebSocketHub::DROP_OLDEST ? "DROP_OLDEST" : "DISCONNECT", out.microsPerPublish,
+                out.microsPerPublish * 1000.0 / connections, out.ackingMin, out.slowMax, out.closed,
+                hub.getStats().dropped);
+    return out;
+}
+
+int main(int argc, char** argv) {
+    int connections = argc > 1 ? std::atoi(argv[1]) : 10000;
+    int publishes = argc > 2 ? std::atoi(argv[2]) : 1000;
+    int slowCount = argc > 3 ? std::atoi(argv[3]) : 100;
+    if (connections < 1 || publishes < 1 || slowCount < 0 || slowCount >= connections) {
+        std::fprintf(stderr, "usage: %s [connections>=1] [publishes>=1] [0<=slow<connections]\n", argv[0]);
+        return 2;
+    }
+
+    std::printf("%d connections (half on two topics), %d publishes of %zu bytes, %d non-acking\n",
+                connections, publishes, makePayload(0).size(), slowCount);
+    int errors = 0;
+    errors += runHub(WebSocketHub::DROP_OLDEST, connections, publishes, slowCount).errors;
+    errors += runHub(WebSocketHub::DISCONNECT, connections, publishes, slowCount).errors;
+
+    // Baseline: every connection serializes its own payload and the transport copies it
+    std::vector<std::string> outbox(connections);
+    double micros = 0;
+    size_t bytes = 0;
+    for (int p = 0; p < publishes; ++p) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < connections; ++i) {
+            std::string payload = makePayload(p);
+            outbox[i] = payload;
+            bytes += outbox[i].size();
+        }
+        micros += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    }
+    std::printf("%-12s %9.0f us/publish  %6.1f ns/connection  (%zu bytes copied)\n", "per-copy",
+                micros / publishes, micros / publishes * 1000.0 / connections, bytes);
+    if (errors) std::printf("errors: %d\n", errors);
+    return errors == 0 ? 0 : 1;
+}